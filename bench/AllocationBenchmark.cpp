@@ -0,0 +1,337 @@
+// Allocation benchmark.
+// Counts every heap allocation the process makes (operator new is replaced
+// below) while synthetic scenes of 10k to 1M shapes are rebuilt serially,
+// through a TiledRebuilder on one and four threads, and through one
+// replaying display lists. For each it reports the allocations of the
+// first rebuild, the allocations per rebuild once warm (which should be
+// zero), ms per rebuild, and the arena blocks and peak scratch of the
+// rebuild. Then times the draw path's temporaries taken from the heap per
+// call, as they were, against the thread's FrameArena:
+//   flatten: FlattenBezier on quartics, which split into a heap buffer per
+//            subdivision level before
+//   clip:    Sutherland-Hodgman, four vectors per polygon vs. the overload
+//            taking a span and an arena
+// Checks every rebuild draws the same pixels as the serial one.
+//
+// Usage: allocation_benchmark [maxShapes] [width] [height]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+#include "../include/ClippingAlgorithms.h"
+#include "../include/CurveTessellator.h"
+#include "../include/DisplayList.h"
+#include "../include/FrameArena.h"
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/ShapeRenderer.h"
+#include "../include/TiledRebuild.h"
+#include "BenchScene.h"
+
+// ========================================
+// ALLOCATION COUNTING
+// ========================================
+
+static std::atomic<std::uint64_t> g_allocations(0);
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+static std::uint64_t Allocations() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+using Clock = std::chrono::steady_clock;
+
+// Milliseconds per run, repeated until ~300 ms have elapsed (at least once);
+// 'allocations' gets the heap allocations per run
+template <typename Run>
+static double TimeRuns(Run run, double& allocations) {
+    int runs = 0;
+    std::uint64_t before = Allocations();
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        run();
+        runs++;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    } while (elapsed < 300.0);
+    allocations = (double)(Allocations() - before) / runs;
+    return elapsed / runs;
+}
+
+// ========================================
+// HEAP SCRATCH, AS BEFORE THE ARENA
+// ========================================
+
+static const int MAX_SUBDIVISION_DEPTH = 16;
+
+static bool IsFlat(const BezierPoint pts[], int numPoints, double tolSq) {
+    const BezierPoint& a = pts[0];
+    const BezierPoint& b = pts[numPoints - 1];
+    double cx = b.x - a.x, cy = b.y - a.y;
+    double lenSq = cx * cx + cy * cy;
+    for (int i = 1; i < numPoints - 1; i++) {
+        double px = pts[i].x - a.x, py = pts[i].y - a.y;
+        double distSq;
+        if (lenSq < 1e-12) {
+            distSq = px * px + py * py;
+        } else {
+            double cross = px * cy - py * cx;
+            distSq = cross * cross / lenSq;
+        }
+        if (distSq > tolSq) return false;
+    }
+    return true;
+}
+
+static void HeapFlattenRecursive(const BezierPoint pts[], int numPoints, double tolSq, int depth,
+                                 std::vector<BezierPoint>& out) {
+    if (depth >= MAX_SUBDIVISION_DEPTH || IsFlat(pts, numPoints, tolSq)) {
+        out.push_back(pts[numPoints - 1]);
+        return;
+    }
+    BezierPoint stackBuffer[3 * 4];
+    std::vector<BezierPoint> heapBuffer;
+    BezierPoint* buffer = stackBuffer;
+    if (numPoints > 4) {
+        heapBuffer.resize(3 * numPoints);
+        buffer = heapBuffer.data();
+    }
+    BezierPoint* left = buffer;
+    BezierPoint* right = buffer + numPoints;
+    BezierPoint* scratch = buffer + 2 * numPoints;
+    std::copy(pts, pts + numPoints, scratch);
+    left[0] = scratch[0];
+    right[numPoints - 1] = scratch[numPoints - 1];
+    for (int n = numPoints - 1, level = 1; n > 0; n--, level++) {
+        for (int i = 0; i < n; i++) {
+            scratch[i].x = 0.5 * (scratch[i].x + scratch[i + 1].x);
+            scratch[i].y = 0.5 * (scratch[i].y + scratch[i + 1].y);
+        }
+        left[level] = scratch[0];
+        right[numPoints - 1 - level] = scratch[n - 1];
+    }
+    HeapFlattenRecursive(left, numPoints, tolSq, depth + 1, out);
+    HeapFlattenRecursive(right, numPoints, tolSq, depth + 1, out);
+}
+
+static std::vector<Point2> HeapClipEdge(const std::vector<Point2>& p, int edge, double value) {
+    auto inside = [&](const Point2& v) {
+        switch (edge) {
+            case 0: return v.x >= value;
+            case 1: return v.x <= value;
+            case 2: return v.y <= value;
+            default: return v.y >= value;
+        }
+    };
+    auto cut = [&](const Point2& a, const Point2& b) {
+        if (edge < 2) return Point2(value, a.y + (value - a.x) * (b.y - a.y) / (b.x - a.x));
+        return Point2(a.x + (value - a.y) * (b.x - a.x) / (b.y - a.y), value);
+    };
+    std::vector<Point2> out;
+    if (p.empty()) return out;
+    Point2 v1 = p.back();
+    bool in1 = inside(v1);
+    for (const Point2& v2 : p) {
+        bool in2 = inside(v2);
+        if (in1 && in2) out.push_back(v2);
+        else if (in1 && !in2) out.push_back(cut(v1, v2));
+        else if (!in1 && in2) { out.push_back(cut(v1, v2)); out.push_back(v2); }
+        v1 = v2;
+        in1 = in2;
+    }
+    return out;
+}
+
+static std::vector<Point2> HeapClip(const std::vector<Point2>& polygon, int xLeft, int xRight, int yTop, int yBottom) {
+    return HeapClipEdge(HeapClipEdge(HeapClipEdge(HeapClipEdge(polygon, 0, xLeft), 1, xRight), 2, yBottom), 3, yTop);
+}
+
+// ========================================
+// REBUILDS
+// ========================================
+
+static const COLORREF BACKGROUND = RGB(255, 255, 255);
+
+static bool SamePixels(const Framebuffer& framebuffer, const std::vector<std::uint32_t>& expected) {
+    return std::memcmp(framebuffer.Pixels(), expected.data(), expected.size() * sizeof(std::uint32_t)) == 0;
+}
+
+int main(int argc, char** argv) {
+    int maxShapes = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    const std::size_t pixelCount = (std::size_t)width * height;
+    std::printf("%dx%d canvas\n", width, height);
+
+    TiledRebuilder serialRebuilder(1), parallelRebuilder(4);
+    bool identical = true;
+    for (int count : { 10000, 100000, 1000000 }) {
+        if (count > maxShapes) break;
+        Scene scene = MakeScene(count, width, height);
+        DisplayListCache cache((std::size_t)-1);
+
+        std::printf("\n%d shapes\n%-12s %12s %12s %12s %12s %12s %s\n", count, "rebuild", "first allocs",
+                    "warm allocs", "ms/rebuild", "arena blocks", "arena KiB", "identical");
+
+        struct Path {
+            const char* name;
+            TiledRebuilder* rebuilder;
+            DisplayListCache* cache;
+        };
+        const Path paths[] = {
+            { "serial", nullptr, nullptr },
+            { "tiled x1", &serialRebuilder, nullptr },
+            { "tiled x4", &parallelRebuilder, nullptr },
+            { "cached x4", &parallelRebuilder, &cache },
+        };
+
+        std::vector<std::uint32_t> expected;
+        for (const Path& path : paths) {
+            std::size_t arenaPeak = 0;
+            std::uint64_t arenaBlocks = 0;
+            auto rebuild = [&]() {
+                framebuffer.Clear(BACKGROUND);
+                if (path.rebuilder) {
+                    path.rebuilder->Render(framebuffer, scene, path.cache);
+                    arenaPeak = path.rebuilder->LastStats().arenaPeak;
+                    arenaBlocks = path.rebuilder->LastStats().arenaAllocations;
+                    return;
+                }
+                // A plain loop over the scene, resetting the arena per
+                // rebuild as TiledRebuilder does
+                std::uint64_t blocks = FrameArena::TotalHeapAllocations();
+                ThreadArena().Reset();
+                BgraSink sink(framebuffer, DirtyTracking::OFF);
+                for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sink, scene.View(i));
+                arenaPeak = ThreadArena().Stats().peak;
+                arenaBlocks = FrameArena::TotalHeapAllocations() - blocks;
+            };
+
+            std::uint64_t before = Allocations();
+            rebuild();
+            std::uint64_t firstAllocations = Allocations() - before;
+
+            // Tiles go to whichever worker is free, so each worker's
+            // buffers take a few rebuilds to see their largest tiles
+            for (int i = 0; i < 5; i++) rebuild();
+            double warmAllocations = 0;
+            double ms = TimeRuns(rebuild, warmAllocations);
+
+            if (expected.empty()) expected.assign(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+            bool same = SamePixels(framebuffer, expected);
+            identical = identical && same;
+            std::printf("%-12s %12llu %12.2f %12.2f %12llu %12.1f %s\n", path.name,
+                        (unsigned long long)firstAllocations, warmAllocations, ms, (unsigned long long)arenaBlocks,
+                        arenaPeak / 1024.0, same ? "yes" : "NO");
+        }
+    }
+
+    // ========================================
+    // SCRATCH
+    // ========================================
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> coord(-200.0, 1200.0);
+    std::vector<BezierPoint> quartics(5 * 1000);
+    for (BezierPoint& p : quartics) p = BezierPoint(coord(rng), coord(rng));
+    std::vector<std::vector<Point2>> polygons(1000);
+    for (auto& polygon : polygons) {
+        for (int k = 0; k < 12; k++) polygon.push_back(Point2(coord(rng), coord(rng)));
+    }
+
+    std::printf("\n%-12s %12s %12s %12s %12s %s\n", "scratch", "heap us", "heap allocs", "arena us", "arena allocs",
+                "same");
+
+    // Read at run time, so the copy above isn't specialized for quartics
+    // where the library's can't be
+    static volatile int quarticPoints = 5;
+    const int points = quarticPoints;
+    std::vector<BezierPoint> heapOut, arenaOut;
+    double heapAllocations = 0, arenaAllocations = 0;
+    double heapMs = TimeRuns([&]() {
+        heapOut.clear();
+        for (std::size_t c = 0; c < quartics.size(); c += 5) {
+            heapOut.push_back(quartics[c]);
+            HeapFlattenRecursive(&quartics[c], points, 0.25 * 0.25, 0, heapOut);
+        }
+    }, heapAllocations);
+    double arenaMs = TimeRuns([&]() {
+        arenaOut.clear();
+        for (std::size_t c = 0; c < quartics.size(); c += 5) {
+            arenaOut.push_back(quartics[c]);
+            FlattenBezier(&quartics[c], points, 0.25, arenaOut);
+        }
+    }, arenaAllocations);
+    bool same = heapOut.size() == arenaOut.size() &&
+                std::memcmp(heapOut.data(), arenaOut.data(), heapOut.size() * sizeof(BezierPoint)) == 0;
+    identical = identical && same;
+    const double curves = quartics.size() / 5.0;
+    std::printf("%-12s %12.3f %12.1f %12.3f %12.1f %s\n", "flatten", 1000.0 * heapMs / curves, heapAllocations / curves,
+                1000.0 * arenaMs / curves, arenaAllocations / curves, same ? "yes" : "NO");
+
+    std::size_t heapPoints = 0, arenaPoints = 0;
+    double heapSum = 0, arenaSum = 0;
+    heapMs = TimeRuns([&]() {
+        heapPoints = 0;
+        heapSum = 0;
+        for (const auto& polygon : polygons) {
+            std::vector<Point2> clipped = HeapClip(polygon, 0, 1000, 0, 1000);
+            heapPoints += clipped.size();
+            for (const Point2& p : clipped) heapSum += p.x + p.y;
+        }
+    }, heapAllocations);
+    arenaMs = TimeRuns([&]() {
+        arenaPoints = 0;
+        arenaSum = 0;
+        for (const auto& polygon : polygons) {
+            ArenaScope scope;
+            ArrayView<Point2> clipped = SutherlandHodgmanPolygonClip(polygon, 0, 1000, 0, 1000, scope.Arena());
+            arenaPoints += clipped.size();
+            for (const Point2& p : clipped) arenaSum += p.x + p.y;
+        }
+    }, arenaAllocations);
+    same = heapPoints == arenaPoints && heapSum == arenaSum;
+    identical = identical && same;
+    std::printf("%-12s %12.3f %12.1f %12.3f %12.1f %s\n", "clip", 1000.0 * heapMs / polygons.size(),
+                heapAllocations / polygons.size(), 1000.0 * arenaMs / polygons.size(),
+                arenaAllocations / polygons.size(), same ? "yes" : "NO");
+
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+#ifndef BENCH_SCENE_H
+#define BENCH_SCENE_H
+
+// Synthetic scene shared by the scene-level benchmarks
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../include/GraphicsTypes.h"
+#include "../include/Scene.h"
+#include "../include/ShapeRenderer.h"
+
+// Mix of outlines and fills like rebuild_benchmark, plus anti-aliased
+// fills, which blend with what is underneath. Sizes (radii, half sizes)
+// run from 5, or maxSize if smaller, to maxSize pixels.
+inline std::vector<Shape> MakeShapes(int count, int width, int height, int maxSize = 60) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> px(0, width - 1);
+    std::uniform_int_distribution<int> py(0, height - 1);
+    std::uniform_int_distribution<int> size(std::min(5, maxSize), maxSize);
+    std::uniform_int_distribution<int> kind(0, 9);
+
+    const COLORREF palette[] = { RGB(0, 0, 0), RGB(255, 0, 0), RGB(0, 255, 0), RGB(0, 0, 255) };
+
+    std::vector<Shape> shapes;
+    shapes.reserve(count);
+    for (int i = 0; i < count; i++) {
+        Shape shape;
+        shape.color = palette[i % 4];
+        shape.fillMode = FillMode::NONE;
+        shape.thickness = 1;
+
+        int x = px(rng), y = py(rng), r = size(rng);
+        switch (kind(rng)) {
+            case 0: shape.mode = DrawingMode::LINE_DDA; break;
+            case 1: shape.mode = DrawingMode::LINE_BRESENHAM; break;
+            case 2:
+                shape.mode = DrawingMode::CIRCLE_MIDPOINT;
+                shape.fillMode = (i % 3 == 0) ? FillMode::CIRCLE_FILL_LINES : FillMode::NONE;
+                break;
+            case 3:
+                shape.mode = DrawingMode::CIRCLE_POLAR;
+                shape.fillMode = (i % 5 == 0) ? FillMode::ANTIALIASED_EVEN_ODD : FillMode::NONE;
+                break;
+            case 4: shape.mode = DrawingMode::ELLIPSE_MIDPOINT; break;
+            case 5:
+                shape.mode = DrawingMode::SQUARE;
+                shape.fillMode = (i % 4 == 0) ? FillMode::SQUARE_FILL_HERMITE_VERTICAL : FillMode::NONE;
+                break;
+            case 6: shape.mode = DrawingMode::RECTANGLE; break;
+            case 7:
+                shape.mode = DrawingMode::POLYGON;
+                shape.fillMode = (i % 2 == 0) ? FillMode::POLYGON_NONCONVEX_FILL : FillMode::ANTIALIASED_NON_ZERO;
+                break;
+            case 8: shape.mode = DrawingMode::CURVE_BEZIER; break;
+            default: shape.mode = DrawingMode::CURVE_CARDINAL; break;
+        }
+
+        if (shape.mode == DrawingMode::POLYGON || shape.mode == DrawingMode::CURVE_BEZIER ||
+            shape.mode == DrawingMode::CURVE_CARDINAL) {
+            std::uniform_int_distribution<int> jitter(-r, r);
+            for (int k = 0; k < 5; k++) {
+                shape.points.push_back(Point(x + jitter(rng), y + jitter(rng)));
+            }
+        } else {
+            shape.points.push_back(Point(x, y));
+            shape.points.push_back(Point(x + r, y + r / 2));
+        }
+        shapes.push_back(shape);
+    }
+    return shapes;
+}
+
+// The same shapes in a Scene
+inline Scene MakeScene(int count, int width, int height, int maxSize = 60) {
+    std::vector<Shape> shapes = MakeShapes(count, width, height, maxSize);
+    std::size_t points = 0;
+    for (const Shape& shape : shapes) points += shape.points.size();
+    Scene scene;
+    scene.Reserve(shapes.size(), points);
+    for (const Shape& shape : shapes) scene.Add(shape);
+    return scene;
+}
+
+#endif // BENCH_SCENE_H
@@ -0,0 +1,136 @@
+// Bezier evaluation scaling benchmark.
+// Times one curve of 'steps' samples for growing control-point counts with
+// each evaluator: the old recursive RecBezier (O(2^n) per sample, only run
+// for small n), iterative de Casteljau (O(n^2), run up to 1024 points), the
+// cached Bernstein table (O(n), less once weights start to be negligible)
+// and, for cubics, forward differencing (O(1)). Also times the full
+// DrawBezierCurve path into a counting sink, and reports the largest
+// distance between the Bernstein and de Casteljau samples.
+//
+// Usage: bezier_benchmark [steps] [maxPoints]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../include/Bezier.h"
+
+// The original exponential-time evaluator, kept here as the baseline
+static BezierPoint RecursiveBezier(double t, const BezierPoint pts[], int si, int ei) {
+    if (si == ei) return pts[si];
+    BezierPoint p1 = RecursiveBezier(t, pts, si, ei - 1);
+    BezierPoint p2 = RecursiveBezier(t, pts, si + 1, ei);
+    return BezierPoint((1 - t) * p1.x + t * p2.x, (1 - t) * p1.y + t * p2.y);
+}
+
+// Microseconds per call of 'curve', repeated until ~50 ms have elapsed
+template <typename Curve>
+static double TimeCurve(Curve curve) {
+    using Clock = std::chrono::steady_clock;
+    curve();  // Warm up
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        curve();
+        runs++;
+        elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    } while (elapsed < 50000.0);
+    return elapsed / runs;
+}
+
+static volatile double g_sink;  // Keeps the evaluations from being optimized out
+
+int main(int argc, char** argv) {
+    int steps = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int maxPoints = argc > 2 ? std::atoi(argv[2]) : 16384;
+    const int maxRecursivePoints = 16;
+    const int maxCasteljauPoints = 1024;
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> coord(0, 1000);
+
+    std::printf("%d samples per curve, times in us per curve\n", steps + 1);
+    std::printf("%8s %12s %12s %12s %12s %12s %12s %12s\n",
+                "points", "recursive", "casteljau", "bern+build", "bernstein", "fwd-diff", "draw", "max err px");
+
+    std::vector<int> counts = { 3, 4, 8, 12, 16, 24, 32, 64, 128, 256, 512, 1024, 2048, 4096, 16384 };
+    for (int n : counts) {
+        if (n > maxPoints) break;
+
+        std::vector<BezierPoint> pts(n);
+        for (auto& p : pts) p = BezierPoint(coord(rng), coord(rng));
+        std::vector<BezierPoint> scratch(n);
+
+        char recursive[16] = "-";
+        if (n <= maxRecursivePoints) {
+            double us = TimeCurve([&]() {
+                double acc = 0;
+                for (int i = 0; i <= steps; i++) acc += RecursiveBezier((double)i / steps, pts.data(), 0, n - 1).x;
+                g_sink = acc;
+            });
+            std::snprintf(recursive, sizeof(recursive), "%.1f", us);
+        }
+
+        BernsteinBasis basis;
+        basis.Build(n - 1, steps);
+
+        char casteljau[16] = "-", error[16] = "-";
+        if (n <= maxCasteljauPoints) {
+            double us = TimeCurve([&]() {
+                double acc = 0;
+                for (int i = 0; i <= steps; i++) acc += DeCasteljau((double)i / steps, pts.data(), n, scratch.data()).x;
+                g_sink = acc;
+            });
+            std::snprintf(casteljau, sizeof(casteljau), "%.1f", us);
+
+            double maxError = 0;
+            for (int i = 0; i <= steps; i++) {
+                BezierPoint a = DeCasteljau((double)i / steps, pts.data(), n, scratch.data());
+                BezierPoint b = basis.Evaluate(pts.data(), i);
+                maxError = std::max(maxError, std::hypot(a.x - b.x, a.y - b.y));
+            }
+            std::snprintf(error, sizeof(error), "%.1e", maxError);
+        }
+
+        double withBuild = TimeCurve([&]() {
+            BernsteinBasis fresh;
+            fresh.Build(n - 1, steps);
+            double acc = 0;
+            for (int i = 0; i <= steps; i++) acc += fresh.Evaluate(pts.data(), i).x;
+            g_sink = acc;
+        });
+        double cached = TimeCurve([&]() {
+            double acc = 0;
+            for (int i = 0; i <= steps; i++) acc += basis.Evaluate(pts.data(), i).x;
+            g_sink = acc;
+        });
+
+        char forward[16] = "-";
+        if (n == 4) {
+            double us = TimeCurve([&]() {
+                CubicForwardDiffer curve(pts.data(), steps);
+                double acc = 0;
+                for (int i = 0; i <= steps; i++) {
+                    acc += curve.Current().x;
+                    curve.Next();
+                }
+                g_sink = acc;
+            });
+            std::snprintf(forward, sizeof(forward), "%.1f", us);
+        }
+
+        double draw = TimeCurve([&]() {
+            CountingSink sink;
+            DrawBezierCurve(sink, pts.data(), n, steps, RGB(0, 0, 0));
+            g_sink = (double)sink.Pixels();
+        });
+
+        std::printf("%8d %12s %12s %12.1f %12.1f %12s %12.1f %12s\n", n, recursive, casteljau, withBuild, cached, forward,
+                    draw, error);
+    }
+    return 0;
+}
@@ -0,0 +1,252 @@
+// Compact scene file benchmark.
+// Saves scenes as plain version 2 files and in the three compact forms
+// (delta-coded points, compressed table, both) and reports for each:
+//   size:    bytes, and the ratio to the plain file and to version 1
+//   load:    ReadScene from memory, including the decode
+// and for the codecs alone:
+//   points:  decode throughput of the group varint deltas next to a
+//            continuation-bit (LEB128) varint of the same deltas
+//   table:   LZ77 decompression throughput of the packed shape table
+// Every load must write back the plain file it came from, and truncated
+// compact files must be rejected.
+//
+// With no files, runs on two synthetic scenes: the shared benchmark mix
+// (scattered short shapes, so mostly far jumps between points) and a
+// traced one of freehand polygons and splines (long runs of nearby
+// points, like drawings made with the mouse). Given .bin files, runs on
+// each of them instead.
+//
+// Usage: compact_file_benchmark [shapes] [width] [height]
+//        compact_file_benchmark file.bin...
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/GraphicsTypes.h"
+#include "../include/Scene.h"
+#include "../include/SceneCompression.h"
+#include "../include/SceneFile.h"
+#include "../include/ShapeRenderer.h"
+#include "BenchScene.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Milliseconds per run, repeated until ~300 ms have elapsed (at least once)
+template <typename Run>
+static double TimeRuns(Run run) {
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        run();
+        runs++;
+        elapsed = MillisecondsSince(start);
+    } while (elapsed < 300.0);
+    return elapsed / runs;
+}
+
+// Freehand shapes: random walks of 20 to 200 points with steps of a few
+// pixels that turn gradually
+static Scene MakeTracedScene(int count, int width, int height) {
+    std::mt19937 rng(54321);
+    std::uniform_int_distribution<int> px(0, width - 1);
+    std::uniform_int_distribution<int> py(0, height - 1);
+    std::uniform_int_distribution<int> length(20, 200);
+    std::uniform_real_distribution<double> turn(-0.4, 0.4);
+    std::uniform_real_distribution<double> step(1.0, 6.0);
+
+    Scene scene;
+    Shape shape;
+    for (int i = 0; i < count; i++) {
+        shape.mode = (i % 2 == 0) ? DrawingMode::POLYGON : DrawingMode::CURVE_CARDINAL;
+        shape.fillMode = (i % 4 == 0) ? FillMode::POLYGON_NONCONVEX_FILL : FillMode::NONE;
+        shape.color = RGB(0, 0, 0);
+        shape.thickness = 1;
+        shape.points.clear();
+        double x = px(rng), y = py(rng), angle = 0;
+        for (int k = length(rng); k > 0; k--) {
+            shape.points.push_back(Point((int)x, (int)y));
+            angle += turn(rng);
+            double d = step(rng);
+            x += d * std::cos(angle);
+            y += d * std::sin(angle);
+        }
+        scene.Add(shape);
+    }
+    return scene;
+}
+
+static std::string Bytes(const Scene& scene, const SceneFileOptions& options = SceneFileOptions()) {
+    std::ostringstream out;
+    WriteScene(out, scene, options);
+    return out.str();
+}
+
+// The same zig-zag deltas as a continuation-bit varint, 7 bits per byte
+static void EncodeLeb128(const Point* points, std::size_t count, std::vector<unsigned char>& out) {
+    std::uint32_t previous[2] = { 0, 0 };
+    for (std::size_t i = 0; i < count; i++) {
+        const std::uint32_t coordinates[2] = { (std::uint32_t)points[i].x, (std::uint32_t)points[i].y };
+        for (int c = 0; c < 2; c++) {
+            std::uint32_t delta = coordinates[c] - previous[c];
+            std::uint32_t value = (delta << 1) ^ (0u - (delta >> 31));
+            previous[c] = coordinates[c];
+            while (value >= 0x80) {
+                out.push_back((unsigned char)(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back((unsigned char)value);
+        }
+    }
+}
+
+static void DecodeLeb128(const unsigned char* p, Point* points, std::size_t count) {
+    std::uint32_t current[2] = { 0, 0 };
+    for (std::size_t i = 0; i < count; i++) {
+        for (int c = 0; c < 2; c++) {
+            std::uint32_t value = 0;
+            int shift = 0;
+            unsigned char byte;
+            do {
+                byte = *p++;
+                value |= (std::uint32_t)(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            current[c] += (value >> 1) ^ (0u - (value & 1));
+        }
+        points[i] = Point((int)current[0], (int)current[1]);
+    }
+}
+
+static bool Run(const char* name, const Scene& scene) {
+    const SceneColumns columns = scene.Columns();
+    std::ostringstream legacyOut;
+    WriteLegacyScene(legacyOut, scene);
+    const double legacySize = (double)legacyOut.str().size();
+    const std::string plain = Bytes(scene);
+
+    std::printf("\n%s: %zu shapes, %zu points, version 1 %.2f MiB\n", name, columns.shapeCount, columns.pointCount,
+                legacySize / 1048576.0);
+    std::printf("%-14s %10s %10s %10s %10s %12s\n", "encoding", "MiB", "vs plain", "vs v1", "load ms", "round-trips");
+
+    struct Variant {
+        const char* name;
+        bool deltaPoints, compressTable;
+    } variants[] = {
+        { "plain", false, false },
+        { "delta", true, false },
+        { "table", false, true },
+        { "delta+table", true, true },
+    };
+    bool ok = true;
+    for (const Variant& variant : variants) {
+        SceneFileOptions options;
+        options.deltaPoints = variant.deltaPoints;
+        options.compressTable = variant.compressTable;
+        const std::string bytes = Bytes(scene, options);
+
+        Scene loaded;
+        bool loads = true;
+        double loadMs = TimeRuns([&]() {
+            std::istringstream in(bytes);
+            loads = ReadScene(in, loaded) && loads;
+        });
+        bool roundTrip = loads && Bytes(loaded) == plain;
+
+        // Any cut must be caught
+        bool rejects = true;
+        for (std::size_t cut : { bytes.size() - 1, bytes.size() / 2, (std::size_t)200 }) {
+            std::istringstream in(bytes.substr(0, cut));
+            Scene truncated;
+            rejects = rejects && !ReadScene(in, truncated);
+        }
+
+        std::printf("%-14s %10.2f %9.1f%% %9.1f%% %10.2f %12s\n", variant.name, bytes.size() / 1048576.0,
+                    100.0 * bytes.size() / plain.size(), 100.0 * bytes.size() / legacySize, loadMs,
+                    !roundTrip ? "NO" : rejects ? "yes" : "yes (CUT ACCEPTED)");
+        ok = ok && roundTrip && rejects;
+    }
+
+    // Point codecs alone
+    std::vector<unsigned char> groups, leb;
+    EncodePointDeltas(columns.points, columns.pointCount, groups);
+    EncodeLeb128(columns.points, columns.pointCount, leb);
+    std::vector<Point> decoded(columns.pointCount);
+    double groupMs = TimeRuns([&]() {
+        ok = DecodePointDeltas(groups.data(), groups.size(), decoded.data(), decoded.size()) && ok;
+    });
+    ok = ok && std::memcmp(decoded.data(), columns.points, columns.pointCount * sizeof(Point)) == 0;
+    double lebMs = TimeRuns([&]() { DecodeLeb128(leb.data(), decoded.data(), decoded.size()); });
+    ok = ok && std::memcmp(decoded.data(), columns.points, columns.pointCount * sizeof(Point)) == 0;
+
+    const double points = (double)columns.pointCount;
+    std::printf("%-14s %10s %10s %14s\n", "point codec", "B/point", "Mpoints/s", "MiB/s decoded");
+    std::printf("%-14s %10.2f %10.0f %14.0f\n", "group varint", groups.size() / points, points / groupMs / 1e3,
+                points * sizeof(Point) / 1048576.0 / groupMs * 1e3);
+    std::printf("%-14s %10.2f %10.0f %14.0f\n", "LEB128", leb.size() / points, points / lebMs / 1e3,
+                points * sizeof(Point) / 1048576.0 / lebMs * 1e3);
+
+    // The table codec alone, on the table a plain file holds
+    std::vector<unsigned char> table;
+    const unsigned char* tableColumns[] = {
+        columns.modes, columns.fillModes, reinterpret_cast<const unsigned char*>(columns.colors),
+        reinterpret_cast<const unsigned char*>(columns.thickness),
+    };
+    const std::size_t tableWidths[] = { 1, 1, sizeof(COLORREF), sizeof(std::int32_t) };
+    for (int k = 0; k < 4; k++) {
+        table.insert(table.end(), tableColumns[k], tableColumns[k] + tableWidths[k] * columns.shapeCount);
+    }
+    std::vector<unsigned char> block;
+    CompressBlock(table.data(), table.size(), block);
+    std::vector<unsigned char> expanded(table.size());
+    double lzMs = TimeRuns([&]() {
+        ok = DecompressBlock(block.data(), block.size(), expanded.data(), expanded.size()) && ok;
+    });
+    ok = ok && expanded == table;
+    std::printf("LZ77 on mode/fill/color/thickness columns: %.1f%% of %.2f MiB, %.0f MiB/s decoded\n",
+                100.0 * block.size() / table.size(), table.size() / 1048576.0,
+                table.size() / 1048576.0 / lzMs * 1e3);
+    return ok;
+}
+
+static bool IsNumber(const char* text) {
+    if (!*text) return false;
+    for (; *text; text++) {
+        if (*text < '0' || *text > '9') return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    bool ok = true;
+    if (argc > 1 && !IsNumber(argv[1])) {
+        for (int i = 1; i < argc; i++) {
+            Scene scene;
+            if (!LoadSceneFromFile(argv[i], scene)) {
+                std::fprintf(stderr, "Failed to load %s\n", argv[i]);
+                ok = false;
+                continue;
+            }
+            ok = Run(argv[i], scene) && ok;
+        }
+    } else {
+        int shapes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+        int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+        int height = argc > 3 ? std::atoi(argv[3]) : 768;
+        ok = Run("mixed", MakeScene(shapes, width, height)) && ok;
+        ok = Run("traced", MakeTracedScene(std::max(1, shapes / 20), width, height)) && ok;
+    }
+    return ok ? 0 : 1;
+}
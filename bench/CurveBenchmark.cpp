@@ -0,0 +1,277 @@
+// Curve tessellation benchmark.
+// Draws random Bezier, Hermite and Cardinal curves two ways: fixed sampling
+// with the step-count heuristics the renderer used before (one plot per
+// sample), and adaptive flattening into Bresenham segments. Reports curve
+// evaluations, pixel writes, distinct pixels covered and time for each.
+// Then flattens single Bezier curves of 4 to 1000 control points (above
+// 12 they are bisected in t from points on the curve rather than split)
+// and reports the time per curve and how far the polyline strays from a
+// dense sampling of the curve.
+//
+// Usage: curve_benchmark [curvesPerKind] [tolerance]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+#include "../include/Bezier.h"
+#include "../include/CardinalSpline.h"
+#include "../include/CurveTessellator.h"
+#include "../include/Framebuffer.h"
+#include "../include/Hermite.h"
+
+static const int WIDTH = 1024;
+static const int HEIGHT = 768;
+
+struct Result {
+    std::uint64_t evaluations = 0;
+    std::uint64_t writes = 0;
+    std::uint64_t covered = 0;
+    double ms = 0;
+};
+
+// Runs 'draw' once into a counting sink (writes) and once into a cleared
+// framebuffer (coverage), then times it into the framebuffer
+static Result Run(const std::function<void(CountingSink&)>& count,
+                  const std::function<void(BgraSink&)>& draw) {
+    Result result;
+    CountingSink counter;
+    count(counter);
+    result.writes = counter.Pixels();
+
+    Framebuffer framebuffer;
+    framebuffer.Create(WIDTH, HEIGHT);
+    framebuffer.Clear(RGB(255, 255, 255));
+    BgraSink sink(framebuffer);
+    draw(sink);
+    const std::uint32_t white = Framebuffer::ToPixel(RGB(255, 255, 255));
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        if (framebuffer.Pixels()[i] != white) result.covered++;
+    }
+
+    const int repeats = 10;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) {
+        draw(sink);
+    }
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+    return result;
+}
+
+static void Print(const char* kind, const char* method, const Result& r) {
+    std::printf("%-9s %-9s %12llu %12llu %12llu %8.2f %10.3f\n", kind, method,
+                (unsigned long long)r.evaluations, (unsigned long long)r.writes,
+                (unsigned long long)r.covered, r.covered ? (double)r.writes / r.covered : 0.0, r.ms);
+}
+
+static double DistanceToSegment(const BezierPoint& p, const BezierPoint& a, const BezierPoint& b) {
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double lenSq = dx * dx + dy * dy;
+    double t = lenSq > 0 ? std::max(0.0, std::min(1.0, ((p.x - a.x) * dx + (p.y - a.y) * dy) / lenSq)) : 0.0;
+    return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+}
+
+// Largest distance from points along the curve to the polyline. Segments
+// are binned in a grid of GRID px cells, each widened by a cell, so a
+// point's own cell holds every segment nearer than GRID.
+static double MaxDeviation(const std::vector<BezierPoint>& curve, const std::vector<BezierPoint>& polyline) {
+    const double GRID = 16;
+    if (polyline.size() < 2) return 0;
+    double minX = polyline[0].x, minY = polyline[0].y, maxX = minX, maxY = minY;
+    for (const BezierPoint& p : polyline) {
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+    const int cols = (int)((maxX - minX) / GRID) + 3, rows = (int)((maxY - minY) / GRID) + 3;
+    auto cellX = [&](double x) { return (int)std::floor((x - minX) / GRID) + 1; };
+    auto cellY = [&](double y) { return (int)std::floor((y - minY) / GRID) + 1; };
+    std::vector<std::vector<std::size_t>> cells((std::size_t)cols * rows);
+    for (std::size_t s = 0; s + 1 < polyline.size(); s++) {
+        const BezierPoint& a = polyline[s];
+        const BezierPoint& b = polyline[s + 1];
+        int x0 = std::max(0, cellX(std::min(a.x, b.x)) - 1), x1 = std::min(cols - 1, cellX(std::max(a.x, b.x)) + 1);
+        int y0 = std::max(0, cellY(std::min(a.y, b.y)) - 1), y1 = std::min(rows - 1, cellY(std::max(a.y, b.y)) + 1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) cells[(std::size_t)y * cols + x].push_back(s);
+        }
+    }
+
+    double worst = 0;
+    for (const BezierPoint& p : curve) {
+        double nearest = GRID;
+        int x = cellX(p.x), y = cellY(p.y);
+        if (x >= 0 && x < cols && y >= 0 && y < rows) {
+            for (std::size_t s : cells[(std::size_t)y * cols + x]) {
+                nearest = std::min(nearest, DistanceToSegment(p, polyline[s], polyline[s + 1]));
+            }
+        }
+        if (nearest >= GRID) {
+            for (std::size_t s = 0; s + 1 < polyline.size(); s++) {
+                nearest = std::min(nearest, DistanceToSegment(p, polyline[s], polyline[s + 1]));
+            }
+        }
+        worst = std::max(worst, nearest);
+    }
+    return worst;
+}
+
+// One curve at a time, control points spread over the canvas
+static void HighDegreeBeziers(double tolerance, std::mt19937& rng) {
+    std::uniform_real_distribution<double> px(0, WIDTH - 1), py(0, HEIGHT - 1);
+    std::printf("\n%-14s %12s %12s %12s\n", "bezier points", "evaluations", "ms / curve", "max err px");
+    for (int n : { 4, 8, 16, 32, 64, 200, 500, 1000 }) {
+        std::vector<BezierPoint> control;
+        for (int i = 0; i < n; i++) control.push_back(BezierPoint(px(rng), py(rng)));
+
+        CurveStats stats;
+        std::vector<BezierPoint> polyline(1, control[0]);
+        auto start = std::chrono::steady_clock::now();
+        FlattenBezier(control.data(), n, tolerance, polyline, &stats);
+        int runs = 1;
+        double ms = 0;
+        while ((ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()) <
+               50.0) {
+            std::vector<BezierPoint> again(1, control[0]);
+            FlattenBezier(control.data(), n, tolerance, again);
+            runs++;
+        }
+
+        // The curve itself, far denser than any polyline drawn of it
+        const int referenceSteps = 1 << 17;
+        BernsteinBasis basis;
+        basis.Build(n - 1, referenceSteps);
+        std::vector<BezierPoint> curve(referenceSteps + 1);
+        for (int step = 0; step <= referenceSteps; step++) curve[step] = basis.Evaluate(control.data(), step);
+
+        std::printf("%-14d %12llu %12.3f %12.3f\n", n, (unsigned long long)stats.evaluations, ms / runs,
+                    MaxDeviation(curve, polyline));
+    }
+}
+
+int main(int argc, char** argv) {
+    int curves = argc > 1 ? std::atoi(argv[1]) : 500;
+    double tolerance = argc > 2 ? std::atof(argv[2]) : DEFAULT_CURVE_TOLERANCE;
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> px(0, WIDTH - 1), py(0, HEIGHT - 1);
+    const COLORREF color = RGB(0, 0, 0);
+
+    // Bezier: 4-8 control points spread over the canvas
+    std::vector<std::vector<BezierPoint>> beziers(curves);
+    for (auto& curve : beziers) {
+        int n = 4 + (int)(rng() % 5);
+        for (int i = 0; i < n; i++) curve.push_back(BezierPoint(px(rng), py(rng)));
+    }
+    // Hermite: endpoints plus tangents up to 600 px long
+    std::uniform_real_distribution<double> tangent(-600, 600);
+    std::vector<HermitePoint> hermites;
+    for (int i = 0; i < curves; i++) {
+        hermites.push_back(HermitePoint(px(rng), py(rng)));
+        hermites.push_back(HermitePoint(tangent(rng), tangent(rng)));
+        hermites.push_back(HermitePoint(px(rng), py(rng)));
+        hermites.push_back(HermitePoint(tangent(rng), tangent(rng)));
+    }
+    // Cardinal: 10 points each
+    std::vector<std::vector<HermitePoint>> splines(curves / 10 + 1);
+    for (auto& spline : splines) {
+        for (int i = 0; i < 10; i++) spline.push_back(HermitePoint(px(rng), py(rng)));
+    }
+
+    std::printf("%d curves per kind, tolerance %.2f px\n", curves, tolerance);
+    std::printf("%-9s %-9s %12s %12s %12s %8s %10s\n", "kind", "method", "evaluations", "writes", "covered", "writes/px", "ms");
+
+    // ---- Bezier ----
+    {
+        // Old renderer heuristic: steps from control polygon length
+        auto stepsFor = [](const std::vector<BezierPoint>& c) {
+            double length = 0;
+            for (size_t i = 0; i + 1 < c.size(); i++) length += std::hypot(c[i + 1].x - c[i].x, c[i + 1].y - c[i].y);
+            return std::max(50, std::min(1000, (int)(length * 1.5) + 20));
+        };
+        auto fixed = [&](auto& sink) {
+            for (auto& c : beziers) DrawBezierCurve(sink, c.data(), (int)c.size(), stepsFor(c), color);
+        };
+        Result r = Run(fixed, fixed);
+        for (auto& c : beziers) r.evaluations += stepsFor(c) + 1;
+        Print("bezier", "fixed", r);
+
+        CurveStats stats;
+        CountingSink scratch;
+        for (auto& c : beziers) DrawBezierCurveAdaptive(scratch, c.data(), (int)c.size(), color, tolerance, &stats);
+        auto adaptive = [&](auto& sink) {
+            for (auto& c : beziers) DrawBezierCurveAdaptive(sink, c.data(), (int)c.size(), color, tolerance);
+        };
+        r = Run(adaptive, adaptive);
+        r.evaluations = stats.evaluations;
+        Print("bezier", "adaptive", r);
+    }
+
+    // ---- Hermite ----
+    {
+        auto pointsFor = [](const HermitePoint& p0, const HermitePoint& p1) {
+            double distance = std::hypot(p1.x - p0.x, p1.y - p0.y);
+            return std::max(50, std::min(1000, (int)(distance * 2) + 10));
+        };
+        auto fixed = [&](auto& sink) {
+            for (size_t i = 0; i < hermites.size(); i += 4) {
+                DrawHermiteCurve(sink, hermites[i], hermites[i + 1], hermites[i + 2], hermites[i + 3],
+                                 pointsFor(hermites[i], hermites[i + 2]), color);
+            }
+        };
+        Result r = Run(fixed, fixed);
+        for (size_t i = 0; i < hermites.size(); i += 4) r.evaluations += pointsFor(hermites[i], hermites[i + 2]);
+        Print("hermite", "fixed", r);
+
+        CurveStats stats;
+        CountingSink scratch;
+        for (size_t i = 0; i < hermites.size(); i += 4) {
+            DrawHermiteCurveAdaptive(scratch, hermites[i], hermites[i + 1], hermites[i + 2], hermites[i + 3],
+                                     color, tolerance, &stats);
+        }
+        auto adaptive = [&](auto& sink) {
+            for (size_t i = 0; i < hermites.size(); i += 4) {
+                DrawHermiteCurveAdaptive(sink, hermites[i], hermites[i + 1], hermites[i + 2], hermites[i + 3],
+                                         color, tolerance);
+            }
+        };
+        r = Run(adaptive, adaptive);
+        r.evaluations = stats.evaluations;
+        Print("hermite", "adaptive", r);
+    }
+
+    // ---- Cardinal ----
+    {
+        auto fixed = [&](auto& sink) {
+            for (auto& s : splines) DrawCardinalSpline(sink, s.data(), (int)s.size(), 0.5, 50, color);
+        };
+        Result r = Run(fixed, fixed);
+        // Same per-segment count DrawCardinalSpline uses
+        for (auto& s : splines) {
+            for (size_t i = 0; i + 1 < s.size(); i++) {
+                double distance = std::hypot(s[i + 1].x - s[i].x, s[i + 1].y - s[i].y);
+                int perSegment = std::max(50, std::min(500, (int)(distance * 1.5) + 20));
+                r.evaluations += std::max(perSegment, std::min(1000, (int)(distance * 2) + 10));
+            }
+        }
+        Print("cardinal", "fixed", r);
+
+        CurveStats stats;
+        CountingSink scratch;
+        for (auto& s : splines) DrawCardinalSplineAdaptive(scratch, s.data(), (int)s.size(), 0.5, color, tolerance, &stats);
+        auto adaptive = [&](auto& sink) {
+            for (auto& s : splines) DrawCardinalSplineAdaptive(sink, s.data(), (int)s.size(), 0.5, color, tolerance);
+        };
+        r = Run(adaptive, adaptive);
+        r.evaluations = stats.evaluations;
+        Print("cardinal", "adaptive", r);
+    }
+
+    HighDegreeBeziers(tolerance, rng);
+    return 0;
+}
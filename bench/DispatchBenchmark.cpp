@@ -0,0 +1,393 @@
+// Shape dispatch benchmark.
+// Draws a synthetic scene of 1M shapes into a CountingSink (no memory
+// traffic) three ways and reports nanoseconds per shape:
+//   switch:      the per-mode switch RenderShape used before, deriving radii
+//                with sqrt(pow()) and converting curve points with new[] on
+//                every draw (kept here for comparison)
+//   table:       RenderShape's dispatch table, geometry derived per draw
+//                (a Shape, as from a std::vector<Shape>)
+//   precomputed: the same table with the geometry a Scene stores
+// With tiny shapes (1 px) the algorithms do little, so the time is mostly
+// per-shape overhead; that is shown for the whole mix and for the shapes
+// drawn from a center and radii alone, then for the default sizes against
+// real rasterization. "switch/table" is the switch time over the stored
+// geometry time, so below 1 means the switch was faster. Checks all three
+// write the same pixels.
+//
+// Usage: dispatch_benchmark [shapes] [width] [height]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../include/Bezier.h"
+#include "../include/CircleAlgorithms.h"
+#include "../include/CircleFillAlgorithms.h"
+#include "../include/CurveTessellator.h"
+#include "../include/EllipseAlgorithms.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/Hermite.h"
+#include "../include/LineAlgorithms.h"
+#include "../include/PolygonAlgorithms.h"
+#include "../include/PolygonFillAlgorithms.h"
+#include "../include/Scene.h"
+#include "../include/ShapeRenderer.h"
+#include "BenchScene.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Milliseconds per run, repeated until ~300 ms have elapsed (at least once)
+template <typename Run>
+static double TimeRuns(Run run) {
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        run();
+        runs++;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    } while (elapsed < 300.0);
+    return elapsed / runs;
+}
+
+// RenderShape as it was before the dispatch table, for a CountingSink.
+// Anti-aliased fills go to the library, which derived their radii the same
+// way.
+static void SwitchRenderShape(CountingSink& sink, const Shape& shape) {
+    if (shape.mode == DrawingMode::FLOOD_FILL) {
+        for (const FillSpan& span : shape.spans) {
+            sink.Span(span.x1, span.x2, span.y, shape.color);
+        }
+        return;
+    }
+
+    if (shape.points.size() < 2) return;
+    if (IsAntialiasedFill(shape.fillMode)) {
+        RenderShape(sink, shape);
+        return;
+    }
+
+
+    // Draw shape using its respective algorithm to the sink
+    switch (shape.mode) {
+        case DrawingMode::LINE_DDA:
+            DrawLineDDA(sink, shape.points[0].x, shape.points[0].y,
+                       shape.points[1].x, shape.points[1].y, shape.color);
+            break;
+
+        case DrawingMode::LINE_BRESENHAM:
+            DrawLineBresenham(sink, shape.points[0].x, shape.points[0].y,
+                             shape.points[1].x, shape.points[1].y, shape.color);
+            break;
+
+        case DrawingMode::LINE_PARAMETRIC:
+            DrawLineParametric(sink, shape.points[0].x, shape.points[0].y,
+                              shape.points[1].x, shape.points[1].y, shape.color);
+            break;
+
+        case DrawingMode::CIRCLE_DIRECT:
+        {
+            int radius = (int)sqrt(
+                pow(shape.points[1].x - shape.points[0].x, 2) +
+                pow(shape.points[1].y - shape.points[0].y, 2)
+            );
+            DrawDirectCircle(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+
+            // Apply fill mode if set
+            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
+                FillCircleWithLines(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
+                FillQuarterCircle(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
+                FillCircleWithCircles(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else {
+                // Flood fills need a readable sink
+            }
+        }
+            break;
+
+        case DrawingMode::CIRCLE_POLAR:
+        {
+            int radius = (int)sqrt(
+                pow(shape.points[1].x - shape.points[0].x, 2) +
+                pow(shape.points[1].y - shape.points[0].y, 2)
+            );
+            DrawPolarCircle(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+
+            // Apply fill mode if set
+            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
+                FillCircleWithLines(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
+                FillQuarterCircle(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
+                FillCircleWithCircles(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else {
+                // Flood fills need a readable sink
+            }
+        }
+            break;
+
+        case DrawingMode::CIRCLE_ITERATIVE_POLAR:
+        {
+            int radius = (int)sqrt(
+                pow(shape.points[1].x - shape.points[0].x, 2) +
+                pow(shape.points[1].y - shape.points[0].y, 2)
+            );
+            DrawIterativePolarCircle(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+
+            // Apply fill mode if set
+            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
+                FillCircleWithLines(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
+                FillQuarterCircle(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
+                FillCircleWithCircles(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else {
+                // Flood fills need a readable sink
+            }
+        }
+            break;
+
+        case DrawingMode::CIRCLE_MIDPOINT:
+        {
+            int radius = (int)sqrt(
+                pow(shape.points[1].x - shape.points[0].x, 2) +
+                pow(shape.points[1].y - shape.points[0].y, 2)
+            );
+            DrawCircleBresenham(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+
+            // Apply fill mode if set
+            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
+                FillCircleWithLines(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
+                FillQuarterCircle(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
+                FillCircleWithCircles(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else {
+                // Flood fills need a readable sink
+            }
+        }
+            break;
+
+        case DrawingMode::CIRCLE_MODIFIED_MIDPOINT:
+        {
+            int radius = (int)sqrt(
+                pow(shape.points[1].x - shape.points[0].x, 2) +
+                pow(shape.points[1].y - shape.points[0].y, 2)
+            );
+            DrawCircleDDA1(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+
+            // Apply fill mode if set
+            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
+                FillCircleWithLines(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
+                FillQuarterCircle(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
+                FillCircleWithCircles(sink, shape.points[0].x, shape.points[0].y, radius, shape.color);
+            } else {
+                // Flood fills need a readable sink
+            }
+        }
+            break;
+
+        case DrawingMode::ELLIPSE_DIRECT:
+        {
+            int radiusX = abs(shape.points[1].x - shape.points[0].x);
+            int radiusY = abs(shape.points[1].y - shape.points[0].y);
+            DrawDirectEllipse(sink, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
+        }
+            break;
+
+        case DrawingMode::ELLIPSE_POLAR:
+        {
+            int radiusX = abs(shape.points[1].x - shape.points[0].x);
+            int radiusY = abs(shape.points[1].y - shape.points[0].y);
+            DrawPolarEllipse(sink, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
+        }
+            break;
+
+        case DrawingMode::ELLIPSE_MIDPOINT:
+        {
+            int radiusX = abs(shape.points[1].x - shape.points[0].x);
+            int radiusY = abs(shape.points[1].y - shape.points[0].y);
+            DrawEllipseBresenham(sink, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
+        }
+            break;
+
+        case DrawingMode::SQUARE:
+        {
+            if (shape.points.size() >= 2) {
+                // Calculate half-size (distance from center to edge)
+                int centerX = shape.points[0].x;
+                int centerY = shape.points[0].y;
+                int halfSize = (int)sqrt(
+                    pow(shape.points[1].x - centerX, 2) +
+                    pow(shape.points[1].y - centerY, 2)
+                );
+
+                // Draw square using our DrawSquare function
+                DrawSquare(sink, centerX, centerY, halfSize, shape.color);
+                // Apply Hermite fill if set
+                if (shape.fillMode == FillMode::SQUARE_FILL_HERMITE_VERTICAL) {
+                    FillSquareWithVerticalHermite(sink, centerX, centerY, halfSize, shape.color);
+                }
+            }
+        }
+            break;
+
+        case DrawingMode::RECTANGLE:
+        {
+            if (shape.points.size() >= 2) {
+                // Draw rectangle using our DrawRectangle function
+                DrawRectangle(sink, shape.points[0].x, shape.points[0].y,
+                            shape.points[1].x, shape.points[1].y, shape.color);
+                // Apply Bezier fill if set
+                if (shape.fillMode == FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL) {
+                    FillRectangleWithHorizontalBezier(sink, shape.points[0].x, shape.points[0].y,
+                                                    shape.points[1].x, shape.points[1].y, shape.color);
+                }
+            }
+        }
+            break;
+
+        case DrawingMode::POLYGON:
+        {
+            if (shape.points.size() >= 3) {
+
+                // draw the polygon
+                std::vector<Point> outline(shape.points);  // Passed by value then
+                DrawPolygon(sink, outline.data(), (int)outline.size(), shape.color);
+
+                // Apply polygon fill if set
+                if (shape.fillMode == FillMode::POLYGON_CONVEX_FILL ||
+                    shape.fillMode == FillMode::POLYGON_NONCONVEX_FILL) {
+
+                    PolygonPoint* pointsArray = new PolygonPoint[shape.points.size()];
+                    for (size_t i = 0; i < shape.points.size(); i++) {
+                        pointsArray[i] = PolygonPoint(shape.points[i].x, shape.points[i].y);
+                    }
+
+                    // Either menu choice gets the cheapest filler that is
+                    // correct for this polygon
+                    FillPolygon(sink, pointsArray, shape.points.size(), shape.color);
+
+                    delete[] pointsArray;
+                }
+            }
+        }
+            break;
+
+        case DrawingMode::CURVE_CARDINAL:
+        {
+            if (shape.points.size() >= 2) {
+                // Convert Point to HermitePoint
+                HermitePoint* hermitePoints = new HermitePoint[shape.points.size()];
+                for (size_t i = 0; i < shape.points.size(); i++) {
+                    hermitePoints[i] = HermitePoint(shape.points[i].x, shape.points[i].y);
+                }
+
+                // Draw Cardinal Spline with default tension (0.5)
+                DrawCardinalSplineAdaptive(sink, hermitePoints, shape.points.size(), 0.5, shape.color);
+
+                delete[] hermitePoints;
+            }
+        }
+            break;
+
+        case DrawingMode::CURVE_BEZIER:
+        {
+            if (shape.points.size() >= 2) {
+                // Convert Point to BezierPoint
+                BezierPoint* bezierPoints = new BezierPoint[shape.points.size()];
+                for (size_t i = 0; i < shape.points.size(); i++) {
+                    bezierPoints[i] = BezierPoint(shape.points[i].x, shape.points[i].y);
+                }
+
+                // Draw Bezier Curve
+                DrawBezierCurveAdaptive(sink, bezierPoints, shape.points.size(), shape.color);
+
+                delete[] bezierPoints;
+            }
+        }
+            break;
+
+        case DrawingMode::CURVE_HERMITE:
+        {
+            if (shape.points.size() >= 4) {
+                // For Hermite curves, draw curves for complete point quadruples: (P0, T0, P1, T1)
+                for (size_t i = 0; i + 3 < shape.points.size(); i += 4) {
+                    HermitePoint P0(shape.points[i].x, shape.points[i].y);
+                    HermitePoint T0(shape.points[i + 1].x - shape.points[i].x,
+                                  shape.points[i + 1].y - shape.points[i].y);
+                    HermitePoint P1(shape.points[i + 2].x, shape.points[i + 2].y);
+                    HermitePoint T1(shape.points[i + 3].x - shape.points[i + 2].x,
+                                  shape.points[i + 3].y - shape.points[i + 2].y);
+
+                    DrawHermiteCurveAdaptive(sink, P0, T0, P1, T1, shape.color);
+                }
+            }
+        }
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Shapes drawn from center and radii: circles, ellipses, squares, rectangles
+static bool HasGeometry(const Shape& shape) {
+    return (shape.mode >= DrawingMode::CIRCLE_DIRECT && shape.mode <= DrawingMode::ELLIPSE_MIDPOINT) ||
+           shape.mode == DrawingMode::SQUARE || shape.mode == DrawingMode::RECTANGLE;
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+
+    std::printf("%d shapes on a %dx%d canvas, CountingSink\n\n", count, width, height);
+    std::printf("%-10s %8s %10s %12s %12s %15s %12s %s\n", "shapes", "max size", "count", "switch ns", "table ns",
+                "precomputed ns", "switch/table", "same pixels");
+
+    struct Run {
+        const char* name;
+        int maxSize;
+        bool geometricOnly;
+    };
+    bool identical = true;
+    for (const Run& run : { Run{ "all", 1, false }, Run{ "geometric", 1, true }, Run{ "all", 60, false } }) {
+        std::vector<Shape> shapes = MakeShapes(count, width, height, run.maxSize);
+        if (run.geometricOnly) {
+            std::vector<Shape> kept;
+            for (Shape& shape : shapes) {
+                if (HasGeometry(shape)) kept.push_back(std::move(shape));
+            }
+            shapes.swap(kept);
+        }
+        Scene scene;
+        for (const Shape& shape : shapes) scene.Add(shape);
+
+        CountingSink switchSink, tableSink, sceneSink;
+        double switchMs = TimeRuns([&]() {
+            switchSink.Reset();
+            for (const Shape& shape : shapes) SwitchRenderShape(switchSink, shape);
+        });
+        double tableMs = TimeRuns([&]() {
+            tableSink.Reset();
+            for (const Shape& shape : shapes) RenderShape(tableSink, shape);
+        });
+        double sceneMs = TimeRuns([&]() {
+            sceneSink.Reset();
+            for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sceneSink, scene.View(i));
+        });
+
+        bool same = switchSink.Pixels() == tableSink.Pixels() && tableSink.Pixels() == sceneSink.Pixels() &&
+                    switchSink.Spans() == sceneSink.Spans();
+        identical = identical && same;
+        const double toNs = 1e6 / shapes.size();
+        std::printf("%-10s %8d %10zu %12.1f %12.1f %15.1f %12.2f %s\n", run.name, run.maxSize, shapes.size(),
+                    switchMs * toNs, tableMs * toNs, sceneMs * toNs, switchMs / sceneMs, same ? "yes" : "NO");
+    }
+    return identical ? 0 : 1;
+}
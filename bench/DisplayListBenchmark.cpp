@@ -0,0 +1,140 @@
+// Display list benchmark.
+// For synthetic scenes of 1k to 1M shapes, times a rebuild that runs the
+// algorithms for every shape (no cache), the first rebuild through a
+// DisplayListCache (which records every list) and warm rebuilds replaying
+// them, and reports the cache's memory and hit rate. Then repeats the warm
+// rebuild of the largest scene under budgets of a fraction of what its
+// lists take. Checks every rebuild is bit-identical to the uncached one,
+// serially and through a TiledRebuilder.
+//
+// Usage: display_list_benchmark [maxShapes] [width] [height]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "../include/DisplayList.h"
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/ShapeRenderer.h"
+#include "../include/TiledRebuild.h"
+#include "BenchScene.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Milliseconds per rebuild, repeated until ~300 ms have elapsed (at least once)
+template <typename Rebuild>
+static double TimeRebuild(Rebuild rebuild) {
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        rebuild();
+        runs++;
+        elapsed = MillisecondsSince(start);
+    } while (elapsed < 300.0);
+    return elapsed / runs;
+}
+
+static const COLORREF BACKGROUND = RGB(255, 255, 255);
+
+static void RenderDirect(Framebuffer& framebuffer, const Scene& scene) {
+    framebuffer.Clear(BACKGROUND);
+    BgraSink sink(framebuffer, DirtyTracking::OFF);
+    for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sink, scene.View(i));
+}
+
+static void RenderCached(Framebuffer& framebuffer, const Scene& scene, DisplayListCache& cache) {
+    framebuffer.Clear(BACKGROUND);
+    BgraSink sink(framebuffer, DirtyTracking::OFF);
+    cache.BeginFrame(scene.Size(), framebuffer.Width(), framebuffer.Height());
+    for (std::size_t i = 0; i < scene.Size(); i++) cache.Render(sink, scene.View(i), i);
+}
+
+static bool SamePixels(const Framebuffer& framebuffer, const std::vector<std::uint32_t>& expected) {
+    return std::memcmp(framebuffer.Pixels(), expected.data(), expected.size() * sizeof(std::uint32_t)) == 0;
+}
+
+int main(int argc, char** argv) {
+    int maxShapes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    const std::size_t pixelCount = (std::size_t)width * height;
+    std::printf("%dx%d canvas, default budget %zu MiB\n\n", width, height, DEFAULT_DISPLAY_LIST_BUDGET >> 20);
+    std::printf("%10s %12s %12s %12s %8s %10s %10s %9s %s\n", "shapes", "direct ms", "record ms", "replay ms",
+                "speedup", "lists", "MiB", "B/shape", "identical");
+
+    bool identical = true;
+    Scene largest;
+    std::size_t largestBytes = 0;
+    for (int count : { 1000, 10000, 100000, 1000000 }) {
+        if (count > maxShapes) break;
+        Scene shapes = MakeScene(count, width, height);
+
+        RenderDirect(framebuffer, shapes);
+        std::vector<std::uint32_t> expected(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+        double directMs = TimeRebuild([&]() { RenderDirect(framebuffer, shapes); });
+
+        // Unbounded budget so every list is kept
+        DisplayListCache cache((std::size_t)-1);
+        Clock::time_point start = Clock::now();
+        RenderCached(framebuffer, shapes, cache);
+        double recordMs = MillisecondsSince(start);
+        bool same = SamePixels(framebuffer, expected);
+
+        double replayMs = TimeRebuild([&]() { RenderCached(framebuffer, shapes, cache); });
+        same = same && SamePixels(framebuffer, expected);
+
+        TiledRebuilder rebuilder;
+        framebuffer.Clear(BACKGROUND);
+        rebuilder.Render(framebuffer, shapes, &cache);
+        same = same && SamePixels(framebuffer, expected);
+        identical = identical && same;
+
+        const DisplayListStats& stats = cache.Stats();
+        std::printf("%10d %12.2f %12.2f %12.2f %7.2fx %10zu %10.1f %9.0f %s\n", count, directMs, recordMs, replayMs,
+                    directMs / replayMs, stats.lists, stats.bytes / 1048576.0, (double)stats.bytes / count,
+                    same ? "yes" : "NO");
+        largest = std::move(shapes);
+        largestBytes = stats.bytes;
+    }
+
+    // Budgets below what the scene's lists take: the lists drawn first in a
+    // frame stay, the rest are drawn directly
+    if (!largest.Empty()) {
+        RenderDirect(framebuffer, largest);
+        std::vector<std::uint32_t> expected(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+
+        std::printf("\n%zu shapes under a budget\n", largest.Size());
+        std::printf("%10s %10s %12s %12s %10s %10s %s\n", "budget", "MiB", "direct ms", "replay ms", "hit rate", "lists",
+                    "identical");
+        for (int percent : { 100, 50, 25, 10 }) {
+            DisplayListCache cache(largestBytes * percent / 100);
+            RenderCached(framebuffer, largest, cache);
+            cache.ResetCounters();
+            double replayMs = TimeRebuild([&]() { RenderCached(framebuffer, largest, cache); });
+            bool same = SamePixels(framebuffer, expected);
+            identical = identical && same;
+
+            // Timed again next to the cached run so both see the same heap
+            double directMs = TimeRebuild([&]() { RenderDirect(framebuffer, largest); });
+
+            const DisplayListStats& stats = cache.Stats();
+            double draws = (double)(stats.hits + stats.misses + stats.direct);
+            std::printf("%9d%% %10.1f %12.2f %12.2f %9.1f%% %10zu %s\n", percent, stats.budget / 1048576.0, directMs,
+                        replayMs, draws > 0 ? 100.0 * stats.hits / draws : 0.0, stats.lists, same ? "yes" : "NO");
+        }
+    }
+    return identical ? 0 : 1;
+}
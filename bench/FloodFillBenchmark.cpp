@@ -0,0 +1,164 @@
+// Flood fill benchmark.
+// Fills the same regions with the recursive, the non-recursive (pixel
+// stack), the scanline span fill and the parallel labeling fill, and
+// reports time and fill rate. The parallel fill is timed cold (labeling
+// included) and cached (repeated fills on an unchanged drawing). The
+// regions are an empty canvas, a canvas crossed by walls with gaps (many
+// short runs) and a small box. The recursive fill recurses once per pixel,
+// so it only runs on the small box. Every variant must fill the same
+// pixels; a mismatch is reported.
+//
+// Usage: floodfill_benchmark [width] [height] [threads]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+#include "../include/FloodFill.h"
+#include "../include/Framebuffer.h"
+#include "../include/ParallelFloodFill.h"
+
+static const COLORREF BACKGROUND = RGB(255, 255, 255);
+static const COLORREF WALL = RGB(0, 0, 0);
+static const COLORREF FILL = RGB(200, 30, 30);
+
+// Draws the obstacles of a scene into a cleared framebuffer
+using SceneFn = std::function<void(Framebuffer&)>;
+// Fills from a seed point
+using FillFn = std::function<void(Framebuffer&, int, int)>;
+
+static void DrawBox(Framebuffer& fb, int x1, int y1, int x2, int y2) {
+    for (int x = x1; x <= x2; x++) { fb.Row(y1)[x] = fb.Row(y2)[x] = Framebuffer::ToPixel(WALL); }
+    for (int y = y1; y <= y2; y++) { fb.Row(y)[x1] = fb.Row(y)[x2] = Framebuffer::ToPixel(WALL); }
+}
+
+struct Result {
+    double ms = 0;
+    std::uint64_t filled = 0;
+    std::vector<std::uint32_t> pixels;
+};
+
+static Result Run(int width, int height, const SceneFn& scene, const FillFn& fill, int seedX, int seedY) {
+    Framebuffer fb;
+    fb.Create(width, height);
+    Result result;
+
+    const int repeats = 3;
+    for (int r = 0; r < repeats; r++) {
+        fb.Clear(BACKGROUND);
+        scene(fb);
+        fb.MarkModified();
+        auto start = std::chrono::steady_clock::now();
+        fill(fb, seedX, seedY);
+        result.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    result.ms /= repeats;
+
+    const std::uint32_t fillPixel = Framebuffer::ToPixel(FILL);
+    for (int i = 0; i < width * height; i++) {
+        if (fb.Pixels()[i] == fillPixel) result.filled++;
+    }
+    result.pixels.assign(fb.Pixels(), fb.Pixels() + (std::size_t)width * height);
+    return result;
+}
+
+// Label once, then time repeated fills of the region alternating two colors
+static Result RunCached(int width, int height, const SceneFn& scene, FloodFillLabels& labels, int seedX, int seedY) {
+    Framebuffer fb;
+    fb.Create(width, height);
+    fb.Clear(BACKGROUND);
+    scene(fb);
+    fb.MarkModified();
+    labels.Build(fb);
+
+    Result result;
+    const int fills = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < fills; i++) {
+        result.filled = labels.Fill(fb, seedX, seedY, (i % 2) ? FILL : RGB(30, 200, 30));
+    }
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / fills;
+    result.pixels.assign(fb.Pixels(), fb.Pixels() + (std::size_t)width * height);
+    return result;
+}
+
+static void Print(const char* region, const char* method, const Result& r, const Result* reference) {
+    const char* check = "";
+    if (reference && r.pixels != reference->pixels) check = "  MISMATCH";
+    std::printf("%-8s %-13s %12llu %10.2f %10.1f%s\n", region, method, (unsigned long long)r.filled, r.ms,
+                r.ms > 0 ? r.filled / r.ms / 1000.0 : 0.0, check);
+}
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 3840;
+    int height = argc > 2 ? std::atoi(argv[2]) : 2160;
+    int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+    if (width < 256 || height < 256) {
+        std::fprintf(stderr, "canvas must be at least 256x256\n");
+        return 1;
+    }
+
+    FillFn recursive = [](Framebuffer& fb, int x, int y) {
+        BgraSink sink(fb);
+        FloodFillRecursive(sink, x, y, FILL, sink.Read(x, y));
+    };
+    FillFn stack = [](Framebuffer& fb, int x, int y) {
+        BgraSink sink(fb);
+        FloodFillNonRecursive(sink, x, y, FILL, sink.Read(x, y));
+    };
+    FillFn scanline = [](Framebuffer& fb, int x, int y) {
+        FloodFillScanline(fb, x, y, FILL, Framebuffer::FromPixel(fb.Row(y)[x]));
+    };
+    FloodFillLabels labels(threads);
+    FillFn parallel = [&](Framebuffer& fb, int x, int y) { labels.Fill(fb, x, y, FILL); };
+
+    // Walls every 16 px in both directions with a 2 px gap per cell side at
+    // a random offset, so the region stays connected but breaks into many
+    // short runs
+    std::vector<int> gaps;
+    std::mt19937 rng(12345);
+    for (int i = 0; i < 2 * (width + height); i++) gaps.push_back(1 + (int)(rng() % 5));
+    SceneFn walls = [&](Framebuffer& fb) {
+        const std::uint32_t wall = Framebuffer::ToPixel(WALL);
+        for (int y = 8; y < height; y += 16) {
+            for (int x = 0; x < width; x++) {
+                int gap = gaps[(y / 16 * 131 + x / 16) % gaps.size()];
+                if (x % 16 != gap && x % 16 != gap + 1) fb.Row(y)[x] = wall;
+            }
+        }
+        for (int x = 8; x < width; x += 16) {
+            for (int y = 0; y < height; y++) {
+                int gap = gaps[(x / 16 * 137 + y / 16) % gaps.size()];
+                if (y % 16 != gap && y % 16 != gap + 1) fb.Row(y)[x] = wall;
+            }
+        }
+    };
+    SceneFn empty = [](Framebuffer&) {};
+    SceneFn box = [](Framebuffer& fb) { DrawBox(fb, 50, 50, 177, 177); };
+
+    std::printf("canvas %dx%d, %d threads for the parallel fill\n", width, height, labels.Threads());
+    std::printf("%-8s %-13s %12s %10s %10s\n", "region", "method", "filled", "ms", "Mpx/s");
+
+    Result ref = Run(width, height, box, scanline, 100, 100);
+    Print("box", "scanline", ref, nullptr);
+    Print("box", "non-recursive", Run(width, height, box, stack, 100, 100), &ref);
+    Print("box", "recursive", Run(width, height, box, recursive, 100, 100), &ref);
+    Print("box", "parallel", Run(width, height, box, parallel, 100, 100), &ref);
+    Print("box", "par. cached", RunCached(width, height, box, labels, 100, 100), &ref);
+
+    ref = Run(width, height, empty, scanline, width / 2, height / 2);
+    Print("canvas", "scanline", ref, nullptr);
+    Print("canvas", "non-recursive", Run(width, height, empty, stack, width / 2, height / 2), &ref);
+    Print("canvas", "parallel", Run(width, height, empty, parallel, width / 2, height / 2), &ref);
+    Print("canvas", "par. cached", RunCached(width, height, empty, labels, width / 2, height / 2), &ref);
+
+    ref = Run(width, height, walls, scanline, 0, 0);
+    Print("walls", "scanline", ref, nullptr);
+    Print("walls", "non-recursive", Run(width, height, walls, stack, 0, 0), &ref);
+    Print("walls", "parallel", Run(width, height, walls, parallel, 0, 0), &ref);
+    Print("walls", "par. cached", RunCached(width, height, walls, labels, 0, 0), &ref);
+
+    return 0;
+}
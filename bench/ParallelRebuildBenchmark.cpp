@@ -0,0 +1,97 @@
+// Parallel tile-binned rebuild benchmark.
+// Renders synthetic scenes of 10k to 1M shapes serially (as
+// RebuildOffscreenBuffer() did before) and with TiledRebuilder on 1, 2, 4,
+// 8 and 16 threads, reports ms per rebuild and speedup over serial, and
+// checks every parallel result is bit-identical to the serial one. Scaling
+// is bounded by the cores of the machine it runs on; thread counts above
+// that only show the overhead.
+//
+// Usage: parallel_rebuild_benchmark [maxShapes] [width] [height] [tileSize]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/ShapeRenderer.h"
+#include "../include/TiledRebuild.h"
+#include "BenchScene.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Milliseconds per rebuild, repeated until ~200 ms have elapsed (at least once)
+template <typename Rebuild>
+static double TimeRebuild(Rebuild rebuild) {
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        rebuild();
+        runs++;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    } while (elapsed < 200.0);
+    return elapsed / runs;
+}
+
+int main(int argc, char** argv) {
+    int maxShapes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+    int tileSize = argc > 4 ? std::atoi(argv[4]) : DEFAULT_REBUILD_TILE;
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    const std::size_t pixelCount = (std::size_t)width * height;
+    std::printf("%dx%d canvas, %d px tiles, %u hardware threads\n", width, height, tileSize,
+                std::thread::hardware_concurrency());
+
+    const int threadCounts[] = { 1, 2, 4, 8, 16 };
+    std::vector<TiledRebuilder*> rebuilders;
+    for (int threads : threadCounts) rebuilders.push_back(new TiledRebuilder(threads, tileSize));
+
+    bool identical = true;
+    for (int count : { 10000, 100000, 1000000 }) {
+        if (count > maxShapes) break;
+        Scene scene = MakeScene(count, width, height);
+
+        framebuffer.Clear(RGB(255, 255, 255));
+        BgraSink sink(framebuffer, DirtyTracking::OFF);
+        for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sink, scene.View(i));
+        std::vector<std::uint32_t> serial(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+
+        double serialMs = TimeRebuild([&]() {
+            framebuffer.Clear(RGB(255, 255, 255));
+            BgraSink sink(framebuffer, DirtyTracking::OFF);
+            for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sink, scene.View(i));
+        });
+        std::printf("\n%d shapes\n%8s %12s %10s %10s %s\n", count, "threads", "ms/rebuild", "speedup", "per shape",
+                    "matches serial");
+        std::printf("%8s %12.2f %10.2f %10s %s\n", "serial", serialMs, 1.0, "", "-");
+
+        for (TiledRebuilder* rebuilder : rebuilders) {
+            framebuffer.Clear(RGB(255, 255, 255));
+            rebuilder->Render(framebuffer, scene);
+            bool same = std::memcmp(serial.data(), framebuffer.Pixels(), pixelCount * sizeof(std::uint32_t)) == 0;
+            identical = identical && same;
+
+            double ms = TimeRebuild([&]() {
+                framebuffer.Clear(RGB(255, 255, 255));
+                rebuilder->Render(framebuffer, scene);
+            });
+            // Tiles each shape was rendered into (1 for the serial path)
+            const TiledRebuildStats& stats = rebuilder->LastStats();
+            double perShape = stats.shapes ? (double)(stats.binned + stats.serialShapes) / stats.shapes : 0;
+            std::printf("%8d %12.2f %10.2f %9.2ft %s\n", rebuilder->Threads(), ms, serialMs / ms, perShape,
+                        same ? "yes" : "NO");
+        }
+    }
+
+    for (TiledRebuilder* rebuilder : rebuilders) delete rebuilder;
+    return identical ? 0 : 1;
+}
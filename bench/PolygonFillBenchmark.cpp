@@ -0,0 +1,131 @@
+// Polygon fill benchmark.
+// Fills random star-shaped (non-convex) polygons of growing vertex count
+// on canvases of growing height with NonConvexFill, and with the old
+// std::list edge table filler where it applies (canvas height <= 800).
+// Reports time per fill, pixels covered and whether both fillers produced
+// the same pixels.
+//
+// Usage: polygon_fill_benchmark [maxVertices] [maxHeight]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/PolygonFillAlgorithms.h"
+
+// The original filler, kept here as the baseline: a fixed 800-row table of
+// std::list buckets, re-sorting the whole active list every row
+static const int OLD_TABLE_ROWS = 800;
+
+template <typename Sink>
+static void OldNonConvexFill(Sink& sink, const PolygonPoint p[], int n, COLORREF c) {
+    std::vector<std::list<Node>> t(OLD_TABLE_ROWS);
+    for (int i = 0, prev = n - 1; i < n; prev = i++) {
+        const PolygonPoint* v1 = &p[prev];
+        const PolygonPoint* v2 = &p[i];
+        if (v1->y == v2->y) continue;
+        if (v1->y > v2->y) std::swap(v1, v2);
+        double minv = (v2->x - v1->x) / (v2->y - v1->y);
+        int y = (int)ceil(v1->y);
+        t[y].push_back(Node(v1->x + (y - v1->y) * minv, minv, (int)v2->y));
+    }
+
+    int y = 0;
+    while (y < OLD_TABLE_ROWS) {
+        if (t[y].empty()) { y++; continue; }
+        std::list<Node> active = t[y];
+        while (!active.empty()) {
+            active.sort([](const Node& a, const Node& b) { return a.x < b.x; });
+            for (auto it = active.begin(); it != active.end();) {
+                int x1 = (int)ceil(it->x);
+                if (++it == active.end()) break;
+                int x2 = (int)floor(it->x);
+                ++it;
+                if (x1 <= x2) sink.Span(x1, x2, y, c);
+            }
+            y++;
+            active.remove_if([y](const Node& node) { return node.ymax <= y; });
+            for (auto& node : active) node.x += node.minv;
+            if (y < OLD_TABLE_ROWS) active.insert(active.end(), t[y].begin(), t[y].end());
+        }
+    }
+}
+
+// Integer vertices around the canvas center, radius jittered down to 30%
+static std::vector<PolygonPoint> MakeStar(int vertices, int width, int height, std::mt19937& rng) {
+    std::uniform_real_distribution<double> jitter(0.3, 1.0);
+    const double pi = 3.14159265358979323846;
+    double cx = width / 2.0, cy = height / 2.0;
+    double radius = std::min(width, height) / 2.0 - 1;
+    std::vector<PolygonPoint> points(vertices);
+    for (int i = 0; i < vertices; i++) {
+        double angle = 2 * pi * i / vertices;
+        double r = radius * jitter(rng);
+        points[i] = PolygonPoint(std::round(cx + r * std::cos(angle)), std::round(cy + r * std::sin(angle)));
+    }
+    return points;
+}
+
+// Milliseconds per call, repeated until ~100 ms have elapsed
+template <typename Fill>
+static double TimeFill(Fill fill) {
+    using Clock = std::chrono::steady_clock;
+    fill();  // Warm up
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        fill();
+        runs++;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    } while (elapsed < 100.0);
+    return elapsed / runs;
+}
+
+int main(int argc, char** argv) {
+    int maxVertices = argc > 1 ? std::atoi(argv[1]) : 200000;
+    int maxHeight = argc > 2 ? std::atoi(argv[2]) : 8192;
+
+    std::mt19937 rng(12345);
+    const COLORREF color = RGB(0, 0, 0);
+    const std::uint32_t white = Framebuffer::ToPixel(RGB(255, 255, 255));
+
+    std::printf("%10s %8s %12s %12s %12s %8s\n", "vertices", "height", "pixels", "old ms", "new ms", "match");
+    for (int height : { 768, 2160, 8192 }) {
+        if (height > maxHeight) break;
+        int width = height * 4 / 3;
+        Framebuffer framebuffer;
+        framebuffer.Create(width, height);
+        BgraSink sink(framebuffer);
+
+        for (int vertices : { 8, 64, 1000, 10000, 100000, 200000 }) {
+            if (vertices > maxVertices) break;
+            std::vector<PolygonPoint> star = MakeStar(vertices, width, height, rng);
+
+            framebuffer.Clear(RGB(255, 255, 255));
+            NonConvexFill(sink, star.data(), vertices, color);
+            std::vector<std::uint32_t> filled(framebuffer.Pixels(), framebuffer.Pixels() + (std::size_t)width * height);
+            std::size_t pixels = 0;
+            for (std::uint32_t p : filled) pixels += (p != white);
+
+            double newMs = TimeFill([&]() { NonConvexFill(sink, star.data(), vertices, color); });
+
+            char oldMs[16] = "-", match[8] = "-";
+            if (height <= OLD_TABLE_ROWS) {
+                framebuffer.Clear(RGB(255, 255, 255));
+                OldNonConvexFill(sink, star.data(), vertices, color);
+                bool same = std::equal(filled.begin(), filled.end(), framebuffer.Pixels());
+                std::snprintf(match, sizeof(match), "%s", same ? "yes" : "NO");
+                double ms = TimeFill([&]() { OldNonConvexFill(sink, star.data(), vertices, color); });
+                std::snprintf(oldMs, sizeof(oldMs), "%.3f", ms);
+            }
+
+            std::printf("%10d %8d %12zu %12s %12.3f %8s\n", vertices, height, pixels, oldMs, newMs, match);
+        }
+    }
+    return 0;
+}
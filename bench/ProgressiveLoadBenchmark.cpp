@@ -0,0 +1,215 @@
+// Progressive load benchmark.
+// Saves a synthetic scene as a version 1 and a version 2 .bin file and
+// loads each two ways, timing the first pixel drawn and the last:
+//   blocking:     LoadSceneFromFile, then a full rebuild; nothing shows
+//                 until both are done, so the first pixel is the total
+//   progressive:  SceneLoader parsing on its own thread while this thread
+//                 takes the shapes parsed so far and draws them in order,
+//                 as the window does on WM_SCENE_LOAD
+// Also reports when the loader parsed its first batch and finished, checks
+// both ways draw the same pixels, that a cancel stops the loader promptly,
+// and that a truncated file ends the load in FAILED.
+//
+// Usage: progressive_load_benchmark [shapes] [width] [height]
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/Scene.h"
+#include "../include/SceneFile.h"
+#include "../include/SceneLoader.h"
+#include "../include/ShapeRenderer.h"
+#include "../include/TiledRebuild.h"
+#include "BenchScene.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static const COLORREF BACKGROUND = RGB(255, 255, 255);
+
+static bool SamePixels(const Framebuffer& framebuffer, const std::vector<std::uint32_t>& expected) {
+    return std::memcmp(framebuffer.Pixels(), expected.data(), expected.size() * sizeof(std::uint32_t)) == 0;
+}
+
+struct LoadTimes {
+    bool ok = false;
+    double firstPixelMs = 0;
+    double totalMs = 0;
+    double parseFirstMs = 0;
+    double parseTotalMs = 0;
+};
+
+static LoadTimes LoadBlocking(const std::string& path, Framebuffer& framebuffer, TiledRebuilder& rebuilder) {
+    LoadTimes times;
+    Clock::time_point start = Clock::now();
+    Scene scene;
+    times.ok = LoadSceneFromFile(path, scene);
+    times.parseFirstMs = times.parseTotalMs = MillisecondsSince(start);
+    framebuffer.Clear(BACKGROUND);
+    rebuilder.Render(framebuffer, scene);
+    times.firstPixelMs = times.totalMs = MillisecondsSince(start);
+    return times;
+}
+
+// Wakes the drawing thread when the loader has shapes or has finished
+class LoadSignal {
+public:
+    void Notify() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_signalled = true;
+        m_wake.notify_one();
+    }
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [this]() { return m_signalled; });
+        m_signalled = false;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_signalled = false;
+};
+
+static LoadTimes LoadProgressive(const std::string& path, Framebuffer& framebuffer) {
+    LoadTimes times;
+    LoadSignal signal;
+    SceneLoader loader;
+    Scene scene;
+    std::size_t drawn = 0;
+
+    Clock::time_point start = Clock::now();
+    framebuffer.Clear(BACKGROUND);
+    loader.Start(path, [&signal]() { signal.Notify(); });
+    BgraSink sink(framebuffer, DirtyTracking::OFF);
+    for (;;) {
+        signal.Wait();
+        // The state before the take: once it is final every batch is pending
+        SceneLoader::State state = loader.GetState();
+        loader.TakeShapes(scene);
+        if (drawn == 0 && !scene.Empty()) {
+            RenderShape(sink, scene.View(drawn++));
+            times.firstPixelMs = MillisecondsSince(start);
+        }
+        while (drawn < scene.Size()) RenderShape(sink, scene.View(drawn++));
+        if (state != SceneLoader::State::LOADING) {
+            times.ok = state == SceneLoader::State::DONE;
+            break;
+        }
+    }
+    times.totalMs = MillisecondsSince(start);
+    times.parseFirstMs = loader.FirstBatchMs();
+    times.parseTotalMs = loader.TotalMs();
+    return times;
+}
+
+// Milliseconds from Cancel() to the worker having stopped, once the first
+// batch has arrived; negative if the loader did not end up CANCELLED
+static double CancelLatency(const std::string& path) {
+    LoadSignal signal;
+    SceneLoader loader;
+    loader.Start(path, [&signal]() { signal.Notify(); });
+    signal.Wait();
+    Clock::time_point start = Clock::now();
+    loader.Cancel();
+    double ms = MillisecondsSince(start);
+    return loader.GetState() == SceneLoader::State::CANCELLED ? ms : -1;
+}
+
+static bool TruncatedFileFails(const std::string& path, const std::string& truncatedPath) {
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(truncatedPath, std::ios::binary);
+        out.write(bytes.data(), (std::streamsize)(bytes.size() - bytes.size() / 3));
+    }
+    LoadSignal signal;
+    SceneLoader loader;
+    loader.Start(truncatedPath, [&signal]() { signal.Notify(); });
+    while (loader.GetState() == SceneLoader::State::LOADING) signal.Wait();
+    Scene partial;
+    loader.TakeShapes(partial);
+    return loader.GetState() == SceneLoader::State::FAILED;
+}
+
+int main(int argc, char** argv) {
+    int shapes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    const std::size_t pixelCount = (std::size_t)width * height;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string legacyPath = (directory / "progressive_load_benchmark_v1.bin").string();
+    const std::string currentPath = (directory / "progressive_load_benchmark_v2.bin").string();
+    const std::string truncatedPath = (directory / "progressive_load_benchmark_cut.bin").string();
+
+    Scene scene = MakeScene(shapes, width, height);
+    bool ok = true;
+    {
+        std::ofstream legacy(legacyPath, std::ios::binary);
+        ok = WriteLegacyScene(legacy, scene) && ok;
+    }
+    ok = SaveSceneToFile(currentPath, scene) && ok;
+    TiledRebuilder rebuilder;
+    framebuffer.Clear(BACKGROUND);
+    rebuilder.Render(framebuffer, scene);
+    std::vector<std::uint32_t> expected(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+
+    std::printf("%d shapes, %dx%d canvas, %d rebuild threads\n", shapes, width, height, rebuilder.Threads());
+    std::printf("%-8s %-12s %16s %10s %18s %14s %8s\n", "file", "load", "first pixel ms", "total ms",
+                "parse first ms", "parse all ms", "pixels");
+
+    struct File {
+        const char* name;
+        const std::string* path;
+    } files[] = {
+        { "v1", &legacyPath },
+        { "v2", &currentPath },
+    };
+    for (const File& file : files) {
+        // Warm the OS cache so both ways read the same
+        Scene warm;
+        ok = LoadSceneFromFile(*file.path, warm) && ok;
+
+        for (bool progressive : { false, true }) {
+            LoadTimes times = progressive ? LoadProgressive(*file.path, framebuffer)
+                                          : LoadBlocking(*file.path, framebuffer, rebuilder);
+            bool same = times.ok && SamePixels(framebuffer, expected);
+            std::printf("%-8s %-12s %16.2f %10.2f %18.2f %14.2f %8s\n", file.name,
+                        progressive ? "progressive" : "blocking", times.firstPixelMs, times.totalMs,
+                        times.parseFirstMs, times.parseTotalMs, same ? "same" : "DIFFER");
+            ok = ok && same;
+        }
+
+        double cancelMs = CancelLatency(*file.path);
+        bool fails = TruncatedFileFails(*file.path, truncatedPath);
+        std::printf("%-8s cancel after first batch: %.3f ms (%s), truncated file: %s\n", file.name, cancelMs,
+                    cancelMs < 0 ? "NOT CANCELLED" : "stopped", fails ? "failed" : "NOT FAILED");
+        ok = ok && cancelMs >= 0 && fails;
+    }
+
+    std::filesystem::remove(legacyPath);
+    std::filesystem::remove(currentPath);
+    std::filesystem::remove(truncatedPath);
+    return ok ? 0 : 1;
+}
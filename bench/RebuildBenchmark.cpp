@@ -0,0 +1,200 @@
+// Rebuild throughput benchmark.
+// Renders a synthetic scene the same way RebuildOffscreenBuffer() does and
+// reports pixels/sec. Runs headless; with GDI available it also measures the old
+// per-pixel SetPixel path on a GDI memory DC for comparison. Also reports how
+// many bytes presenting the dirty tiles blits per shape drawn.
+//
+// Usage: rebuild_benchmark [shapeCount] [iterations] [width] [height]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/PolygonFillAlgorithms.h"
+#include "../include/ShapeRenderer.h"
+
+static std::vector<Shape> MakeScene(int count, int width, int height) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> px(0, width - 1);
+    std::uniform_int_distribution<int> py(0, height - 1);
+    std::uniform_int_distribution<int> size(5, 60);
+    std::uniform_int_distribution<int> kind(0, 9);
+
+    const COLORREF palette[] = { RGB(0, 0, 0), RGB(255, 0, 0), RGB(0, 255, 0), RGB(0, 0, 255) };
+
+    std::vector<Shape> shapes;
+    shapes.reserve(count);
+    for (int i = 0; i < count; i++) {
+        Shape shape;
+        shape.color = palette[i % 4];
+        shape.fillMode = FillMode::NONE;
+        shape.thickness = 1;
+
+        int x = px(rng), y = py(rng), r = size(rng);
+        switch (kind(rng)) {
+            case 0: shape.mode = DrawingMode::LINE_DDA; break;
+            case 1: shape.mode = DrawingMode::LINE_BRESENHAM; break;
+            case 2:
+                shape.mode = DrawingMode::CIRCLE_MIDPOINT;
+                shape.fillMode = (i % 3 == 0) ? FillMode::CIRCLE_FILL_LINES : FillMode::NONE;
+                break;
+            case 3: shape.mode = DrawingMode::CIRCLE_POLAR; break;
+            case 4: shape.mode = DrawingMode::ELLIPSE_MIDPOINT; break;
+            case 5:
+                shape.mode = DrawingMode::SQUARE;
+                shape.fillMode = (i % 4 == 0) ? FillMode::SQUARE_FILL_HERMITE_VERTICAL : FillMode::NONE;
+                break;
+            case 6: shape.mode = DrawingMode::RECTANGLE; break;
+            case 7:
+                shape.mode = DrawingMode::POLYGON;
+                shape.fillMode = (i % 2 == 0) ? FillMode::POLYGON_NONCONVEX_FILL : FillMode::NONE;
+                break;
+            case 8: shape.mode = DrawingMode::CURVE_BEZIER; break;
+            default: shape.mode = DrawingMode::CURVE_CARDINAL; break;
+        }
+
+        if (shape.mode == DrawingMode::POLYGON || shape.mode == DrawingMode::CURVE_BEZIER ||
+            shape.mode == DrawingMode::CURVE_CARDINAL) {
+            std::uniform_int_distribution<int> jitter(-r, r);
+            for (int k = 0; k < 5; k++) {
+                shape.points.push_back(Point(x + jitter(rng), y + jitter(rng)));
+            }
+        } else {
+            shape.points.push_back(Point(x, y));
+            shape.points.push_back(Point(x + r, y + r / 2));
+        }
+        shapes.push_back(shape);
+    }
+    return shapes;
+}
+
+template <typename Rebuild>
+static void Measure(const char* label, int iterations, std::uint64_t pixelsPerRebuild, Rebuild rebuild) {
+    rebuild();  // Warm up
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        rebuild();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double msPerRebuild = seconds * 1000.0 / iterations;
+    double pixelsPerSec = (double)pixelsPerRebuild * iterations / seconds;
+    std::printf("%-12s %10.3f ms/rebuild %12.1f Mpixels/s\n", label, msPerRebuild, pixelsPerSec / 1e6);
+}
+
+int main(int argc, char** argv) {
+    int shapeCount = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+    int width = argc > 3 ? std::atoi(argv[3]) : 1024;
+    int height = argc > 4 ? std::atoi(argv[4]) : 768;
+
+    std::vector<Shape> shapes = MakeScene(shapeCount, width, height);
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+
+    // Count the pixel writes of one rebuild so throughput is comparable
+    ResetPolygonFillStats();
+    CountingSink counter;
+    for (const auto& shape : shapes) {
+        RenderShape(counter, shape);
+    }
+    std::uint64_t pixelsPerRebuild = counter.Pixels();
+
+    std::printf("%d shapes, %dx%d canvas, %llu pixel writes per rebuild\n",
+                shapeCount, width, height, (unsigned long long)pixelsPerRebuild);
+    PolygonFillStats polygonFills = GetPolygonFillStats();
+    std::printf("polygon fill paths: %llu convex, %llu monotone, %llu general\n",
+                (unsigned long long)polygonFills.convex, (unsigned long long)polygonFills.monotone,
+                (unsigned long long)polygonFills.general);
+
+    // Clear() dirties every tile, so the rebuild doesn't track them
+    Measure("framebuffer", iterations, pixelsPerRebuild, [&]() {
+        framebuffer.Clear(RGB(255, 255, 255));
+        BgraSink sink(framebuffer, DirtyTracking::OFF);
+        for (const auto& shape : shapes) {
+            RenderShape(sink, shape);
+        }
+    });
+
+    // What marking dirty tiles per pixel costs, as shapes drawn one at a
+    // time onto the canvas pay it
+    Measure("dirty tiles", iterations, pixelsPerRebuild, [&]() {
+        framebuffer.Clear(RGB(255, 255, 255));
+        BgraSink sink(framebuffer, DirtyTracking::ON);
+        for (const auto& shape : shapes) {
+            RenderShape(sink, shape);
+        }
+    });
+
+    // Algorithm cost alone, without memory traffic
+    Measure("counting", iterations, pixelsPerRebuild, [&]() {
+        CountingSink sink;
+        for (const auto& shape : shapes) {
+            RenderShape(sink, shape);
+        }
+    });
+
+    // Shapes drawn one at a time as the window does, each followed by a
+    // paint: what the dirty tiles blit per frame against the whole canvas
+    {
+        framebuffer.Clear(RGB(255, 255, 255));
+        std::vector<Framebuffer::DirtyRect> rects;
+        framebuffer.TakeDirtyRects(rects);
+
+        std::uint64_t bytes = 0, rectCount = 0, tiles = 0;
+        double takeSeconds = 0;
+        for (const auto& shape : shapes) {
+            BgraSink sink(framebuffer);
+            RenderShape(sink, shape);
+
+            auto start = std::chrono::steady_clock::now();
+            tiles += framebuffer.TakeDirtyRects(rects);
+            takeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            rectCount += rects.size();
+            for (const Framebuffer::DirtyRect& rect : rects) {
+                bytes += (std::uint64_t)rect.width * rect.height * sizeof(std::uint32_t);
+            }
+        }
+        double frames = (double)shapes.size();
+        double fullKB = (double)width * height * sizeof(std::uint32_t) / 1024.0;
+        std::printf("per shape    %10.1f KB blitted in %.2f rects (%.1f tiles), full canvas %.1f KB, "
+                    "%.2f us to collect\n",
+                    bytes / 1024.0 / frames, rectCount / frames, tiles / frames, fullKB,
+                    takeSeconds * 1e6 / frames);
+    }
+
+#ifdef GFX_WITH_GDI
+    HDC screen = GetDC(NULL);
+    HDC memoryDC = CreateCompatibleDC(screen);
+    HBITMAP bitmap = CreateCompatibleBitmap(screen, width, height);
+    HGDIOBJ oldBitmap = SelectObject(memoryDC, bitmap);
+    HBRUSH background = CreateSolidBrush(RGB(255, 255, 255));
+    RECT rect = {0, 0, width, height};
+
+    Measure("gdi SetPixel", iterations, pixelsPerRebuild, [&]() {
+        FillRect(memoryDC, &rect, background);
+        GdiSink sink(memoryDC);
+        for (const auto& shape : shapes) {
+            RenderShape(sink, shape);
+        }
+    });
+
+    DeleteObject(background);
+    SelectObject(memoryDC, oldBitmap);
+    DeleteObject(bitmap);
+    DeleteDC(memoryDC);
+    ReleaseDC(NULL, screen);
+#endif
+
+    return 0;
+}
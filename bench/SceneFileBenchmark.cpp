@@ -0,0 +1,219 @@
+// Scene file benchmark.
+// For synthetic scenes of 10k to 1M shapes, saves each as a version 1
+// (legacy) and a version 2 .bin file and times:
+//   legacy:  LoadSceneFromFile on the version 1 file (parsed shape by shape)
+//   stream:  ReadScene on the version 2 file through an ifstream (read into
+//            one buffer, validated, adopted in place)
+//   mapped:  LoadSceneFromFile on the version 2 file (mapped, validated,
+//            adopted in place)
+//   first rebuild: a serial rebuild straight after each load, which is the
+//            first pass to touch a mapped file's points
+// Files are read from the OS cache after the first run, so these are warm
+// load times. Also checks every load draws the same pixels as the scene
+// that was saved, that the version 2 file round-trips, and that truncated
+// or corrupt version 2 files are rejected without touching the scene.
+//
+// Usage: scene_file_benchmark [maxShapes] [width] [height]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/Scene.h"
+#include "../include/SceneFile.h"
+#include "../include/ShapeRenderer.h"
+#include "BenchScene.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Milliseconds per run, repeated until ~300 ms have elapsed (at least once)
+template <typename Run>
+static double TimeRuns(Run run) {
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        run();
+        runs++;
+        elapsed = MillisecondsSince(start);
+    } while (elapsed < 300.0);
+    return elapsed / runs;
+}
+
+static const COLORREF BACKGROUND = RGB(255, 255, 255);
+
+static void Rebuild(Framebuffer& framebuffer, const Scene& scene) {
+    framebuffer.Clear(BACKGROUND);
+    BgraSink sink(framebuffer, DirtyTracking::OFF);
+    for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sink, scene.View(i));
+}
+
+static bool SamePixels(const Framebuffer& framebuffer, const std::vector<std::uint32_t>& expected) {
+    return std::memcmp(framebuffer.Pixels(), expected.data(), expected.size() * sizeof(std::uint32_t)) == 0;
+}
+
+static std::string Bytes(const Scene& scene) {
+    std::ostringstream out;
+    WriteScene(out, scene);
+    return out.str();
+}
+
+// Offset of a chunk's data in a version 2 file, from its directory
+static std::size_t ChunkOffset(const std::string& bytes, const char* id) {
+    std::uint32_t chunkCount;
+    std::memcpy(&chunkCount, bytes.data() + 16, 4);
+    for (std::uint32_t c = 0; c < chunkCount; c++) {
+        const char* entry = bytes.data() + 64 + c * 24;
+        if (std::memcmp(entry, id, 4) == 0) {
+            std::uint64_t offset;
+            std::memcpy(&offset, entry + 8, 8);
+            return (std::size_t)offset;
+        }
+    }
+    return 0;
+}
+
+// Damaged copies of a version 2 file; ReadScene must reject every one and
+// leave the scene it was given alone
+static bool RejectsCorruptFiles(int width, int height) {
+    const std::string bytes = Bytes(MakeScene(1000, width, height));
+
+    std::vector<std::pair<const char*, std::string>> damaged;
+    damaged.push_back({ "truncated", bytes.substr(0, bytes.size() - 1) });
+    damaged.push_back({ "header only", bytes.substr(0, 64) });
+    std::string copy = bytes;
+    copy[8] = 3;
+    damaged.push_back({ "unknown version", copy });
+    copy = bytes;
+    copy[ChunkOffset(bytes, "MODE")] = (char)200;
+    damaged.push_back({ "bad mode", copy });
+    copy = bytes;
+    copy[ChunkOffset(bytes, "BNDF")] = 2;
+    damaged.push_back({ "bad bounds flag", copy });
+    copy = bytes;
+    copy[ChunkOffset(bytes, "BNDS") + 8] ^= 1;
+    damaged.push_back({ "bad bounds", copy });
+    copy = bytes;
+    copy[ChunkOffset(bytes, "PSTR") + 4] = (char)0xff;
+    damaged.push_back({ "bad point start", copy });
+    copy = bytes;
+    copy[ChunkOffset(bytes, "GEOM") + 8] ^= 1;
+    damaged.push_back({ "bad geometry", copy });
+    copy = bytes;
+    std::memcpy(&copy[64], "XXXX", 4);
+    damaged.push_back({ "missing chunk", copy });
+
+    Scene scene = MakeScene(3, 64, 64);
+    const std::string before = Bytes(scene);
+    bool ok = true;
+    for (const auto& file : damaged) {
+        std::istringstream in(file.second);
+        if (ReadScene(in, scene) || Bytes(scene) != before) {
+            std::printf("  %s file was accepted\n", file.first);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int maxShapes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    const std::size_t pixelCount = (std::size_t)width * height;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string legacyPath = (directory / "scene_file_benchmark_v1.bin").string();
+    const std::string currentPath = (directory / "scene_file_benchmark_v2.bin").string();
+    std::printf("%dx%d canvas, files in %s\n", width, height, directory.string().c_str());
+
+    bool ok = true;
+    for (int count : { 10000, 100000, 1000000 }) {
+        if (count > maxShapes) break;
+
+        Scene scene = MakeScene(count, width, height);
+        {
+            std::ofstream legacy(legacyPath, std::ios::binary);
+            ok = WriteLegacyScene(legacy, scene) && ok;
+        }
+        ok = SaveSceneToFile(currentPath, scene) && ok;
+        Rebuild(framebuffer, scene);
+        std::vector<std::uint32_t> expected(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+
+        std::printf("\n%d shapes\n%-8s %10s %10s %16s %10s\n", count, "load", "MiB", "load ms", "first rebuild ms",
+                    "pixels");
+
+        struct Loader {
+            const char* name;
+            const std::string* path;
+            bool stream;
+        } loaders[] = {
+            { "legacy", &legacyPath, false },
+            { "stream", &currentPath, true },
+            { "mapped", &currentPath, false },
+        };
+        for (const Loader& loader : loaders) {
+            auto load = [&](Scene& loaded) {
+                if (!loader.stream) return LoadSceneFromFile(*loader.path, loaded);
+                std::ifstream in(*loader.path, std::ios::binary);
+                return ReadScene(in, loaded);
+            };
+            Scene loaded;
+            double loadMs = TimeRuns([&]() {
+                loaded = Scene();
+                ok = load(loaded) && ok;
+            });
+
+            // A fresh load each time, so the rebuild is the first pass over it
+            double rebuildMs = 0;
+            int runs = 0;
+            Clock::time_point total = Clock::now();
+            do {
+                Scene fresh;
+                ok = load(fresh) && ok;
+                Clock::time_point start = Clock::now();
+                Rebuild(framebuffer, fresh);
+                rebuildMs += MillisecondsSince(start);
+                runs++;
+            } while (MillisecondsSince(total) < 300.0);
+
+            bool same = SamePixels(framebuffer, expected);
+            std::printf("%-8s %10.1f %10.2f %16.2f %10s\n", loader.name,
+                        std::filesystem::file_size(*loader.path) / 1048576.0, loadMs, rebuildMs / runs,
+                        same ? "same" : "DIFFER");
+            ok = ok && same;
+        }
+
+        // The mapped scene writes back the file it was loaded from
+        Scene mapped;
+        ok = LoadSceneFromFile(currentPath, mapped) && ok;
+        bool roundTrip = mapped.IsBorrowed() && Bytes(mapped) == Bytes(scene);
+        std::printf("version 2 file round-trips: %s\n", roundTrip ? "yes" : "NO");
+        ok = ok && roundTrip;
+    }
+
+    bool rejects = RejectsCorruptFiles(width, height);
+    std::printf("\ncorrupt version 2 files rejected: %s\n", rejects ? "yes" : "NO");
+    ok = ok && rejects;
+
+    std::filesystem::remove(legacyPath);
+    std::filesystem::remove(currentPath);
+    return ok ? 0 : 1;
+}
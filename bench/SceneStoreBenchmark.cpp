@@ -0,0 +1,208 @@
+// Scene store benchmark.
+// For synthetic scenes of 10k to 1M shapes, compares the scene as a
+// std::vector<Shape> (one object and up to three heap arrays per shape)
+// with the column store in Scene:
+//   memory:  bytes per shape held by each, counted from capacities and, on
+//            glibc, measured as the heap growth while building them
+//   bounds:  a pass over every shape's bounds, computed per shape from the
+//            vector (as a rebuild did) and read from the Scene's column
+//   rebuild: a serial rebuild drawing every shape from each
+//   load:    parsing the same version 1 .bin file shape by shape from the
+//            stream into vectors (the old reader) and with ReadScene's bulk
+//            read
+// and checks both draw the same pixels and the file round-trips.
+//
+// Usage: scene_store_benchmark [maxShapes] [width] [height]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/Scene.h"
+#include "../include/SceneFile.h"
+#include "../include/ShapeRenderer.h"
+#include "BenchScene.h"
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#include <malloc.h>
+#define HAVE_MALLINFO2 1
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Milliseconds per run, repeated until ~300 ms have elapsed (at least once)
+template <typename Run>
+static double TimeRuns(Run run) {
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        run();
+        runs++;
+        elapsed = MillisecondsSince(start);
+    } while (elapsed < 300.0);
+    return elapsed / runs;
+}
+
+// Bytes in use on the heap, or 0 where that can't be asked
+static std::size_t HeapInUse() {
+#ifdef HAVE_MALLINFO2
+    // Large blocks are mapped separately from the arena
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+// Capacity of the vector and of every shape's arrays
+static std::size_t VectorBytes(const std::vector<Shape>& shapes) {
+    std::size_t bytes = shapes.capacity() * sizeof(Shape);
+    for (const Shape& shape : shapes) {
+        bytes += shape.points.capacity() * sizeof(Point) + shape.spans.capacity() * sizeof(FillSpan);
+    }
+    return bytes;
+}
+
+// The reader the window used before Scene: a few small stream reads and up
+// to three allocations per shape
+template <typename T>
+static bool ReadValue(std::istream& in, T& value) {
+    return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+static bool ReadShapesPerShape(std::istream& in, std::vector<Shape>& shapes) {
+    std::int32_t shapeCnt = 0;
+    if (!ReadValue(in, shapeCnt) || shapeCnt < 0) return false;
+    std::vector<Shape> loaded;
+    loaded.reserve(std::min<std::int32_t>(shapeCnt, 1 << 16));
+    for (std::int32_t i = 0; i < shapeCnt; ++i) {
+        std::int32_t mode, fillMode, thickness, pointCnt;
+        std::uint32_t color;
+        if (!ReadValue(in, mode) || !ReadValue(in, color) || !ReadValue(in, fillMode) ||
+            !ReadValue(in, thickness) || !ReadValue(in, pointCnt) || pointCnt < 0) {
+            return false;
+        }
+        Shape shape;
+        shape.mode = (DrawingMode)mode;
+        shape.color = (COLORREF)color;
+        shape.fillMode = (FillMode)fillMode;
+        shape.thickness = thickness;
+        shape.points.resize(pointCnt);
+        if (pointCnt > 0 && !in.read(reinterpret_cast<char*>(shape.points.data()), pointCnt * sizeof(Point))) {
+            return false;
+        }
+        if (shape.mode == DrawingMode::FLOOD_FILL) {
+            std::int32_t spanCnt;
+            if (!ReadValue(in, spanCnt) || spanCnt < 0) return false;
+            shape.spans.resize(spanCnt);
+            if (spanCnt > 0 && !in.read(reinterpret_cast<char*>(shape.spans.data()), spanCnt * sizeof(FillSpan))) {
+                return false;
+            }
+        }
+        loaded.push_back(std::move(shape));
+    }
+    shapes = std::move(loaded);
+    return true;
+}
+
+static const COLORREF BACKGROUND = RGB(255, 255, 255);
+
+int main(int argc, char** argv) {
+    int maxShapes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    const std::size_t pixelCount = (std::size_t)width * height;
+    std::printf("%dx%d canvas; sizeof(Shape) = %zu, heap measured: %s\n", width, height, sizeof(Shape),
+                HeapInUse() ? "yes" : "no");
+
+    bool ok = true;
+    for (int count : { 10000, 100000, 1000000 }) {
+        if (count > maxShapes) break;
+
+        std::size_t heap = HeapInUse();
+        std::vector<Shape> shapes = MakeShapes(count, width, height);
+        std::size_t vectorHeap = HeapInUse() - heap;
+        heap = HeapInUse();
+        Scene scene = MakeScene(count, width, height);
+        std::size_t sceneHeap = HeapInUse() - heap;
+
+        std::printf("\n%d shapes\n%-8s %12s %12s %12s %12s %12s\n", count, "store", "B/shape", "heap B/shape",
+                    "bounds ms", "rebuild ms", "load ms");
+
+        // Bounds pass; the sums keep the loops from being optimized away
+        long long vectorSum = 0, sceneSum = 0;
+        double vectorBoundsMs = TimeRuns([&]() {
+            vectorSum = 0;
+            for (const Shape& shape : shapes) {
+                PixelRect r;
+                if (GetShapeBounds(shape, r)) vectorSum += r.left + r.bottom;
+            }
+        });
+        double sceneBoundsMs = TimeRuns([&]() {
+            sceneSum = 0;
+            for (std::size_t i = 0; i < scene.Size(); i++) {
+                if (scene.IsBounded(i)) sceneSum += scene.Bounds(i).left + scene.Bounds(i).bottom;
+            }
+        });
+
+        auto rebuildVector = [&]() {
+            framebuffer.Clear(BACKGROUND);
+            BgraSink sink(framebuffer, DirtyTracking::OFF);
+            for (const Shape& shape : shapes) RenderShape(sink, shape);
+        };
+        auto rebuildScene = [&]() {
+            framebuffer.Clear(BACKGROUND);
+            BgraSink sink(framebuffer, DirtyTracking::OFF);
+            for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sink, scene.View(i));
+        };
+        rebuildVector();
+        std::vector<std::uint32_t> expected(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+        double vectorRebuildMs = TimeRuns(rebuildVector);
+        double sceneRebuildMs = TimeRuns(rebuildScene);
+        bool same = std::memcmp(framebuffer.Pixels(), expected.data(), pixelCount * sizeof(std::uint32_t)) == 0;
+
+        // Load the same bytes both ways
+        std::ostringstream file;
+        WriteLegacyScene(file, scene);
+        const std::string bytes = file.str();
+        double vectorLoadMs = TimeRuns([&]() {
+            std::istringstream in(bytes);
+            std::vector<Shape> loaded;
+            ok = ReadShapesPerShape(in, loaded) && ok;
+        });
+        Scene loaded;
+        double sceneLoadMs = TimeRuns([&]() {
+            std::istringstream in(bytes);
+            ok = ReadScene(in, loaded) && ok;
+        });
+        std::ostringstream again;
+        WriteLegacyScene(again, loaded);
+        bool roundTrip = again.str() == bytes;
+
+        std::printf("%-8s %12.1f %12.1f %12.3f %12.2f %12.2f\n", "vector", (double)VectorBytes(shapes) / count,
+                    (double)vectorHeap / count, vectorBoundsMs, vectorRebuildMs, vectorLoadMs);
+        std::printf("%-8s %12.1f %12.1f %12.3f %12.2f %12.2f\n", "Scene", (double)scene.MemoryBytes() / count,
+                    (double)sceneHeap / count, sceneBoundsMs, sceneRebuildMs, sceneLoadMs);
+        std::printf("same pixels: %s, same bounds: %s, file round-trips: %s (%.1f MiB)\n", same ? "yes" : "NO",
+                    vectorSum == sceneSum ? "yes" : "NO", roundTrip ? "yes" : "NO", bytes.size() / 1048576.0);
+        ok = ok && same && vectorSum == sceneSum && roundTrip;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// Spatial index benchmark.
+// Hit testing: random clicks on scenes of 1k to 1M shapes, finding the
+// first circle, polygon or rectangle containing the click by a linear scan
+// of the scene and through the index (same exact tests, so the answers
+// must agree). Dense scenes put a target under nearly every click early in
+// the scan, so clicks that match nothing (the scene has no direct-method
+// ellipses) are timed as well: the scan then visits every shape.
+//
+// Fill latency: for synthetic scenes of 1k to 1M shapes, fills circles one
+// at a time the way a fill click does, redrawing either the whole scene
+// (the old path) or only the circle's bounds through the index. Checks the
+// region redraws leave the same pixels as a full rebuild of the edited
+// scene. Region cost follows the shapes overlapping the circle, which grows
+// with how densely the canvas is covered, not with the scene as such.
+//
+// Usage: shape_index_benchmark [maxShapes] [width] [height]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/ShapeIndex.h"
+#include "../include/ShapeRenderer.h"
+#include "BenchScene.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void RenderAll(Framebuffer& framebuffer, const Scene& scene, COLORREF background) {
+    framebuffer.Clear(background);
+    BgraSink sink(framebuffer, DirtyTracking::OFF);
+    for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sink, scene.View(i));
+}
+
+// The shapes fill clicks target in the window
+static bool IsFillTarget(const ShapeView& shape) {
+    switch (shape.mode) {
+        case DrawingMode::CIRCLE_MIDPOINT:
+        case DrawingMode::CIRCLE_POLAR:
+        case DrawingMode::POLYGON:
+        case DrawingMode::SQUARE:
+        case DrawingMode::RECTANGLE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool IsDirectEllipse(const ShapeView& shape) {
+    return shape.mode == DrawingMode::ELLIPSE_DIRECT;
+}
+
+// First shape 'accept' takes that contains (x, y), scanning every shape
+static std::ptrdiff_t LinearHitTest(const Scene& scene, int x, int y, bool (*accept)(const ShapeView&)) {
+    for (std::size_t i = 0; i < scene.Size(); i++) {
+        const ShapeView shape = scene.View(i);
+        if (accept(shape) && ShapeContainsPoint(shape, x, y)) return (std::ptrdiff_t)i;
+    }
+    return -1;
+}
+
+// Microseconds per click for 'clicks' hit tests, answers in 'found'
+template <typename Test>
+static double TimeClicks(const std::vector<Point>& points, int clicks, std::vector<std::ptrdiff_t>& found, Test test) {
+    found.resize(clicks);
+    Clock::time_point start = Clock::now();
+    for (int k = 0; k < clicks; k++) found[k] = test(points[k].x, points[k].y);
+    return MillisecondsSince(start) * 1000.0 / clicks;
+}
+
+static bool HitTests(int maxShapes, int width, int height) {
+    std::printf("%10s %12s %12s %14s %14s %8s %s\n", "shapes", "linear hit", "index hit", "linear miss",
+                "index miss", "hits", "agree");
+    bool agree = true;
+    for (int count : { 1000, 10000, 100000, 1000000 }) {
+        if (count > maxShapes) break;
+        Scene shapes = MakeScene(count, width, height);
+        ShapeIndex index;
+        index.Build(shapes, width, height);
+
+        // The linear scan is timed on fewer clicks on the large scenes
+        const int clicks = 100000;
+        const int linearClicks = std::max(100, std::min(clicks, 100000000 / count));
+        std::mt19937 rng(99);
+        std::uniform_int_distribution<int> px(0, width - 1), py(0, height - 1);
+        std::vector<Point> points(clicks);
+        for (Point& point : points) point = Point(px(rng), py(rng));
+
+        std::vector<std::ptrdiff_t> linearHits, indexHits, linearMisses, indexMisses;
+        double linearHit = TimeClicks(points, linearClicks, linearHits, [&](int x, int y) {
+            return LinearHitTest(shapes, x, y, IsFillTarget);
+        });
+        double indexHit = TimeClicks(points, clicks, indexHits, [&](int x, int y) {
+            return index.HitTest(shapes, x, y, IsFillTarget);
+        });
+        double linearMiss = TimeClicks(points, linearClicks, linearMisses, [&](int x, int y) {
+            return LinearHitTest(shapes, x, y, IsDirectEllipse);
+        });
+        double indexMiss = TimeClicks(points, clicks, indexMisses, [&](int x, int y) {
+            return index.HitTest(shapes, x, y, IsDirectEllipse);
+        });
+
+        int hits = 0;
+        bool same = true;
+        for (int k = 0; k < clicks; k++) {
+            hits += indexHits[k] >= 0;
+            if (k < linearClicks && (indexHits[k] != linearHits[k] || indexMisses[k] != linearMisses[k])) same = false;
+        }
+        agree = agree && same;
+        std::printf("%10d %10.3fus %10.3fus %12.3fus %12.3fus %7.0f%% %s\n", count, linearHit, indexHit, linearMiss,
+                    indexMiss, 100.0 * hits / clicks, same ? "yes" : "NO");
+    }
+    return agree;
+}
+
+int main(int argc, char** argv) {
+    int maxShapes = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    const COLORREF background = RGB(255, 255, 255);
+    const std::size_t pixelCount = (std::size_t)width * height;
+    const int edits = 100;
+
+    std::printf("%dx%d canvas\n\nHit testing\n", width, height);
+    bool identical = HitTests(maxShapes, width, height);
+
+    std::printf("\nFill latency, %d circle fills per scene\n", edits);
+    std::printf("%10s %10s %14s %14s %12s %14s %s\n", "shapes", "index ms", "rebuild ms/op", "region ms/op",
+                "region px", "region shapes", "matches rebuild");
+
+    for (int count : { 1000, 10000, 100000, 1000000 }) {
+        if (count > maxShapes) break;
+        Scene shapes = MakeScene(count, width, height);
+
+        ShapeIndex index;
+        Clock::time_point start = Clock::now();
+        index.Build(shapes, width, height);
+        double indexMs = MillisecondsSince(start);
+
+        // Unfilled circles spread through the drawing order
+        std::vector<std::size_t> circles;
+        for (std::size_t i = 0; i < shapes.Size(); i++) {
+            if (shapes[i].mode == DrawingMode::CIRCLE_MIDPOINT && shapes[i].fillMode == FillMode::NONE) {
+                circles.push_back(i);
+            }
+        }
+        std::size_t stride = std::max<std::size_t>(circles.size() / edits, 1);
+
+        // Old path: every fill rebuilds the scene. Timed on a few fills only,
+        // it is the same work each time.
+        RenderAll(framebuffer, shapes, background);
+        int rebuilds = count >= 1000000 ? 1 : 5;
+        start = Clock::now();
+        for (int k = 0; k < rebuilds; k++) RenderAll(framebuffer, shapes, background);
+        double rebuildMs = MillisecondsSince(start) / rebuilds;
+
+        // New path: redraw the circle's old and new bounds
+        int done = 0;
+        double regionPixels = 0, regionShapes = 0;
+        std::vector<std::uint32_t> hits;
+        double queryMs = 0;
+        start = Clock::now();
+        for (std::size_t k = 0; k < circles.size() && done < edits; k += stride, done++) {
+            std::size_t i = circles[k];
+            PixelRect damage = index.Bounds(i);
+            shapes.SetFill(i, FillMode::CIRCLE_FILL_LINES, shapes[i].color);
+            index.Update(shapes, i);
+            const PixelRect& bounds = index.Bounds(i);
+            damage = { std::min(damage.left, bounds.left), std::min(damage.top, bounds.top),
+                       std::max(damage.right, bounds.right), std::max(damage.bottom, bounds.bottom) };
+            RedrawRegion(framebuffer, shapes, index, damage, background);
+
+            // Counted outside the redraw's own query, and not timed
+            Clock::time_point queryStart = Clock::now();
+            index.Query(damage, hits);
+            regionShapes += hits.size();
+            queryMs += MillisecondsSince(queryStart);
+            regionPixels += (double)(damage.right - damage.left + 1) * (damage.bottom - damage.top + 1);
+        }
+        double regionMs = done ? (MillisecondsSince(start) - queryMs) / done : 0;
+
+        std::vector<std::uint32_t> incremental(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+        RenderAll(framebuffer, shapes, background);
+        bool same = std::memcmp(incremental.data(), framebuffer.Pixels(), pixelCount * sizeof(std::uint32_t)) == 0;
+        identical = identical && same;
+
+        std::printf("%10d %10.2f %14.3f %14.3f %12.0f %14.0f %s\n", count, indexMs, rebuildMs, regionMs,
+                    done ? regionPixels / done : 0.0, done ? regionShapes / done : 0.0, same ? "yes" : "NO");
+    }
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+// Triangulated polygon fill benchmark.
+// Builds random simple (star-shaped) polygons with integer vertices, and
+// for each one times the ear-clipping triangulation, a fill from the
+// triangles, and a scanline fill with FillPolygon (what RenderShape uses). Reports how
+// many pixels the two fills disagree on (boundary pixels, which the scanline
+// fill rounds from floating-point edge intersections). Rounded vertices can
+// make the densest stars self-intersecting; those are reported as such.
+//
+// Usage: triangle_fill_benchmark [maxVertices] [width] [height]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/PolygonFillAlgorithms.h"
+#include "../include/TriangleFill.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Milliseconds per call, repeated until ~100 ms have elapsed
+template <typename Fill>
+static double TimeFill(Fill fill) {
+    fill();  // Warm up
+    int runs = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0;
+    do {
+        fill();
+        runs++;
+        elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    } while (elapsed < 100.0);
+    return elapsed / runs;
+}
+
+// Vertices in angle order around the center, radius jittered down to 30%
+static std::vector<Point> MakeStar(int vertices, int width, int height, std::mt19937& rng) {
+    std::uniform_real_distribution<double> jitter(0.3, 1.0);
+    const double pi = 3.14159265358979323846;
+    double cx = width / 2.0, cy = height / 2.0;
+    double radius = std::min(width, height) / 2.0 - 1;
+    std::vector<Point> points(vertices);
+    for (int i = 0; i < vertices; i++) {
+        double angle = 2 * pi * i / vertices;
+        double r = radius * jitter(rng);
+        points[i] = Point((int)std::lround(cx + r * std::cos(angle)), (int)std::lround(cy + r * std::sin(angle)));
+    }
+    return points;
+}
+
+int main(int argc, char** argv) {
+    int maxVertices = argc > 1 ? std::atoi(argv[1]) : 4096;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::atoi(argv[3]) : 768;
+
+    Framebuffer framebuffer;
+    if (!framebuffer.Create(width, height)) {
+        std::fprintf(stderr, "Failed to allocate %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+    BgraSink sink(framebuffer);
+    std::mt19937 rng(12345);
+    const COLORREF color = RGB(0, 0, 0);
+    const std::size_t pixelCount = (std::size_t)width * height;
+
+    std::printf("%10s %10s %14s %12s %12s %10s\n", "vertices", "triangles", "triangulate ms", "scanline ms",
+                "triangle ms", "diff px");
+    for (int vertices : { 4, 8, 64, 256, 1024, 4096 }) {
+        if (vertices > maxVertices) break;
+        std::vector<Point> polygon = MakeStar(vertices, width, height, rng);
+        std::vector<PolygonPoint> points(vertices);
+        for (int i = 0; i < vertices; i++) points[i] = PolygonPoint(polygon[i].x, polygon[i].y);
+
+        std::vector<int> triangles;
+        Clock::time_point start = Clock::now();
+        bool ok = TriangulatePolygon(polygon.data(), vertices, triangles);
+        double triangulateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (!ok) {
+            std::printf("%10d %10s\n", vertices, "not simple");
+            continue;
+        }
+
+        framebuffer.Clear(RGB(255, 255, 255));
+        FillPolygon(sink, points.data(), vertices, color);
+        std::vector<std::uint32_t> scanline(framebuffer.Pixels(), framebuffer.Pixels() + pixelCount);
+        framebuffer.Clear(RGB(255, 255, 255));
+        FillTriangles(sink, polygon.data(), triangles.data(), (int)triangles.size(), color);
+        std::size_t diff = 0;
+        for (std::size_t i = 0; i < pixelCount; i++) diff += scanline[i] != framebuffer.Pixels()[i];
+
+        double scanlineMs = TimeFill([&]() { FillPolygon(sink, points.data(), vertices, color); });
+        double triangleMs = TimeFill([&]() {
+            FillTriangles(sink, polygon.data(), triangles.data(), (int)triangles.size(), color);
+        });
+        std::printf("%10d %10zu %14.3f %12.3f %12.3f %10zu\n", vertices, triangles.size() / 3, triangulateMs,
+                    scanlineMs, triangleMs, diff);
+    }
+    return 0;
+}
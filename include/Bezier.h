@@ -1,15 +1,99 @@
 #ifndef BEZIER_ALGORITHMS_H
 #define BEZIER_ALGORITHMS_H
 
-#include <windows.h>
+#include <vector>
+#include "PixelSink.h"
 
 struct BezierPoint {
     double x, y;
     BezierPoint(double x = 0, double y = 0) : x(x), y(y) {}
 };
 
+// ========================================
+// BEZIER EVALUATION
+// ========================================
+
+// Point at t on the curve through pts[si..ei]. Kept for existing callers;
+// now evaluated iteratively (see DeCasteljau) instead of by recursion.
 BezierPoint RecBezier(double t, BezierPoint pts[], int si, int ei);
 
+// In-place iterative de Casteljau, O(n^2) per sample and numerically the
+// most robust. 'scratch' must hold numPoints entries.
+BezierPoint DeCasteljau(double t, const BezierPoint pts[], int numPoints, BezierPoint scratch[]);
+
+// Bernstein basis values for a fixed degree sampled at t = i / steps,
+// i = 0..steps, built once per (degree, steps), after which each sample
+// costs one multiply-add per weight kept. A row of weights at t is the
+// binomial distribution (degree, t): it is built outward from its largest
+// weight by the ratio between neighbours, so no binomial or power of t is
+// ever formed and any degree stays in range. Weights below NEGLIGIBLE are
+// dropped; about sqrt(degree) remain around t * degree, so high degrees
+// also sample in less than O(n).
+class BernsteinBasis {
+public:
+    // Smaller weights move a sample by far less than a pixel
+    static constexpr double NEGLIGIBLE = 1e-17;
+
+    void Build(int degree, int steps);
+    bool Matches(int degree, int steps) const { return m_degree == degree && m_steps == steps; }
+
+    int Degree() const { return m_degree; }
+    int Steps() const { return m_steps; }
+
+    // Point at any t in [0, 1] for Degree() + 1 control points, from the
+    // same weights as a row of the table but without storing them
+    BezierPoint EvaluateAt(const BezierPoint pts[], double t) const;
+
+    // Point at t = step / steps for degree + 1 control points
+    BezierPoint Evaluate(const BezierPoint pts[], int step) const {
+        const double* weights = &m_weights[m_rowStart[step]];
+        const int count = (int)(m_rowStart[step + 1] - m_rowStart[step]);
+        const BezierPoint* p = pts + m_firstPoint[step];
+        double x = 0, y = 0;
+        for (int i = 0; i < count; i++) {
+            x += weights[i] * p[i].x;
+            y += weights[i] * p[i].y;
+        }
+        return BezierPoint(x, y);
+    }
+
+private:
+    // The largest weight of the row at t, which is at 'mode'
+    double ModeWeight(int mode, double t) const;
+
+    int m_degree = -1;
+    int m_steps = -1;
+    std::vector<double> m_logFactorials;   // log(i!), i = 0..degree
+    std::vector<int> m_firstPoint;         // Per step: control point of its first weight
+    std::vector<std::size_t> m_rowStart;   // Per step: its weights are [start[step], start[step + 1])
+    std::vector<double> m_weights;
+};
+
+// Samples a cubic at t = i / steps by forward differencing: three adds per
+// coordinate per sample after setup.
+class CubicForwardDiffer {
+public:
+    CubicForwardDiffer(const BezierPoint pts[4], int steps);
+
+    const BezierPoint& Current() const { return m_p; }
+
+    void Next() {
+        m_p.x += m_d1.x; m_d1.x += m_d2.x; m_d2.x += m_d3.x;
+        m_p.y += m_d1.y; m_d1.y += m_d2.y; m_d2.y += m_d3.y;
+    }
+
+private:
+    BezierPoint m_p, m_d1, m_d2, m_d3;
+};
+
+// Draws 'steps + 1' samples (t = 0..1 inclusive). Cubics use forward
+// differencing, every other degree a cached Bernstein table.
+template <typename Sink>
+void DrawBezierCurve(Sink& sink, BezierPoint pts[], int numPoints, int steps, COLORREF color);
+
+#ifdef GFX_WITH_GDI
+// GDI wrapper
 void DrawBezierCurve(HDC hdc, BezierPoint pts[], int numPoints, int steps, COLORREF color);
+#endif
 
-#endif
\ No newline at end of file
+#endif
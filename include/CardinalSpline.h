@@ -1,9 +1,15 @@
 #ifndef CARDINALSPLINE_H
 #define CARDINALSPLINE_H
 
-#include <windows.h>
+#include "PixelSink.h"
 #include "Hermite.h"
 
+template <typename Sink>
+void DrawCardinalSpline(Sink& sink, HermitePoint* points, int n, double c, int numPointsPerSegment, COLORREF color);
+
+#ifdef GFX_WITH_GDI
+// GDI wrapper
 void DrawCardinalSpline(HDC hdc, HermitePoint* points, int n, double c, int numPointsPerSegment, COLORREF color);
+#endif
 
 #endif //CARDINALSPLINE_H
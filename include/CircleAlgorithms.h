@@ -1,16 +1,36 @@
 #ifndef CIRCLE_ALGORITHMS_H
 #define CIRCLE_ALGORITHMS_H
 
-#include <windows.h>
+#include "PixelSink.h"
 
 // Circle drawing algorithm declarations
-void DrawDirectCircle(HDC hdc, int xc, int yc, int R, COLORREF c);        // Direct Circle
-void DrawPolarCircle(HDC hdc, int xc, int yc, int R, COLORREF c);        // Polar Circle
-void DrawIterativePolarCircle(HDC hdc, int xc, int yc, int R, COLORREF c);   // Iterative Polar Circle
-void DrawCircleBresenham(HDC hdc, int xc, int yc, int R, COLORREF c); // Midpoint Circle
-void DrawCircleDDA1(HDC hdc, int xc, int yc, int R, COLORREF c);     // Modified Midpoint Circle
+template <typename Sink> void DrawDirectCircle(Sink& sink, int xc, int yc, int R, COLORREF c);        // Direct Circle
+template <typename Sink> void DrawPolarCircle(Sink& sink, int xc, int yc, int R, COLORREF c);        // Polar Circle
+template <typename Sink> void DrawIterativePolarCircle(Sink& sink, int xc, int yc, int R, COLORREF c);   // Iterative Polar Circle
+template <typename Sink> void DrawCircleBresenham(Sink& sink, int xc, int yc, int R, COLORREF c); // Midpoint Circle
+template <typename Sink> void DrawCircleDDA1(Sink& sink, int xc, int yc, int R, COLORREF c);     // Modified Midpoint Circle
 
-// Helper function
+// Helper function (inline so the 8-way plot stays in the caller's loop)
+template <typename Sink>
+inline void DrawPoint(Sink& sink, int xc, int yc, int x, int y, COLORREF c) {
+    sink.Plot(xc+x, yc+y, c);
+    sink.Plot(xc-x, yc+y, c);
+    sink.Plot(xc-x, yc-y, c);
+    sink.Plot(xc+x, yc-y, c);
+    sink.Plot(xc+y, yc+x, c);
+    sink.Plot(xc-y, yc+x, c);
+    sink.Plot(xc-y, yc-x, c);
+    sink.Plot(xc+y, yc-x, c);
+}
+
+#ifdef GFX_WITH_GDI
+// GDI wrappers
+void DrawDirectCircle(HDC hdc, int xc, int yc, int R, COLORREF c);
+void DrawPolarCircle(HDC hdc, int xc, int yc, int R, COLORREF c);
+void DrawIterativePolarCircle(HDC hdc, int xc, int yc, int R, COLORREF c);
+void DrawCircleBresenham(HDC hdc, int xc, int yc, int R, COLORREF c);
+void DrawCircleDDA1(HDC hdc, int xc, int yc, int R, COLORREF c);
 void DrawPoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
+#endif
 
-#endif // CIRCLE_ALGORITHMS_H 
\ No newline at end of file
+#endif // CIRCLE_ALGORITHMS_H 
@@ -1,25 +1,34 @@
 #ifndef CIRCLE_FILL_ALGORITHMS_H
 #define CIRCLE_FILL_ALGORITHMS_H
 
-#include <windows.h>
+#include "PixelSink.h"
 #include "CircleAlgorithms.h"
 #include "LineAlgorithms.h"
 
 
 
 // 1. Fill circle with lines (fill one octal with lines, rest with 8-point symmetry)
-void FillCircleWithLines(HDC hdc, int xc, int yc, int R, COLORREF c);
+template <typename Sink> void FillCircleWithLines(Sink& sink, int xc, int yc, int R, COLORREF c);
 
 // 2. Fill quarter of circle only
-void FillQuarterCircle(HDC hdc, int xc, int yc, int R, COLORREF c);
+template <typename Sink> void FillQuarterCircle(Sink& sink, int xc, int yc, int R, COLORREF c);
 
 // 3. Fill circle with solid pixels (no gaps)
-void FillCircleWithCircles(HDC hdc, int xc, int yc, int R, COLORREF c);
+template <typename Sink> void FillCircleWithCircles(Sink& sink, int xc, int yc, int R, COLORREF c);
 
 // Helper function to fill one octal with lines
-void FillOctalWithLines(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
+template <typename Sink> void FillOctalWithLines(Sink& sink, int xc, int yc, int x, int y, COLORREF c);
 
 // Helper function to fill using 8-point symmetry with lines
+template <typename Sink> void FillWithSymmetricLines(Sink& sink, int xc, int yc, int x, int y, COLORREF c);
+
+#ifdef GFX_WITH_GDI
+// GDI wrappers
+void FillCircleWithLines(HDC hdc, int xc, int yc, int R, COLORREF c);
+void FillQuarterCircle(HDC hdc, int xc, int yc, int R, COLORREF c);
+void FillCircleWithCircles(HDC hdc, int xc, int yc, int R, COLORREF c);
+void FillOctalWithLines(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
 void FillWithSymmetricLines(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
+#endif
 
-#endif // CIRCLE_FILL_ALGORITHMS_H 
\ No newline at end of file
+#endif // CIRCLE_FILL_ALGORITHMS_H 
@@ -1,5 +1,7 @@
 #pragma once
 #include <vector>
+#include "FrameArena.h"
+#include "GraphicsTypes.h"
 
 // Simple Point struct (adapt as needed)
 struct Point2 {
@@ -18,6 +20,11 @@ bool CohenSutherlandLineClip(int& x1, int& y1, int& x2, int& y2, int xLeft, int
 // Rectangle Polygon Clipping (Sutherland-Hodgman)
 std::vector<Point2> SutherlandHodgmanPolygonClip(const std::vector<Point2>& polygon, int xLeft, int xRight, int yTop, int yBottom);
 
+// The same without allocating: the clipped polygon is taken from 'arena'
+// and lives until the arena is rewound past it
+ArrayView<Point2> SutherlandHodgmanPolygonClip(ArrayView<Point2> polygon, int xLeft, int xRight, int yTop, int yBottom,
+                                               FrameArena& arena);
+
 // Square Point Clipping (wrapper)
 bool ClipPointSquare(int x, int y, int xLeft, int size);
 
@@ -0,0 +1,35 @@
+#ifndef COLOR_H
+#define COLOR_H
+
+// GDI bindings (GdiSink, HDC overloads, DIB-backed framebuffer) are only
+// built when GFX_WITH_GDI is defined, which CMake does for -DGFX_WITH_GDI=ON.
+#if defined(GFX_WITH_GDI) && !defined(_WIN32)
+#error "GFX_WITH_GDI needs Windows"
+#endif
+
+#ifdef GFX_WITH_GDI
+#include <windows.h>
+#else
+#include <cstdint>
+
+// Win32-compatible color type so the algorithms build without <windows.h>.
+// Layout matches COLORREF: 0x00BBGGRR.
+#ifdef _WIN32
+typedef unsigned long COLORREF;  // Same type as the SDK's DWORD-based typedef
+#else
+typedef std::uint32_t COLORREF;
+#endif
+
+#ifndef RGB
+#define RGB(r, g, b) ((COLORREF)(((std::uint8_t)(r)) | ((COLORREF)((std::uint8_t)(g)) << 8) | ((COLORREF)((std::uint8_t)(b)) << 16)))
+#define GetRValue(c) ((std::uint8_t)(c))
+#define GetGValue(c) ((std::uint8_t)((c) >> 8))
+#define GetBValue(c) ((std::uint8_t)((c) >> 16))
+#endif
+
+#ifndef CLR_INVALID
+#define CLR_INVALID 0xFFFFFFFF
+#endif
+#endif
+
+#endif // COLOR_H
@@ -0,0 +1,74 @@
+#ifndef CURVE_TESSELLATOR_H
+#define CURVE_TESSELLATOR_H
+
+#include <cstdint>
+#include <vector>
+#include "PixelSink.h"
+#include "Bezier.h"
+#include "Hermite.h"
+
+// ========================================
+// ADAPTIVE CURVE TESSELLATION
+// ========================================
+//
+// Curves are flattened by recursive midpoint subdivision until the control
+// polygon lies within 'tolerance' pixels of its chord, then the resulting
+// polyline is rasterized with Bresenham segments that share their joints.
+// A split costs O(n^2) in the control points, so Beziers with more than a
+// dozen are instead halved in t until the curve's midpoint is within
+// 'tolerance' of the chord, each point evaluated from its Bernstein
+// weights in O(sqrt(n)) (BernsteinBasis::EvaluateAt).
+// The number of evaluations follows the curvature and every pixel along
+// the curve is written about once, with no gaps on long curves.
+
+// Default flatness tolerance in pixels
+const double DEFAULT_CURVE_TOLERANCE = 0.25;
+
+// Work counters; pass the same object to several calls to accumulate
+struct CurveStats {
+    std::uint64_t evaluations = 0;  // Subdivisions (one curve point each)
+    std::uint64_t segments = 0;     // Line segments rasterized
+    std::uint64_t pixels = 0;       // Pixels written
+
+    void Reset() { evaluations = segments = pixels = 0; }
+};
+
+// Append the flattened curve to 'out', excluding its start point pts[0]
+// (so consecutive curves can share joints). Any degree >= 1; 1000 control
+// points take a few milliseconds.
+void FlattenBezier(const BezierPoint pts[], int numPoints, double tolerance,
+                   std::vector<BezierPoint>& out, CurveStats* stats = nullptr);
+
+// Equivalent cubic Bezier control points for a Hermite segment
+void HermiteToBezier(HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1, BezierPoint out[4]);
+
+// Append the flattened cardinal spline through points[0 .. n-1] with
+// tension c, excluding points[0] like FlattenBezier
+void FlattenCardinalSpline(const HermitePoint* points, int n, double c, double tolerance,
+                           std::vector<BezierPoint>& out, CurveStats* stats = nullptr);
+
+// Rasterize a polyline; joints between segments are written once
+template <typename Sink>
+void DrawPolyline(Sink& sink, const BezierPoint pts[], int count, COLORREF color, CurveStats* stats = nullptr);
+
+template <typename Sink>
+void DrawBezierCurveAdaptive(Sink& sink, const BezierPoint pts[], int numPoints, COLORREF color,
+                             double tolerance = DEFAULT_CURVE_TOLERANCE, CurveStats* stats = nullptr);
+
+template <typename Sink>
+void DrawHermiteCurveAdaptive(Sink& sink, HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1,
+                              COLORREF color, double tolerance = DEFAULT_CURVE_TOLERANCE, CurveStats* stats = nullptr);
+
+// Cardinal spline with tension c; all segments form one polyline
+template <typename Sink>
+void DrawCardinalSplineAdaptive(Sink& sink, const HermitePoint* points, int n, double c, COLORREF color,
+                                double tolerance = DEFAULT_CURVE_TOLERANCE, CurveStats* stats = nullptr);
+
+#ifdef GFX_WITH_GDI
+// GDI wrappers
+void DrawBezierCurveAdaptive(HDC hdc, const BezierPoint pts[], int numPoints, COLORREF color);
+void DrawHermiteCurveAdaptive(HDC hdc, HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1, COLORREF color);
+void DrawCardinalSplineAdaptive(HDC hdc, const HermitePoint* points, int n, double c, COLORREF color);
+#endif
+
+#endif // CURVE_TESSELLATOR_H
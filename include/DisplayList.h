@@ -0,0 +1,148 @@
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "GraphicsTypes.h"
+#include "PixelSink.h"
+
+// ========================================
+// PER-SHAPE DISPLAY LISTS
+// ========================================
+//
+// A display list is what RenderShape wrote for one shape, rasterized once:
+// the opaque pixels as horizontal runs and the partially covered pixels of
+// anti-aliased fills as runs of coverage values, both sorted by row and
+// stored as 16-bit offsets from the shape's top left pixel. All of a
+// shape's writes are in its own color and no pixel is written twice, so
+// replaying the runs in row order lands exactly the pixels the algorithms
+// would, without radii, curve sampling, edge setup or scratch arrays.
+// Coverage is blended with what is underneath at replay time, the same way
+// the rasterizer blends it.
+//
+// Shapes whose output depends on the target (circles flood filled from it)
+// and recorded flood fills, which already are runs, are drawn directly.
+
+// Default memory budget of a DisplayListCache
+const std::size_t DEFAULT_DISPLAY_LIST_BUDGET = 64u << 20;
+
+class DisplayList {
+public:
+    // Compile a recording; 'recording' is left unspecified. Returns false
+    // when the pixels span 65536 rows or columns or more.
+    bool Build(DisplayListSink& recording);
+
+    // Draw the list. Rows outside a clipped sink are skipped.
+    template <typename Sink> void Replay(Sink& sink) const;
+
+    // Heap and object memory held by the list
+    std::size_t Bytes() const;
+    std::size_t Pixels() const;
+
+private:
+    // Pixels x1 .. x2 of 'row', relative to m_left and m_top
+    struct Run {
+        std::uint16_t row, x1, x2;
+    };
+
+    // The same, with coverage m_alpha[alpha ...]
+    struct CoverageRun {
+        std::uint16_t row, x1, x2;
+        std::uint32_t alpha;
+    };
+
+    COLORREF m_color = 0;
+    int m_left = 0;
+    int m_top = 0;
+    std::vector<Run> m_runs;
+    std::vector<CoverageRun> m_coverage;
+    std::vector<std::uint8_t> m_alpha;
+};
+
+// Record 'shape' as RenderShape draws it, clipped to 'clip' (the canvas).
+// Thread-safe. Returns false for shapes that must be drawn directly.
+bool RecordDisplayList(const ShapeView& shape, const PixelRect& clip, DisplayList& list);
+
+struct DisplayListStats {
+    std::size_t lists = 0;        // Lists held
+    std::size_t bytes = 0;        // Memory they hold
+    std::size_t budget = 0;       // Most memory they may hold
+    std::uint64_t hits = 0;       // Draws replayed from a held list
+    std::uint64_t misses = 0;     // Lists recorded: first draw, or the shape changed or was evicted
+    std::uint64_t direct = 0;     // Draws without a list (see above, or no room in the budget)
+    std::uint64_t evictions = 0;  // Lists dropped to stay within the budget
+};
+
+// Display lists for the shapes of a scene, by position in it, within a
+// memory budget. A list is recorded the first time its shape is drawn and
+// kept until the shape changes (checked by a hash of the shape on every
+// lookup), the canvas is resized or the list is evicted. When a new list
+// doesn't fit, the least recently used lists not drawn in the current
+// frame are evicted; if that is not enough the shape is drawn directly
+// until it changes, so a scene larger than the budget keeps a stable part
+// of itself cached instead of cycling through it.
+class DisplayListCache {
+public:
+    explicit DisplayListCache(std::size_t budget = DEFAULT_DISPLAY_LIST_BUDGET);
+
+    // Evicts down to the new budget
+    void SetBudget(std::size_t bytes);
+    void Clear();
+
+    // Start drawing a scene of 'shapes' shapes on a width x height canvas.
+    // Lists past the end of the scene, or all of them when the canvas size
+    // changed, are dropped.
+    void BeginFrame(std::size_t shapes, int width, int height);
+
+    // Held list for shape i, or nullptr. Then 'record' says whether to
+    // record one (RecordDisplayList) and Store it, or to draw directly.
+    const DisplayList* Find(std::size_t i, const ShapeView& shape, bool& record);
+
+    // Keep a list recorded for shape i after Find. Takes 'list' over and
+    // returns the held copy if it fits the budget; otherwise returns nullptr,
+    // leaves 'list' alone and draws the shape directly from now on.
+    const DisplayList* Store(std::size_t i, DisplayList& list);
+
+    // Draw shape i directly until it changes (its recording failed)
+    void Reject(std::size_t i);
+
+    // Find, record and Store as needed, then draw shape i. Not thread-safe;
+    // the parallel rebuild calls the pieces itself.
+    template <typename Sink> void Render(Sink& sink, const ShapeView& shape, std::size_t i);
+
+    // The rectangle recordings are clipped to
+    PixelRect Canvas() const { return { 0, 0, m_width - 1, m_height - 1 }; }
+    const DisplayListStats& Stats() const { return m_stats; }
+    void ResetCounters();
+
+private:
+    enum : std::uint8_t { EMPTY, HELD, DIRECT };
+    static const std::uint32_t NONE = 0xFFFFFFFF;
+
+    struct Entry {
+        std::unique_ptr<DisplayList> list;
+        std::uint64_t key = 0;             // ShapeKey of the shape 'state' was decided for
+        std::uint32_t prev = NONE;         // LRU neighbours, most recent first
+        std::uint32_t next = NONE;
+        std::uint32_t frame = 0;           // Last frame the list was drawn in
+        std::uint8_t state = EMPTY;
+    };
+
+    void Link(std::uint32_t i);
+    void Unlink(std::uint32_t i);
+    void Drop(std::uint32_t i);
+    // Evict until 'bytes' more fit; false if lists of this frame are in the way
+    bool MakeRoom(std::size_t bytes);
+
+    std::vector<Entry> m_entries;
+    std::uint32_t m_head = NONE;
+    std::uint32_t m_tail = NONE;
+    std::uint32_t m_frame = 0;
+    int m_width = 0;
+    int m_height = 0;
+    DisplayListStats m_stats;
+};
+
+#endif // DISPLAY_LIST_H
@@ -1,22 +1,36 @@
 #ifndef ELLIPSE_ALGORITHMS_H
 #define ELLIPSE_ALGORITHMS_H
 
-#include <windows.h>
+#include "PixelSink.h"
 
 #ifndef PI
 #define PI 3.14159265359
 #endif
 
 // Helper function to draw ellipse points in all four quadrants
-void DrawEllipsePoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
+template <typename Sink>
+inline void DrawEllipsePoint(Sink& sink, int xc, int yc, int x, int y, COLORREF c) {
+    sink.Plot(xc+x, yc+y, c);
+    sink.Plot(xc-x, yc+y, c);
+    sink.Plot(xc-x, yc-y, c);
+    sink.Plot(xc+x, yc-y, c);
+}
 
 // Ellipse Direct Algorithm
-void DrawDirectEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c);
+template <typename Sink> void DrawDirectEllipse(Sink& sink, int xc, int yc, int a, int b, COLORREF c);
 
 // Ellipse Polar Algorithm
-void DrawPolarEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c);
+template <typename Sink> void DrawPolarEllipse(Sink& sink, int xc, int yc, int a, int b, COLORREF c);
 
 // Ellipse Midpoint Algorithm (Bresenham)
+template <typename Sink> void DrawEllipseBresenham(Sink& sink, int xc, int yc, int a, int b, COLORREF c);
+
+#ifdef GFX_WITH_GDI
+// GDI wrappers
+void DrawEllipsePoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
+void DrawDirectEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c);
+void DrawPolarEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c);
 void DrawEllipseBresenham(HDC hdc, int xc, int yc, int a, int b, COLORREF c);
+#endif
 
-#endif // ELLIPSE_ALGORITHMS_H 
\ No newline at end of file
+#endif // ELLIPSE_ALGORITHMS_H 
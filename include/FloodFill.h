@@ -1,11 +1,38 @@
 #ifndef FLOODFILL_H
 #define FLOODFILL_H
 
-#include <windows.h>
+#include <cstddef>
+#include <vector>
+#include "GraphicsTypes.h"
+#include "PixelSink.h"
 
+// Flood fills read the target back, so they are instantiated for the
+// readable sinks only (see FOR_EACH_READABLE_SINK)
+template <typename Sink> void FloodFillRecursive(Sink& sink, int x, int y, COLORREF fillColor, COLORREF originalColor);
+
+template <typename Sink> void FloodFillNonRecursive(Sink& sink, int x, int y, COLORREF fillColor, COLORREF originalColor);
+
+// Scanline (span) flood fill directly on 32-bit pixel memory. Seeds whole
+// runs instead of pixels, tracks visited pixels in a bitset (one bit per
+// pixel) and writes each run with a single row fill. Same 4-connected
+// region as the fills above, with no recursion and memory bounded by the
+// bitset plus the run stack. Returns the number of pixels filled and, if
+// 'spans' is given, appends the filled runs to it (in no particular order).
+std::size_t FloodFillScanline(BgraSink& sink, int x, int y, COLORREF fillColor, COLORREF originalColor,
+                              std::vector<FillSpan>* spans = nullptr);
+std::size_t FloodFillScanline(Framebuffer& framebuffer, int x, int y, COLORREF fillColor, COLORREF originalColor,
+                              std::vector<FillSpan>* spans = nullptr);
+
+// Sort spans by row and x and join the ones that touch, so a recorded fill
+// is stored with as few runs as possible
+void NormalizeSpans(std::vector<FillSpan>& spans);
+
+#ifdef GFX_WITH_GDI
+// GDI wrappers
 void FloodFillRecursive(HDC hdc, int x, int y, COLORREF fillColor, COLORREF originalColor);
 
 void FloodFillNonRecursive(HDC hdc, int x, int y, COLORREF fillColor, COLORREF originalColor);
+#endif
 
 struct FloodPoint {
     int x, y;
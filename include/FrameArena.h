@@ -0,0 +1,122 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// ========================================
+// PER-FRAME SCRATCH ARENA
+// ========================================
+//
+// Bump allocator for the fixed-size temporaries a shape needs while it is
+// drawn: split control points, spline tangents, batched curve segments,
+// clip rings. Allocating moves a pointer; memory is handed back in bulk,
+// to a mark when a draw finishes (ArenaScope) or all at once by Reset()
+// between rebuilds. Blocks are kept, and a Reset() that finds the arena
+// spread over several blocks swaps them for one block as large as all of
+// them, so once the first rebuilds have sized it the arena stops touching
+// the heap.
+//
+// Nothing handed out is constructed or destroyed, so only trivial types
+// are allowed. Growable outputs (a flattened polyline, a triangulation)
+// stay in thread_local vectors, which reach their size just as quickly.
+
+struct FrameArenaStats {
+    std::uint64_t heapAllocations = 0;  // Blocks taken from the heap, ever
+    std::size_t capacity = 0;           // Bytes held in blocks
+    std::size_t used = 0;               // Bytes handed out now
+    std::size_t peak = 0;               // Most bytes handed out at once since Reset()
+};
+
+class FrameArena {
+public:
+    // Size of the first block
+    static const std::size_t DEFAULT_BLOCK = 64u << 10;
+
+    explicit FrameArena(std::size_t blockSize = DEFAULT_BLOCK) : m_blockSize(blockSize) {}
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Uninitialized room for 'count' T, valid until the arena is rewound
+    // past it or reset
+    template <typename T>
+    T* Allocate(std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                      "FrameArena never runs constructors or destructors");
+        return static_cast<T*>(AllocateBytes(count * sizeof(T), alignof(T)));
+    }
+
+    struct Mark {
+        std::size_t block;
+        std::size_t offset;
+        std::size_t used;
+    };
+
+    // Where the arena is now; Rewind() hands back everything allocated since
+    Mark Position() const { return { m_block, m_offset, m_stats.used }; }
+    void Rewind(const Mark& mark);
+
+    // Hand back everything. Call only when nothing from the arena is in use.
+    void Reset();
+
+    const FrameArenaStats& Stats() const { return m_stats; }
+
+    // Blocks all arenas have taken from the heap, ever
+    static std::uint64_t TotalHeapAllocations();
+
+private:
+    struct Block {
+        unsigned char* data;
+        std::size_t size;
+    };
+
+    void* AllocateBytes(std::size_t bytes, std::size_t align);
+    void* AllocateSlow(std::size_t bytes, std::size_t align);
+    void AddBlock(std::size_t size);
+
+    std::size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    std::size_t m_block = 0;   // Block being carved
+    std::size_t m_offset = 0;  // First free byte in it
+    FrameArenaStats m_stats;
+};
+
+inline void* FrameArena::AllocateBytes(std::size_t bytes, std::size_t align) {
+    if (m_block < m_blocks.size()) {
+        const Block& block = m_blocks[m_block];
+        std::size_t start = (m_offset + align - 1) & ~(align - 1);
+        if (start <= block.size && bytes <= block.size - start) {
+            m_stats.used += start + bytes - m_offset;
+            if (m_stats.used > m_stats.peak) m_stats.peak = m_stats.used;
+            m_offset = start + bytes;
+            return block.data + start;
+        }
+    }
+    return AllocateSlow(bytes, align);
+}
+
+// The calling thread's arena, which the drawing code takes its scratch
+// from. TiledRebuilder resets the arenas of the threads it renders on.
+FrameArena& ThreadArena();
+
+// Rewinds an arena to where it was when the scope began
+class ArenaScope {
+public:
+    explicit ArenaScope(FrameArena& arena = ThreadArena()) : m_arena(arena), m_mark(arena.Position()) {}
+    ~ArenaScope() { m_arena.Rewind(m_mark); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    FrameArena& Arena() const { return m_arena; }
+
+private:
+    FrameArena& m_arena;
+    FrameArena::Mark m_mark;
+};
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,120 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Color.h"
+
+// 32-bit top-down pixel buffer that owns its memory.
+// On Windows the memory is a DIB section so it can be selected into a
+// memory DC and presented with a single BitBlt; elsewhere it is plain heap
+// memory. Pixels are stored in DIB order (0x00RRGGBB), which differs from
+// COLORREF (0x00BBGGRR), so colors are converted on the way in and out.
+//
+// Changes are tracked per TILE_SIZE x TILE_SIZE tile so a window can present
+// only what changed. The pixels themselves stay one row-major block (it has
+// to be a single DIB for BitBlt); tiles are only the granularity of change.
+class Framebuffer {
+public:
+    static const int TILE_SHIFT = 6;
+    static const int TILE_SIZE = 1 << TILE_SHIFT;
+
+    // Per-tile flag. A distinct type rather than a char, so that marking a
+    // tile doesn't make the compiler assume the pixels and everything else
+    // in memory may have changed.
+    enum TileState : std::uint8_t { TILE_CLEAN, TILE_DIRTY };
+
+    // Pixel rectangle covering one or more dirty tiles, clipped to the buffer
+    struct DirtyRect {
+        int x, y, width, height;
+    };
+
+    Framebuffer();
+    ~Framebuffer();
+
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+
+    // Allocate (or reallocate) the pixel storage. Contents are undefined
+    // until Clear() is called.
+    bool Create(int width, int height);
+    void Release();
+
+    void Clear(COLORREF color);
+
+    // Modification counter for caches derived from the pixels. Create() and
+    // Clear() bump it; code writing through Pixels() or a sink calls
+    // MarkModified() when it is done.
+    std::uint64_t Version() const { return m_version; }
+    void MarkModified() { m_version++; }
+
+    // Dirty tiles. Create() and Clear() dirty everything; BgraSink marks
+    // the tiles it writes, and code writing through Pixels() or Row() calls
+    // MarkDirty itself.
+    void MarkDirty(int x1, int y1, int x2, int y2);  // Inclusive, clipped
+    void MarkAllDirty();
+    bool HasDirtyTiles() const;
+    int TilesX() const { return m_tilesX; }
+    int TilesY() const { return m_tilesY; }
+    TileState* DirtyTiles() { return m_dirtyTiles.data(); }
+
+    // Coalesce the dirty tiles into few rectangles (runs of tiles in a row,
+    // merged down the rows while they line up) and mark them clean.
+    // Returns the number of dirty tiles.
+    std::size_t TakeDirtyRects(std::vector<DirtyRect>& rects);
+
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+    bool IsValid() const { return m_pixels != nullptr; }
+
+    std::uint32_t* Pixels() { return m_pixels; }
+    const std::uint32_t* Pixels() const { return m_pixels; }
+    std::uint32_t* Row(int y) { return m_pixels + (std::size_t)y * m_width; }
+    const std::uint32_t* Row(int y) const { return m_pixels + (std::size_t)y * m_width; }
+
+    // Native bitmap handle (HBITMAP) with GDI support, nullptr otherwise.
+    void* NativeBitmap() const { return m_bitmap; }
+
+    bool Contains(int x, int y) const {
+        return (unsigned)x < (unsigned)m_width && (unsigned)y < (unsigned)m_height;
+    }
+
+    // Raw store; writes outside the buffer are dropped like GDI does.
+    void SetPixel(int x, int y, COLORREF c) {
+        if (Contains(x, y)) {
+            m_pixels[(std::size_t)y * m_width + x] = ToPixel(c);
+        }
+    }
+
+    // Returns CLR_INVALID outside the buffer, matching GetPixel on an HDC.
+    COLORREF GetPixel(int x, int y) const {
+        if (!Contains(x, y)) return CLR_INVALID;
+        return FromPixel(m_pixels[(std::size_t)y * m_width + x]);
+    }
+
+    // Fill the inclusive range [x1, x2] of row y, clipped to the buffer.
+    void FillSpan(int x1, int x2, int y, COLORREF c);
+
+    static std::uint32_t ToPixel(COLORREF c) {
+        return ((c & 0xFF) << 16) | (c & 0xFF00) | ((c >> 16) & 0xFF);
+    }
+
+    static COLORREF FromPixel(std::uint32_t p) {
+        return ((p & 0xFF) << 16) | (p & 0xFF00) | ((p >> 16) & 0xFF);
+    }
+
+private:
+    std::uint32_t* m_pixels;
+    void* m_bitmap;
+    int m_width;
+    int m_height;
+    std::uint64_t m_version;
+
+    // One flag per tile, row-major
+    std::vector<TileState> m_dirtyTiles;
+    int m_tilesX;
+    int m_tilesY;
+};
+
+#endif // FRAMEBUFFER_H
@@ -1,8 +1,9 @@
 #ifndef GRAPHICS_TYPES_H
 #define GRAPHICS_TYPES_H
 
+#include <cstddef>
 #include <vector>
-#include <windows.h>
+#include "Color.h"
 #include "Point.h"
 
 // ========================================
@@ -66,6 +67,9 @@ enum MenuID {
     MENU_FILL_FLOOD_NONRECURSIVE,
     MENU_FILL_SQUARE_HERMITE,
     MENU_FILL_RECTANGLE_BEZIER,
+    MENU_FILL_FLOOD_PARALLEL,
+    MENU_FILL_ANTIALIASED_EVEN_ODD,
+    MENU_FILL_ANTIALIASED_NON_ZERO,
     
     // Tools
     MENU_TOOLS_CLEAR = 5001,
@@ -95,7 +99,8 @@ enum class DrawingMode {
     CURVE_CARDINAL,
     CURVE_BEZIER,
     CURVE_HERMITE,
-    NONE
+    NONE,
+    FLOOD_FILL      // Recorded flood fill (spans); after NONE so saved values stay stable
 };
 
 // Fill modes
@@ -114,7 +119,15 @@ enum class FillMode {
     FLOOD_FILL_RECURSIVE_POLYGON,
     FLOOD_FILL_NONRECURSIVE_POLYGON,
     SQUARE_FILL_HERMITE_VERTICAL,
-    RECTANGLE_FILL_BEZIER_HORIZONTAL
+    RECTANGLE_FILL_BEZIER_HORIZONTAL,
+    FLOOD_FILL_PARALLEL_POLYGON,
+    ANTIALIASED_EVEN_ODD,
+    ANTIALIASED_NON_ZERO
+};
+
+// Inclusive horizontal run [x1, x2] of row y
+struct FillSpan {
+    int y, x1, x2;
 };
 
 // Shape data structure for saving/loading
@@ -124,6 +137,56 @@ struct Shape {
     FillMode fillMode;
     std::vector<Point> points;
     int thickness;
+    std::vector<FillSpan> spans;  // FLOOD_FILL only: the filled region, sorted by row
+};
+
+// Read-only run of elements owned elsewhere; indexes and iterates like the
+// std::vector it stands in for
+template <typename T>
+class ArrayView {
+public:
+    ArrayView() : m_data(nullptr), m_size(0) {}
+    ArrayView(const T* data, std::size_t size) : m_data(data), m_size(size) {}
+    ArrayView(const std::vector<T>& vector) : m_data(vector.data()), m_size(vector.size()) {}
+
+    const T& operator[](std::size_t i) const { return m_data[i]; }
+    const T* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+    const T& back() const { return m_data[m_size - 1]; }
+
+private:
+    const T* m_data;
+    std::size_t m_size;
+};
+
+// What a shape is drawn with, derived from its points (GetShapeGeometry):
+// circles and squares: points[0] and the radius or half size, truncated
+// as drawn, in rx and ry; ellipses and rectangles: points[0] and the half
+// extents |points[1] - points[0]|. Zero for other shapes.
+struct ShapeGeometry {
+    Point center;
+    int rx = 0;
+    int ry = 0;
+};
+
+// One shape as the renderers read it, from a Shape or a row of a Scene
+struct ShapeView {
+    DrawingMode mode = DrawingMode::NONE;
+    COLORREF color = 0;
+    FillMode fillMode = FillMode::NONE;
+    int thickness = 1;
+    ArrayView<Point> points;
+    ArrayView<FillSpan> spans;
+    // Precomputed by a Scene; renderers derive it when null
+    const ShapeGeometry* geometry = nullptr;
+
+    ShapeView() = default;
+    ShapeView(const Shape& shape)
+        : mode(shape.mode), color(shape.color), fillMode(shape.fillMode), thickness(shape.thickness)
+        , points(shape.points), spans(shape.spans) {}
 };
 
 #endif // GRAPHICS_TYPES_H
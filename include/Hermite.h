@@ -1,17 +1,38 @@
 #ifndef HERMITE_ALGORITHMS_H
 #define HERMITE_ALGORITHMS_H
 
-#include <windows.h>
+#include "PixelSink.h"
 
 struct HermitePoint {
     double x, y;
     HermitePoint(double x = 0, double y = 0) : x(x), y(y) {}
 };
 
+// One cubic Hermite segment: endpoints P0, P1 and tangents T0, T1
+struct HermiteSegment {
+    HermitePoint P0, T0, P1, T1;
+};
+
+template <typename Sink>
+void DrawHermiteCurve(Sink& sink, HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1, int numpoints, COLORREF color);
+
+// Batched evaluation: segment i is sampled samples[i] times at
+// t = k / (samples[i] - 1) and each sample is plotted. All segments run
+// through one forward-differencing kernel (three adds per coordinate per
+// sample). With fixedPoint the differences are kept in 64-bit integers with
+// 40 fractional bits; segments whose coordinates fall outside +-2^21 use
+// the double kernel instead.
+template <typename Sink>
+void DrawHermiteSegments(Sink& sink, const HermiteSegment segments[], const int samples[], int numSegments,
+                         COLORREF color, bool fixedPoint = false);
+
+#ifdef GFX_WITH_GDI
+// GDI wrapper
 void DrawHermiteCurve(HDC hdc, HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1, int numpoints, COLORREF color);
+#endif
 
 void GetHermiteCoeff(double p0, double t0, double p1, double t1, double* coeffs);
 
 double EvaluatePolynomial(double* coeffs, double t);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,15 @@
+#ifndef IMAGE_WRITER_H
+#define IMAGE_WRITER_H
+
+#include <string>
+#include "Framebuffer.h"
+
+// Write the framebuffer as a binary PPM (P6, 8-bit RGB)
+bool WritePPM(const std::string& path, const Framebuffer& framebuffer);
+
+// Write the framebuffer as a 24-bit RGB PNG. Self-contained encoder: image
+// data is stored in uncompressed deflate blocks, so files are about the size
+// of a PPM but open in any viewer.
+bool WritePNG(const std::string& path, const Framebuffer& framebuffer);
+
+#endif // IMAGE_WRITER_H
@@ -1,13 +1,22 @@
 #ifndef LINE_ALGORITHMS_H
 #define LINE_ALGORITHMS_H
 
-#include <windows.h>
+#include "PixelSink.h"
 
 // Line drawing algorithm declarations
+template <typename Sink> void DrawLineDDA(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c);
+template <typename Sink> void DrawLineBresenham(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c);
+template <typename Sink> void DrawLineParametric(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c);
+template <typename Sink> void DrawHorizontalLine(Sink& sink, int x1, int x2, int y, COLORREF c);
+template <typename Sink> void drawLineBresenhamPolygon(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c);
+
+#ifdef GFX_WITH_GDI
+// GDI wrappers
 void DrawLineDDA(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c);
 void DrawLineBresenham(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c);
 void DrawLineParametric(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c);
 void DrawHorizontalLine(HDC hdc, int x1, int x2, int y, COLORREF c);
 void drawLineBresenhamPolygon(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c);
+#endif
 
-#endif // LINE_ALGORITHMS_H 
\ No newline at end of file
+#endif // LINE_ALGORITHMS_H 
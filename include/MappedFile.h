@@ -0,0 +1,40 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// ========================================
+// READ-ONLY MAPPED FILE
+// ========================================
+//
+// A whole file in memory, mapped (mmap, or a file mapping on Windows) so
+// pages are read on first touch and shared with the OS file cache. Where
+// the platform can't map (a Windows build without <windows.h>), the file
+// is read into memory instead; either way Data() is page aligned or
+// aligned for any fundamental type.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // False if the file can't be opened or read
+    bool Open(const std::string& path);
+    void Close();
+
+    const char* Data() const { return m_data; }
+    std::size_t Size() const { return m_size; }
+    bool IsMapped() const { return m_mapped; }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_mapped = false;
+    std::vector<char> m_copy;   // Contents when not mapped
+};
+
+#endif // MAPPED_FILE_H
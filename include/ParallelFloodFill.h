@@ -0,0 +1,71 @@
+#ifndef PARALLEL_FLOOD_FILL_H
+#define PARALLEL_FLOOD_FILL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Framebuffer.h"
+#include "GraphicsTypes.h"
+
+// ========================================
+// PARALLEL FLOOD FILL (CONNECTED-COMPONENT LABELING)
+// ========================================
+//
+// Labels every 4-connected region of equal color in a framebuffer, then
+// answers flood fills by recoloring the seed's region. Labeling splits the
+// rows into one strip per thread: each strip breaks its rows into runs and
+// unions vertically overlapping runs of the same color, then the strip
+// borders are merged. Regions are kept as union-find sets over the runs,
+// with a circular list through each set so its runs can be enumerated.
+//
+// The labels stay valid until the framebuffer's Version() changes. A fill
+// updates them in place (the region takes the new color and merges with
+// touching regions of that color), so repeated fills on an unchanged
+// drawing skip the labeling pass entirely.
+class FloodFillLabels {
+public:
+    // threads <= 0 uses every hardware thread
+    explicit FloodFillLabels(int threads = 0);
+
+    // Label 'framebuffer' from scratch
+    void Build(const Framebuffer& framebuffer);
+
+    // Flood fill the region containing (x, y) with 'fillColor', labeling
+    // first if the cached labels are stale. Returns the pixels filled and,
+    // if 'spans' is given, appends the filled runs to it.
+    std::size_t Fill(Framebuffer& framebuffer, int x, int y, COLORREF fillColor,
+                     std::vector<FillSpan>* spans = nullptr);
+
+    bool IsCurrent(const Framebuffer& framebuffer) const;
+    void Invalidate() { m_source = nullptr; }
+
+    std::size_t RunCount() const { return m_runs.size(); }
+    int Threads() const { return m_threads; }
+
+private:
+    // Maximal horizontal run of one color
+    struct Run {
+        int x1, x2, y;
+        std::uint32_t pixel;
+    };
+
+    std::uint32_t Find(std::uint32_t i);
+    void Union(std::uint32_t a, std::uint32_t b);
+    void UnionRows(int upper, int lower);
+    std::uint32_t RunAt(int x, int y) const;
+    void MergeNeighbors(const std::vector<std::uint32_t>& members);
+
+    int m_threads;
+    int m_width = 0;
+    int m_height = 0;
+    const Framebuffer* m_source = nullptr;
+    std::uint64_t m_version = 0;
+
+    std::vector<Run> m_runs;
+    std::vector<std::uint32_t> m_rowStart;  // Runs of row y: [m_rowStart[y], m_rowStart[y + 1])
+    std::vector<std::uint32_t> m_parent;    // Union-find forest over runs
+    std::vector<std::uint32_t> m_next;      // Circular list of each set's runs
+    std::vector<std::uint32_t> m_members;   // Scratch for Fill
+};
+
+#endif // PARALLEL_FLOOD_FILL_H
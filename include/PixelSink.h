@@ -0,0 +1,347 @@
+#ifndef PIXEL_SINK_H
+#define PIXEL_SINK_H
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include "Color.h"
+#include "Framebuffer.h"
+
+// ========================================
+// PIXEL SINKS
+// ========================================
+//
+// The rasterizers are templates over a sink type so the per-pixel write is
+// resolved at compile time and inlined. A sink provides:
+//
+//   void Plot(int x, int y, COLORREF c);            // single pixel
+//   void Span(int x1, int x2, int y, COLORREF c);   // inclusive run, x1 <= x2
+//
+// Sinks that can be read back (needed by the flood fills) also provide:
+//
+//   COLORREF Read(int x, int y) const;              // CLR_INVALID when outside
+//
+// Sinks that record partially covered pixels instead of blending them
+// (the anti-aliased fills) provide:
+//
+//   void Blend(int x, int y, COLORREF c, int alpha); // 0 < alpha < 255
+//
+// and sinks that only keep part of the plane provide:
+//
+//   const PixelRect& Clip() const;                  // rasterizers may skip the rest
+//
+// The algorithm translation units explicitly instantiate every rasterizer
+// for the sinks listed in FOR_EACH_PIXEL_SINK below.
+
+// Inclusive pixel rectangle
+struct PixelRect {
+    int left, top, right, bottom;
+
+    bool IsEmpty() const { return left > right || top > bottom; }
+};
+
+// Whether a BgraSink on a Framebuffer marks the tiles it writes dirty.
+// Marking costs a store per plotted pixel; writes that follow a Clear()
+// (which dirties everything) can skip it.
+enum class DirtyTracking {
+    ON,
+    OFF
+};
+
+// Raw 32-bit BGRA memory (0x00RRGGBB per pixel), e.g. a Framebuffer or a DIB.
+// Built on a Framebuffer it also marks the tiles it writes dirty; code that
+// writes through Row() calls MarkDirty for what it wrote.
+//
+// Plot, Span and Read are clipped to a rectangle, the whole buffer unless
+// one is given; the parallel rebuild gives each worker its tile so workers
+// never touch each other's pixels. Width() and Height() stay the buffer's.
+class BgraSink {
+public:
+    BgraSink(std::uint32_t* pixels, int width, int height, int stride)
+        : m_pixels(pixels), m_width(width), m_height(height), m_stride(stride)
+        , m_dirtyTiles(nullptr), m_tilesX(0) {
+        SetClip({ 0, 0, width - 1, height - 1 });
+    }
+
+    explicit BgraSink(Framebuffer& framebuffer, DirtyTracking tracking = DirtyTracking::ON)
+        : BgraSink(framebuffer, { 0, 0, framebuffer.Width() - 1, framebuffer.Height() - 1 }, tracking) {}
+
+    // 'clip' must lie within the framebuffer
+    BgraSink(Framebuffer& framebuffer, const PixelRect& clip, DirtyTracking tracking = DirtyTracking::ON)
+        : m_pixels(framebuffer.Pixels())
+        , m_width(framebuffer.Width())
+        , m_height(framebuffer.Height())
+        , m_stride(framebuffer.Width())
+        , m_dirtyTiles(tracking == DirtyTracking::ON ? framebuffer.DirtyTiles() : nullptr)
+        , m_tilesX(framebuffer.TilesX()) {
+        SetClip(clip);
+    }
+
+    void Plot(int x, int y, COLORREF c) {
+        if ((unsigned)(x - m_clip.left) < (unsigned)m_clipWidth && (unsigned)(y - m_clip.top) < (unsigned)m_clipHeight) {
+            m_pixels[(std::size_t)y * m_stride + x] = Framebuffer::ToPixel(c);
+            if (m_dirtyTiles) {
+                m_dirtyTiles[(std::size_t)(y >> Framebuffer::TILE_SHIFT) * m_tilesX + (x >> Framebuffer::TILE_SHIFT)] =
+                    Framebuffer::TILE_DIRTY;
+            }
+        }
+    }
+
+    void Span(int x1, int x2, int y, COLORREF c) {
+        if ((unsigned)(y - m_clip.top) >= (unsigned)m_clipHeight) return;
+        x1 = std::max(x1, m_clip.left);
+        x2 = std::min(x2, m_clip.right);
+        if (x1 > x2) return;
+        std::uint32_t* row = m_pixels + (std::size_t)y * m_stride;
+        std::fill(row + x1, row + x2 + 1, Framebuffer::ToPixel(c));
+        MarkDirty(x1, x2, y);
+    }
+
+    // Record a write of [x1, x2] on row y, already clipped to the sink
+    void MarkDirty(int x1, int x2, int y) {
+        if (!m_dirtyTiles) return;
+        Framebuffer::TileState* tiles = m_dirtyTiles + (std::size_t)(y >> Framebuffer::TILE_SHIFT) * m_tilesX;
+        for (int tx = x1 >> Framebuffer::TILE_SHIFT; tx <= x2 >> Framebuffer::TILE_SHIFT; tx++) tiles[tx] = Framebuffer::TILE_DIRTY;
+    }
+
+    COLORREF Read(int x, int y) const {
+        if ((unsigned)(x - m_clip.left) >= (unsigned)m_clipWidth || (unsigned)(y - m_clip.top) >= (unsigned)m_clipHeight) {
+            return CLR_INVALID;
+        }
+        return Framebuffer::FromPixel(m_pixels[(std::size_t)y * m_stride + x]);
+    }
+
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+    int Stride() const { return m_stride; }
+    const PixelRect& Clip() const { return m_clip; }
+    std::uint32_t* Row(int y) const { return m_pixels + (std::size_t)y * m_stride; }
+
+private:
+    void SetClip(const PixelRect& clip) {
+        m_clip = clip;
+        m_clipWidth = std::max(clip.right - clip.left + 1, 0);
+        m_clipHeight = std::max(clip.bottom - clip.top + 1, 0);
+    }
+
+    std::uint32_t* m_pixels;
+    int m_width;
+    int m_height;
+    int m_stride;
+    Framebuffer::TileState* m_dirtyTiles;
+    int m_tilesX;
+    PixelRect m_clip;
+    int m_clipWidth;
+    int m_clipHeight;
+};
+
+// Horizontal run of one color, inclusive on both ends
+struct PixelSpan {
+    int y, x1, x2;
+    COLORREF color;
+};
+
+// Records output as horizontal spans instead of writing pixels. Consecutive
+// plots on the same row with the same color are merged into one span.
+class SpanSink {
+public:
+    void Plot(int x, int y, COLORREF c) {
+        if (!m_spans.empty()) {
+            PixelSpan& last = m_spans.back();
+            if (last.y == y && last.color == c && last.x2 + 1 == x) {
+                last.x2 = x;
+                return;
+            }
+        }
+        m_spans.push_back({y, x, x, c});
+    }
+
+    void Span(int x1, int x2, int y, COLORREF c) {
+        m_spans.push_back({y, x1, x2, c});
+    }
+
+    // Write the recorded spans into another sink in recording order
+    template <typename Sink>
+    void Replay(Sink& sink) const {
+        for (const PixelSpan& span : m_spans) {
+            if (span.x1 == span.x2) {
+                sink.Plot(span.x1, span.y, span.color);
+            } else {
+                sink.Span(span.x1, span.x2, span.y, span.color);
+            }
+        }
+    }
+
+    const std::vector<PixelSpan>& Spans() const { return m_spans; }
+    void Clear() { m_spans.clear(); }
+
+private:
+    std::vector<PixelSpan> m_spans;
+};
+
+// Opaque run and partially covered pixel as recorded by a DisplayListSink
+struct RecordedSpan {
+    int y, x1, x2;
+};
+
+struct RecordedCoverage {
+    int y, x, alpha;
+};
+
+// Records one shape's output, clipped to a rectangle, for a display list
+// (DisplayList.h): opaque runs and partially covered pixels with their
+// coverage. Every write must be in the color given; Mixed() reports one
+// that wasn't, and the recording then can't stand in for the shape.
+class DisplayListSink {
+public:
+    void Reset(const PixelRect& clip, COLORREF color) {
+        m_clip = clip;
+        m_color = color;
+        m_mixed = false;
+        m_spans.clear();
+        m_coverage.clear();
+    }
+
+    void Plot(int x, int y, COLORREF c) {
+        if (x < m_clip.left || x > m_clip.right || y < m_clip.top || y > m_clip.bottom) return;
+        if (c != m_color) {
+            m_mixed = true;
+            return;
+        }
+        if (!m_spans.empty()) {
+            RecordedSpan& last = m_spans.back();
+            if (last.y == y && last.x2 + 1 == x) {
+                last.x2 = x;
+                return;
+            }
+        }
+        m_spans.push_back({y, x, x});
+    }
+
+    void Span(int x1, int x2, int y, COLORREF c) {
+        if (y < m_clip.top || y > m_clip.bottom) return;
+        x1 = std::max(x1, m_clip.left);
+        x2 = std::min(x2, m_clip.right);
+        if (x1 > x2) return;
+        if (c != m_color) {
+            m_mixed = true;
+            return;
+        }
+        m_spans.push_back({y, x1, x2});
+    }
+
+    void Blend(int x, int y, COLORREF c, int alpha) {
+        if (x < m_clip.left || x > m_clip.right || y < m_clip.top || y > m_clip.bottom) return;
+        if (c != m_color) {
+            m_mixed = true;
+            return;
+        }
+        m_coverage.push_back({y, x, alpha});
+    }
+
+    const PixelRect& Clip() const { return m_clip; }
+    COLORREF Color() const { return m_color; }
+    bool Mixed() const { return m_mixed; }
+    std::vector<RecordedSpan>& Spans() { return m_spans; }
+    std::vector<RecordedCoverage>& Coverage() { return m_coverage; }
+
+private:
+    PixelRect m_clip = { 0, 0, -1, -1 };
+    COLORREF m_color = 0;
+    bool m_mixed = false;
+    std::vector<RecordedSpan> m_spans;
+    std::vector<RecordedCoverage> m_coverage;
+};
+
+// Discards output and counts writes; useful for measuring algorithm cost
+// without memory traffic and for counting pixels per shape.
+class CountingSink {
+public:
+    void Plot(int, int, COLORREF) { ++m_plots; ++m_pixels; }
+
+    void Span(int x1, int x2, int, COLORREF) {
+        ++m_spans;
+        m_pixels += (std::uint64_t)(x2 - x1 + 1);
+    }
+
+    std::uint64_t Plots() const { return m_plots; }
+    std::uint64_t Spans() const { return m_spans; }
+    std::uint64_t Pixels() const { return m_pixels; }
+    void Reset() { m_plots = m_spans = m_pixels = 0; }
+
+private:
+    std::uint64_t m_plots = 0;
+    std::uint64_t m_spans = 0;
+    std::uint64_t m_pixels = 0;
+};
+
+#ifdef GFX_WITH_GDI
+// Per-pixel SetPixel/GetPixel on a GDI device context (the original path)
+class GdiSink {
+public:
+    explicit GdiSink(HDC hdc) : m_hdc(hdc) {}
+
+    void Plot(int x, int y, COLORREF c) { ::SetPixel(m_hdc, x, y, c); }
+
+    void Span(int x1, int x2, int y, COLORREF c) {
+        for (int x = x1; x <= x2; x++) {
+            ::SetPixel(m_hdc, x, y, c);
+        }
+    }
+
+    COLORREF Read(int x, int y) const { return ::GetPixel(m_hdc, x, y); }
+
+private:
+    HDC m_hdc;
+};
+
+#define FOR_EACH_GDI_SINK(X) X(GdiSink)
+#else
+#define FOR_EACH_GDI_SINK(X)
+#endif
+
+// Sinks every rasterizer is instantiated for
+#define FOR_EACH_PIXEL_SINK(X) \
+    X(BgraSink)                \
+    X(SpanSink)                \
+    X(CountingSink)            \
+    X(DisplayListSink)         \
+    FOR_EACH_GDI_SINK(X)
+
+// Sinks that support Read(), used by algorithms that inspect the target
+#define FOR_EACH_READABLE_SINK(X) \
+    X(BgraSink)                   \
+    FOR_EACH_GDI_SINK(X)
+
+// True when Sink provides Read(x, y), i.e. the flood fills can run on it
+template <typename Sink, typename = void>
+struct SinkCanRead : std::false_type {};
+
+template <typename Sink>
+struct SinkCanRead<Sink, std::void_t<decltype(std::declval<const Sink&>().Read(0, 0))>> : std::true_type {};
+
+// True when Sink provides Blend(x, y, c, alpha)
+template <typename Sink, typename = void>
+struct SinkCanBlend : std::false_type {};
+
+template <typename Sink>
+struct SinkCanBlend<Sink, std::void_t<decltype(std::declval<Sink&>().Blend(0, 0, COLORREF(), 0))>> : std::true_type {};
+
+// True when Sink provides Clip(); writes outside it are dropped
+template <typename Sink, typename = void>
+struct SinkHasClip : std::false_type {};
+
+template <typename Sink>
+struct SinkHasClip<Sink, std::void_t<decltype(std::declval<const Sink&>().Clip())>> : std::true_type {};
+
+// 'c' over 'under' at coverage alpha / 255
+inline COLORREF BlendColor(COLORREF under, COLORREF c, int alpha) {
+    auto mix = [alpha](int a, int b) { return (a * (255 - alpha) + b * alpha + 127) / 255; };
+    return RGB(mix(GetRValue(under), GetRValue(c)),
+               mix(GetGValue(under), GetGValue(c)),
+               mix(GetBValue(under), GetBValue(c)));
+}
+
+#endif // PIXEL_SINK_H
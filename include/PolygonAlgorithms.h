@@ -7,11 +7,20 @@
 
 using namespace std;
 
+template <typename Sink> void DrawPolygon(Sink& sink, const Point* points, int n, COLORREF c);
+
+template <typename Sink> void DrawSquare(Sink& sink, int centerX, int centerY, int halfSize, COLORREF c);
+
+template <typename Sink> void DrawRectangle(Sink& sink, int centerX, int centerY, int vertexX, int vertexY, COLORREF c);
+
+#ifdef GFX_WITH_GDI
+// GDI wrappers
 void DrawPolygon(HDC hdc , vector<Point> points , COLORREF c);
 
 void DrawSquare(HDC hdc, int centerX, int centerY, int halfSize, COLORREF c);
 
 void DrawRectangle(HDC hdc, int centerX, int centerY, int vertexX, int vertexY, COLORREF c);
+#endif
 
 
 #endif //POLYGONALGORITHMS_H
@@ -1,9 +1,9 @@
 #ifndef POLYGON_FILL_ALGORITHMS_H
 #define POLYGON_FILL_ALGORITHMS_H
 
-#include <windows.h>
+#include "PixelSink.h"
 #include <algorithm>
-#include <list>
+#include <cstdint>
 #include <cmath>
 #include "LineAlgorithms.h"
 
@@ -12,27 +12,65 @@ struct PolygonPoint {
     PolygonPoint(double x = 0, double y = 0) : x(x), y(y) {}
 };
 
-struct Edge {
-    int xleft, xright;
-};
-
+// Active edge: x at the current row, x step per row, first row past the edge
 struct Node {
     double x, minv;
     int ymax;
     Node(double x = 0, double minv = 0, int ymax = 0) : x(x), minv(minv), ymax(ymax) {}
 };
 
-typedef Edge EdgeTable[800];
-typedef std::list<Node> LList;
-typedef LList NonConvexEdgeTable[800];
+// Rows at or beyond this are never filled; far past any real canvas, it
+// only bounds the per-row tables for absurd coordinates
+const int MAX_FILL_ROW = 1 << 20;
+
+// How a polygon's rows cross its boundary, as far as filling is concerned
+enum class PolygonClass {
+    CONVEX,    // Convex: one span per row
+    MONOTONE,  // Two y-monotone chains (may cross): still one span per row
+    GENERAL    // Some row crosses more than two edges
+};
+
+// O(n) classification from the edge directions and turns
+PolygonClass ClassifyPolygon(const PolygonPoint p[], int n);
+
+// How many fills FillPolygon sent down each path
+struct PolygonFillStats {
+    std::uint64_t convex = 0;
+    std::uint64_t monotone = 0;
+    std::uint64_t general = 0;
+};
+
+PolygonFillStats GetPolygonFillStats();
+void ResetPolygonFillStats();
+
+// One span per row over the polygon's own rows; exact for CONVEX and
+// MONOTONE polygons
+template <typename Sink> void ConvexFill(Sink& sink, PolygonPoint p[], int n, COLORREF c);
+
+// Even-odd fill of any (self-intersecting) polygon. Edge buckets cover
+// only the polygon's rows, so size and canvas height are unbounded.
+template <typename Sink> void NonConvexFill(Sink& sink, PolygonPoint p[], int n, COLORREF c);
+
+// Classify, then fill with ConvexFill or NonConvexFill, whichever is the
+// cheapest correct one. Same pixels as NonConvexFill.
+template <typename Sink> void FillPolygon(Sink& sink, PolygonPoint p[], int n, COLORREF c);
 
+template <typename Sink> void FillRectangleWithHorizontalBezier(Sink& sink, int centerX, int centerY, int vertexX, int vertexY, COLORREF color);
+
+template <typename Sink> void FillSquareWithVerticalHermite(Sink& sink, int centerX, int centerY, int halfSize, COLORREF color);
+
+#ifdef GFX_WITH_GDI
+// GDI wrappers
 void ConvexFill(HDC hdc, PolygonPoint p[], int n, COLORREF c);
 
 void NonConvexFill(HDC hdc, PolygonPoint p[], int n, COLORREF c);
 
+void FillPolygon(HDC hdc, PolygonPoint p[], int n, COLORREF c);
+
 void FillRectangleWithHorizontalBezier(HDC hdc, int centerX, int centerY, int vertexX, int vertexY, COLORREF color);
 
 void FillSquareWithVerticalHermite(HDC hdc, int centerX, int centerY, int halfSize, COLORREF color);
+#endif
 
 
 
@@ -0,0 +1,209 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include "GraphicsTypes.h"
+#include "PixelSink.h"
+
+// One column of a Scene: its own vector, or a read-only run of memory
+// owned elsewhere (a mapped file) until the first change copies it in
+template <typename T>
+class SceneColumn {
+public:
+    SceneColumn() = default;
+    SceneColumn(std::initializer_list<T> values) : m_owned(values) { Sync(); }
+    SceneColumn(const SceneColumn& other) { *this = other; }
+    SceneColumn(SceneColumn&& other) noexcept { *this = std::move(other); }
+
+    SceneColumn& operator=(const SceneColumn& other) {
+        if (this == &other) return *this;
+        m_owned = other.m_owned;
+        m_borrowed = other.m_borrowed;
+        if (m_borrowed) {
+            m_data = other.m_data;
+            m_size = other.m_size;
+        } else {
+            Sync();
+        }
+        return *this;
+    }
+
+    SceneColumn& operator=(SceneColumn&& other) noexcept {
+        m_owned = std::move(other.m_owned);
+        m_borrowed = other.m_borrowed;
+        m_data = m_borrowed ? other.m_data : m_owned.data();
+        m_size = other.m_size;
+        other.m_owned.clear();
+        other.m_borrowed = false;
+        other.Sync();
+        return *this;
+    }
+
+    const T* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const T& operator[](std::size_t i) const { return m_data[i]; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+    // Heap memory held; nothing while borrowed
+    std::size_t capacity() const { return m_owned.capacity(); }
+
+    T& Mutable(std::size_t i) {
+        Own();
+        return m_owned[i];
+    }
+    void push_back(const T& value) {
+        Own();
+        m_owned.push_back(value);
+        Sync();
+    }
+    template <typename It>
+    void append(It first, It last) {
+        Own();
+        m_owned.insert(m_owned.end(), first, last);
+        Sync();
+    }
+    void assign(std::size_t count, const T& value) {
+        m_borrowed = false;
+        m_owned.assign(count, value);
+        Sync();
+    }
+    void clear() { assign(0, T()); }
+    void reserve(std::size_t count) {
+        Own();
+        m_owned.reserve(count);
+        Sync();
+    }
+
+    // Use 'count' values at 'data' in place, giving up the vector
+    void Borrow(const T* data, std::size_t count) {
+        m_owned = std::vector<T>();
+        m_data = data;
+        m_size = count;
+        m_borrowed = true;
+    }
+    bool Borrowed() const { return m_borrowed; }
+    // Copy borrowed values into the column's own vector
+    void Own() {
+        if (!m_borrowed) return;
+        m_owned.assign(m_data, m_data + m_size);
+        m_borrowed = false;
+        Sync();
+    }
+
+private:
+    void Sync() {
+        m_data = m_owned.data();
+        m_size = m_owned.size();
+    }
+
+    std::vector<T> m_owned;
+    const T* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_borrowed = false;
+};
+
+// Every column of a scene as a pointer and the counts they run over; the
+// start tables hold shapes + 1 entries
+struct SceneColumns {
+    std::size_t shapeCount = 0, pointCount = 0, spanCount = 0;
+    const std::uint8_t* modes = nullptr;
+    const std::uint8_t* fillModes = nullptr;
+    const std::uint8_t* bounded = nullptr;
+    const COLORREF* colors = nullptr;
+    const std::int32_t* thickness = nullptr;
+    const PixelRect* bounds = nullptr;
+    const ShapeGeometry* geometry = nullptr;
+    const std::uint32_t* pointStart = nullptr;
+    const std::uint32_t* spanStart = nullptr;
+    const Point* points = nullptr;
+    const FillSpan* spans = nullptr;
+};
+
+// ========================================
+// SCENE STORE
+// ========================================
+//
+// The shapes of a drawing as columns rather than one heap object per shape:
+// mode, fill mode, color and thickness are packed arrays indexed by shape,
+// and every shape's points (and a flood fill's spans) live in one shared
+// arena, found through an offset table.
+// Each shape's bounds (GetShapeBounds) and the center and radii it is
+// drawn with (GetShapeGeometry) are computed once when it is added.
+// A pass over the scene walks a few arrays front to back, and adding a
+// shape only ever appends.
+//
+// Shapes are read through View(i), which the renderers take like a Shape.
+//
+// The columns can also be borrowed from memory the scene doesn't own, such
+// as a mapped scene file (Adopt). A column is copied into the scene the
+// first time it changes, so edits never write to the file.
+class Scene {
+public:
+    std::size_t Size() const { return m_colors.size(); }
+    bool Empty() const { return m_colors.empty(); }
+    ShapeView View(std::size_t i) const;
+    ShapeView operator[](std::size_t i) const { return View(i); }
+
+    void Clear();
+
+    // Room for 'shapes' more shapes with 'points' points and 'spans' spans
+    // between them
+    void Reserve(std::size_t shapes, std::size_t points, std::size_t spans = 0);
+
+    // Append a copy of 'shape', which must not view this scene. Returns its
+    // index.
+    std::size_t Add(const ShapeView& shape);
+
+    // Append shapes [first, last) of 'other' as they are stored: bounds
+    // and geometry are copied, not recomputed
+    void Append(const Scene& other, std::size_t first, std::size_t last);
+
+    // Give shape i a fill, the one change made to shapes already in the
+    // scene; its bounds are recomputed
+    void SetFill(std::size_t i, FillMode fillMode, COLORREF color);
+
+    const PixelRect& Bounds(std::size_t i) const { return m_bounds[i]; }
+    const ShapeGeometry& Geometry(std::size_t i) const { return m_geometry[i]; }
+    // False when the shape may draw outside Bounds(i) (GetShapeBounds)
+    bool IsBounded(std::size_t i) const { return m_bounded[i] != 0; }
+    DrawingMode Mode(std::size_t i) const { return (DrawingMode)m_modes[i]; }
+
+    std::size_t PointCount() const { return m_points.size(); }
+    // Heap memory the columns and arenas hold, borrowed columns aside
+    std::size_t MemoryBytes() const;
+
+    SceneColumns Columns() const;
+
+    // Replace the scene with 'columns', used in place and kept alive by
+    // 'backing'. Nothing is checked: they must describe a valid scene, as
+    // ReadScene makes sure a file's do before adopting them.
+    void Adopt(const SceneColumns& columns, std::shared_ptr<const void> backing);
+    // Copy every borrowed column in and let go of what they were borrowed
+    // from (before the file a scene was mapped from is overwritten)
+    void Detach();
+    bool IsBorrowed() const { return m_backing != nullptr; }
+
+private:
+    // Shape i owns arena entries [start[i], start[i + 1])
+    SceneColumn<std::uint8_t> m_modes;
+    SceneColumn<std::uint8_t> m_fillModes;
+    SceneColumn<std::uint8_t> m_bounded;
+    SceneColumn<COLORREF> m_colors;
+    SceneColumn<std::int32_t> m_thickness;
+    SceneColumn<PixelRect> m_bounds;
+    SceneColumn<ShapeGeometry> m_geometry;
+    SceneColumn<std::uint32_t> m_pointStart = { 0 };
+    SceneColumn<std::uint32_t> m_spanStart = { 0 };
+    SceneColumn<Point> m_points;
+    SceneColumn<FillSpan> m_spans;
+
+    // What borrowed columns point into
+    std::shared_ptr<const void> m_backing;
+};
+
+#endif // SCENE_H
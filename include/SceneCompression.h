@@ -0,0 +1,51 @@
+#ifndef SCENE_COMPRESSION_H
+#define SCENE_COMPRESSION_H
+
+#include <cstddef>
+#include <vector>
+#include "Point.h"
+
+// ========================================
+// COMPACT SCENE FILE CODECS
+// ========================================
+//
+// The two encodings a compact .bin file may use (see SceneFile.h).
+
+// Point deltas: each point as its difference from the one before (the
+// first from (0, 0)), zig-zag mapped so small negative steps stay small,
+// as a group varint. The 2 x count values (dx, dy, dx, dy, ...) are taken
+// four at a time; one control byte per group holds the byte length - 1 of
+// each value in its 2-bit fields (lowest bits first), and the data bytes
+// of all groups follow all the control bytes, little-endian. A last group
+// that is short of four values is padded with zeros.
+//
+// Separating lengths from data lets the decoder load every value with one
+// unaligned 32-bit read and a mask, with no branch per byte as a
+// continuation-bit varint needs.
+
+// Append the encoding of 'count' points to 'out'
+void EncodePointDeltas(const Point* points, std::size_t count, std::vector<unsigned char>& out);
+
+// Decode exactly 'count' points from 'size' bytes; false if the bytes are
+// not a complete encoding of that many points
+bool DecodePointDeltas(const unsigned char* data, std::size_t size, Point* points, std::size_t count);
+
+// LZ77 block compression, greedy with a 64 KiB window. A block is a run
+// of sequences, each:
+//   token byte: literal count (high 4 bits), match length - 4 (low 4 bits);
+//     15 in either means more length bytes follow, each added, until one
+//     is below 255 (the literal count's come before the literals, the
+//     match length's after the offset)
+//   the literals
+//   uint16 match offset (1-65535 bytes back), unless the literals ended the
+//     block
+// The last sequence is literals only.
+
+// Append the compressed form of 'size' bytes to 'out'
+void CompressBlock(const unsigned char* data, std::size_t size, std::vector<unsigned char>& out);
+
+// Decompress a block that must expand to exactly 'outSize' bytes; false
+// on any malformed or mis-sized input
+bool DecompressBlock(const unsigned char* data, std::size_t size, unsigned char* out, std::size_t outSize);
+
+#endif // SCENE_COMPRESSION_H
@@ -0,0 +1,104 @@
+#ifndef SCENE_FILE_H
+#define SCENE_FILE_H
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include "Scene.h"
+
+// ========================================
+// .BIN SCENE FILE CODEC
+// ========================================
+//
+// Version 2 (written by WriteScene) is the Scene's columns laid out as they
+// are in memory, so a loaded file is used as the scene store in place:
+//
+//   header, 64 bytes:
+//     char   magic[8] = "GFXSCENE"
+//     uint32 version = 2, headerSize = 64
+//     uint32 chunkCount, flags = 0
+//     uint64 shapeCount, pointCount, spanCount, reserved = 0
+//     uint64 fileSize
+//   chunk directory, chunkCount x 24 bytes:
+//     uint32 id (four characters), uint32 elementSize
+//     uint64 offset (from the start of the file), uint64 elementCount
+//   chunks, each starting on a 64-byte boundary
+//
+// The shape table is one fixed-width chunk per field, shapeCount entries
+// each: MODE and FILL (uint8 DrawingMode, FillMode), BNDF (uint8, 1 when
+// the shape has bounds), COLR (uint32), THCK (int32), BNDS (PixelRect,
+// 4 x int32) and GEOM (ShapeGeometry, 4 x int32). PSTR and SSTR (uint32,
+// shapeCount + 1 entries) give where each shape's points and spans start
+// in PNTS (Point) and SPNS (FillSpan). Readers skip chunks they don't know.
+// BNDF, BNDS and GEOM must hold what GetShapeBounds and GetShapeGeometry
+// give for each shape, or the file is rejected.
+// Multi-byte fields are little-endian; big-endian hosts reject version 2.
+//
+// A compact file (flags nonzero) is smaller but can't be used in place; it
+// is decoded into memory on load. It leaves out BNDF, BNDS and GEOM, which
+// are worked out again from the points, and with
+//   flags bit 0: PNTS is replaced by PDLT, the points as zig-zag varint
+//     deltas (see SceneCompression.h)
+//   flags bit 1: MODE, FILL, COLR, THCK, PSTR, SSTR and SPNS are replaced
+//     by ZTAB, one LZ77 block of those chunks back to back, each start
+//     chunk given as shapeCount per-shape counts instead
+//
+// Version 1 (legacy; no header, 32-bit fields in host order):
+//
+//   int32 shapeCount
+//   per shape:
+//     int32 mode, uint32 color, int32 fillMode, int32 thickness
+//     int32 pointCount, then pointCount x (int32 x, int32 y)
+//     FLOOD_FILL shapes only: int32 spanCount, then spanCount x
+//       (int32 y, int32 x1, int32 x2), sorted by row
+
+// How WriteScene encodes a file; the default is a file that can be mapped
+struct SceneFileOptions {
+    bool deltaPoints = false;    // Points as varint deltas
+    bool compressTable = false;  // Everything but the points in one LZ77 block
+};
+
+// Serialize a scene as version 2; returns false on a write error
+bool WriteScene(std::ostream& out, const Scene& scene, const SceneFileOptions& options = SceneFileOptions());
+
+// Serialize a scene as version 1, which drops the stored bounds and
+// geometry
+bool WriteLegacyScene(std::ostream& out, const Scene& scene);
+
+// Parse a scene of either version from a stream, which is read in a few
+// large blocks. A version 2 file is checked in one pass over its shape
+// table and then adopted where it was read, without per-shape parsing (a
+// compact one is decoded first); a version 1 file is parsed shape by
+// shape. On failure (truncated or malformed data) returns false and leaves
+// 'scene' unchanged.
+bool ReadScene(std::istream& in, Scene& scene);
+
+// File convenience wrappers. A version 2 file is memory-mapped and the
+// scene reads it in place until edited; call Scene::Detach() before
+// writing over the file a scene was loaded from.
+bool SaveSceneToFile(const std::string& path, const Scene& scene,
+                     const SceneFileOptions& options = SceneFileOptions());
+bool LoadSceneFromFile(const std::string& path, Scene& scene);
+
+// How far a batched load has got
+struct SceneLoadProgress {
+    std::size_t shapes = 0;       // Shapes handed out so far
+    std::size_t totalShapes = 0;  // Shapes in the file
+};
+
+// Receives each batch; returning false stops the load
+using SceneBatchCallback = std::function<bool(const Scene& batch, const SceneLoadProgress& progress)>;
+
+// Load a file of either version a batch of shapes at a time, in drawing
+// order, so they can be drawn before the rest is read. Batches start small
+// and double up to 'batchShapes'; 'deliver' is called on the calling
+// thread and the batch is reused after it returns. A version 1 file is
+// parsed as it is handed out, so a malformed shape is only found after
+// the shapes before it have been delivered: on false the caller must
+// discard them. A version 2 file is checked whole before the first batch.
+// Returns false if the file can't be read or is malformed, or if
+// 'deliver' stopped the load.
+bool LoadSceneInBatches(const std::string& path, std::size_t batchShapes, const SceneBatchCallback& deliver);
+
+#endif // SCENE_FILE_H
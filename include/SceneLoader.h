@@ -0,0 +1,78 @@
+#ifndef SCENE_LOADER_H
+#define SCENE_LOADER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Scene.h"
+#include "SceneFile.h"
+
+// ========================================
+// BACKGROUND SCENE LOADER
+// ========================================
+//
+// Runs LoadSceneInBatches on a worker thread so a window can keep handling
+// messages, and draw what has arrived, while a large drawing loads. Each
+// batch is appended to a pending scene that the owner empties with
+// TakeShapes(). 'notify' is called on the worker when shapes land in an
+// empty pending scene (so the owner wakes once per take, not per batch)
+// and when the load ends; a window posts itself a message from it.
+class SceneLoader {
+public:
+    enum class State { IDLE, LOADING, DONE, FAILED, CANCELLED };
+
+    // Most shapes per batch
+    static const std::size_t DEFAULT_BATCH = 16384;
+
+    SceneLoader() = default;
+    ~SceneLoader() { Cancel(); }
+
+    SceneLoader(const SceneLoader&) = delete;
+    SceneLoader& operator=(const SceneLoader&) = delete;
+
+    // Start loading 'path', cancelling any load in progress. The file is
+    // opened on the worker, so a missing file ends in FAILED.
+    void Start(const std::string& path, std::function<void()> notify, std::size_t batchShapes = DEFAULT_BATCH);
+
+    // Stop at the next batch and wait for the worker; pending shapes are
+    // dropped. Does nothing unless loading.
+    void Cancel();
+
+    // Append the shapes that arrived since the last call to 'scene' (in
+    // file order, with their stored bounds and geometry); returns
+    // how many
+    std::size_t TakeShapes(Scene& scene);
+
+    State GetState() const;
+    SceneLoadProgress Progress() const;
+
+    // Milliseconds from Start() to the first batch parsed, and to the end
+    // of the load; negative until then
+    double FirstBatchMs() const;
+    double TotalMs() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void Run(const std::string& path, std::size_t batchShapes);
+    void Join();
+
+    std::thread m_worker;
+    std::function<void()> m_notify;
+    std::atomic<bool> m_cancel{ false };
+    Clock::time_point m_start;
+
+    // Guarded by m_mutex
+    mutable std::mutex m_mutex;
+    Scene m_pending;
+    State m_state = State::IDLE;
+    SceneLoadProgress m_progress;
+    double m_firstBatchMs = -1;
+    double m_totalMs = -1;
+};
+
+#endif // SCENE_LOADER_H
@@ -0,0 +1,95 @@
+#ifndef SHAPE_INDEX_H
+#define SHAPE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "DisplayList.h"
+#include "Framebuffer.h"
+#include "GraphicsTypes.h"
+#include "PixelSink.h"
+#include "Scene.h"
+
+// ========================================
+// SPATIAL INDEX OVER THE SCENE
+// ========================================
+//
+// Uniform grid over the canvas. Each cell lists, in drawing order, the
+// shapes whose bounds (Scene::Bounds) overlap it, so finding what touches
+// a region costs the cells it covers instead of a pass over the scene.
+// Only the canvas is gridded: parts of shapes outside it are never drawn,
+// and shapes entirely outside it are in no cell.
+//
+// Shapes that may draw outside their bounds (circles flood filled from the
+// target) are gridded by their outline and counted as unbounded; what they
+// fill depends on everything under them.
+class ShapeIndex {
+public:
+    explicit ShapeIndex(int cellSize = Framebuffer::TILE_SIZE);
+
+    // Index 'scene' for a width x height canvas from scratch
+    void Build(const Scene& scene, int width, int height);
+
+    // Drop every shape; the canvas size stays
+    void Clear();
+
+    // Index the shape appended to 'scene' (shape Count())
+    void Add(const Scene& scene);
+
+    // Re-index shape i of 'scene' after its fill changed
+    void Update(const Scene& scene, std::size_t i);
+
+    // Shapes whose bounds overlap 'rect', in drawing order
+    void Query(const PixelRect& rect, std::vector<std::uint32_t>& shapes);
+
+    // First shape, in drawing order, that 'accept' takes and that contains
+    // (x, y) by ShapeContainsPoint; -1 if there is none. Only the shapes
+    // listed in the point's cell are tested.
+    std::ptrdiff_t HitTest(const Scene& scene, int x, int y,
+                           const std::function<bool(const ShapeView&)>& accept) const;
+
+    std::size_t Count() const { return m_bounds.size(); }
+    const PixelRect& Bounds(std::size_t i) const { return m_bounds[i]; }
+    bool IsBounded(std::size_t i) const { return m_bounded[i] != 0; }
+    std::size_t UnboundedCount() const { return m_unbounded; }
+
+private:
+    // Cells overlapped by 'rect'; false if it misses the canvas
+    bool CellRange(const PixelRect& rect, int& cx1, int& cy1, int& cx2, int& cy2) const;
+    void Insert(std::uint32_t i);
+    void Remove(std::uint32_t i);
+
+    int m_cellSize;
+    int m_width = 0;
+    int m_height = 0;
+    int m_cellsX = 0;
+    int m_cellsY = 0;
+
+    std::vector<PixelRect> m_bounds;
+    std::vector<std::uint8_t> m_bounded;
+    std::size_t m_unbounded = 0;
+    std::vector<std::vector<std::uint32_t>> m_cells;  // Row-major, each sorted
+
+    // Query deduplicates shapes spanning several cells by stamping them
+    std::vector<std::uint32_t> m_stamps;
+    std::uint32_t m_stamp = 0;
+};
+
+// Exact inside test against what a fill of the shape covers: a circle's
+// radius, an ellipse's radii, a square's or rectangle's sides, and for
+// polygons and curves their fill contour (GetFillContour) by non-zero
+// winding. Points on the boundary are inside. Lines and recorded flood
+// fills contain nothing.
+bool ShapeContainsPoint(const ShapeView& shape, int x, int y);
+
+// Redraw only 'region' of the canvas: fill it with 'background' and draw,
+// in order and clipped to it, the shapes the index finds there. The pixels
+// come out as a full rebuild would draw them. Marks the region dirty;
+// bumping the framebuffer's version is left to the caller. Returns false,
+// without drawing, when the index holds shapes without bounds; rebuild
+// everything then. Given a display list cache, shapes are drawn from it.
+bool RedrawRegion(Framebuffer& framebuffer, const Scene& scene, ShapeIndex& index,
+                  const PixelRect& region, COLORREF background, DisplayListCache* displayLists = nullptr);
+
+#endif // SHAPE_INDEX_H
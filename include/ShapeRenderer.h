@@ -0,0 +1,38 @@
+#ifndef SHAPE_RENDERER_H
+#define SHAPE_RENDERER_H
+
+#include <vector>
+#include "Bezier.h"
+#include "GraphicsTypes.h"
+#include "PixelSink.h"
+
+// Rasterize one stored shape (outline and fill) into a pixel sink.
+// Shared by the window's offscreen buffer and headless tools.
+template <typename Sink> void RenderShape(Sink& sink, const ShapeView& shape);
+
+// The center and radii RenderShape draws 'shape' with (see ShapeGeometry)
+ShapeGeometry GetShapeGeometry(const ShapeView& shape);
+
+// Conservative bounds of the pixels RenderShape writes (and reads) for
+// 'shape'; empty when it draws nothing. Returns false when the shape may
+// draw outside them: circles flood filled from the target fill whatever
+// region surrounds them. 'bounds' is then the circle's own.
+bool GetShapeBounds(const ShapeView& shape, PixelRect& bounds);
+
+// The closed contour an anti-aliased fill covers, for polygons and curves
+// (a curve is closed by the chord between its ends). Returns false for
+// other shapes and for contours with fewer than three points.
+bool GetFillContour(const ShapeView& shape, std::vector<BezierPoint>& contour);
+
+// Anti-aliased fill modes draw the shape as filled coverage in place of
+// its outline (circles, ellipses, polygons and curves)
+inline bool IsAntialiasedFill(FillMode mode) {
+    return mode == FillMode::ANTIALIASED_EVEN_ODD || mode == FillMode::ANTIALIASED_NON_ZERO;
+}
+
+#ifdef GFX_WITH_GDI
+// GDI wrapper
+void RenderShape(HDC hdc, const ShapeView& shape);
+#endif
+
+#endif // SHAPE_RENDERER_H
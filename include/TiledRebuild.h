@@ -0,0 +1,116 @@
+#ifndef TILED_REBUILD_H
+#define TILED_REBUILD_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "DisplayList.h"
+#include "Framebuffer.h"
+#include "GraphicsTypes.h"
+#include "PixelSink.h"
+#include "Scene.h"
+
+// ========================================
+// PARALLEL TILE-BINNED SCENE REBUILD
+// ========================================
+//
+// Redraws a whole scene on a pool of worker threads. The framebuffer is cut
+// into square tiles and every shape is binned, in drawing order, into the
+// tiles its bounds (Scene::Bounds) overlap. Workers then take whole tiles
+// and render each tile's shapes in order through a BgraSink clipped to that
+// tile. Every pixel sees the same shapes in the same order as a serial
+// redraw, so the result is bit-identical to it, and no two workers ever
+// write the same pixel.
+//
+// A shape touching several tiles is rasterized once per tile (clipped), so
+// tiles trade duplicated setup for parallelism. Shapes without bounds
+// (circles flood filled from the target) split the scene: what precedes
+// them is rendered in parallel, then they are drawn serially on the whole
+// framebuffer, then the rest continues.
+//
+// Given a display list cache, lists missing for the shapes on the canvas
+// are recorded in parallel up front, and the tiles replay them.
+//
+// Shapes take their scratch from the arena of the thread drawing them
+// (ThreadArena); each render resets the arenas of the threads it runs on.
+// Once the arenas and the rebuilder's own arrays have grown to the scene,
+// a render makes no heap allocations.
+
+// Default tile edge in pixels
+const int DEFAULT_REBUILD_TILE = 128;
+
+struct TiledRebuildStats {
+    std::size_t shapes = 0;        // Shapes in the scene
+    std::size_t binned = 0;        // Shape-tile pairs rendered
+    std::size_t serialShapes = 0;  // Shapes drawn on the whole framebuffer
+    int tiles = 0;                 // Tiles in the framebuffer
+    int batches = 0;               // Parallel passes (1 + serial shapes, at most)
+    std::size_t culled = 0;        // Shapes entirely off the canvas, skipped
+    std::size_t recorded = 0;      // Display lists recorded for this render
+    std::uint64_t arenaAllocations = 0;  // Blocks arenas took from the heap during the render
+    std::size_t arenaPeak = 0;           // Most scratch any one thread had in use at once
+};
+
+class TiledRebuilder {
+public:
+    // threads <= 0 uses every hardware thread. With one thread Render
+    // draws serially and skips the binning.
+    explicit TiledRebuilder(int threads = 0, int tileSize = DEFAULT_REBUILD_TILE);
+    ~TiledRebuilder();
+
+    TiledRebuilder(const TiledRebuilder&) = delete;
+    TiledRebuilder& operator=(const TiledRebuilder&) = delete;
+
+    // Draw the scene in order over the current contents of 'framebuffer',
+    // skipping shapes off the canvas. Tiles are not marked dirty (a rebuild
+    // follows a Clear(), which dirties everything) and the framebuffer's
+    // version is left to the caller. Given a cache of display lists for the
+    // scene, shapes are drawn from their lists.
+    void Render(Framebuffer& framebuffer, const Scene& scene, DisplayListCache* displayLists = nullptr);
+
+    int Threads() const { return m_threads; }
+    int TileSize() const { return m_tileSize; }
+    const TiledRebuildStats& LastStats() const { return m_stats; }
+
+private:
+    // Run job(0) .. job(m_threads - 1), job(0) on the calling thread.
+    // Pass lambdas as std::ref(lambda) so the std::function does not
+    // allocate a copy of them.
+    void RunOnAll(const std::function<void(int)>& job);
+    void WorkerLoop(int index);
+
+    void RenderShapes(Framebuffer& framebuffer, const Scene& scene, DisplayListCache* displayLists);
+    void PrepareDisplayLists(const Framebuffer& framebuffer, const Scene& scene, DisplayListCache& cache);
+    void RenderBatch(Framebuffer& framebuffer, const Scene& scene, std::size_t begin, std::size_t end);
+    void DrawShape(BgraSink& sink, const Scene& scene, std::size_t i) const;
+
+    int m_threads;
+    int m_tileSize;
+    TiledRebuildStats m_stats;
+
+    // Worker pool; woken per job by bumping m_generation
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(int)>* m_job = nullptr;
+    std::uint64_t m_generation = 0;
+    int m_pending = 0;
+    bool m_stopping = false;
+    std::uint64_t m_render = 0;  // Renders started; a worker resets its arena on its first job of each
+
+    // Per-render scratch, kept to avoid reallocating
+    std::vector<std::uint32_t> m_tileStart;   // Shapes of tile t: m_tileShapes[m_tileStart[t] .. m_tileStart[t + 1])
+    std::vector<std::uint32_t> m_tileShapes;
+    std::vector<std::uint32_t> m_tileCursor;  // Binning fill position per tile
+    std::vector<const DisplayList*> m_lists;  // Per shape, nullptr to draw it directly
+    std::vector<std::uint32_t> m_toRecord;
+    std::vector<DisplayList> m_recorded;      // Recordings the cache had no room for live here
+    std::vector<std::uint8_t> m_recordedOk;
+};
+
+#endif // TILED_REBUILD_H
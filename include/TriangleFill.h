@@ -0,0 +1,45 @@
+#ifndef TRIANGLE_FILL_H
+#define TRIANGLE_FILL_H
+
+#include <vector>
+#include "PixelSink.h"
+#include "Point.h"
+
+// ========================================
+// TRIANGULATED POLYGON FILL
+// ========================================
+//
+// A simple polygon is triangulated (ear clipping) and each triangle is
+// filled from its three half-space edge functions E(x, y) = a*x + b*y + c:
+// per row, every edge bounds x from one side, and the bounds are stepped
+// down the rows as exact integer quotients and remainders, so there is no
+// per-pixel test and no rounding drift.
+//
+// A pixel is inside when its center is inside or on the boundary, rows run
+// from the top vertex up to but not including the bottom one. The scanline
+// fillers round their edge crossings instead, so boundary pixels can
+// differ, and for whole polygons FillPolygon is faster; RenderShape fills
+// polygons with FillPolygon (see triangle_fill_benchmark).
+
+// Polygons up to this many vertices are triangulated; ear clipping and the
+// simplicity test are quadratic, and larger ones are rejected
+const int MAX_TRIANGULATED_VERTICES = 4096;
+
+// Vertex coordinates must lie within +-this for exact 64-bit edge functions
+const int MAX_TRIANGLE_COORD = 1 << 24;
+
+// Triangulate a simple polygon into vertex index triples. Returns false
+// (and leaves 'triangles' empty) for self-intersecting or degenerate
+// polygons, or ones outside the limits above; fill those with FillPolygon.
+bool TriangulatePolygon(const Point p[], int n, std::vector<int>& triangles);
+
+// Fill triangles p[indices[i]], p[indices[i + 1]], p[indices[i + 2]]
+template <typename Sink>
+void FillTriangles(Sink& sink, const Point p[], const int indices[], int indexCount, COLORREF c);
+
+#ifdef GFX_WITH_GDI
+// GDI wrapper
+void FillTriangles(HDC hdc, const Point p[], const int indices[], int indexCount, COLORREF c);
+#endif
+
+#endif // TRIANGLE_FILL_H
@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <windows.h>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <string>
 #include <memory>
@@ -18,12 +20,26 @@
 #include "Hermite.h"
 #include "Bezier.h"
 #include "CardinalSpline.h"
+#include "CurveTessellator.h"
 #include "Utils.h"
 #include "FloodFill.h"
+#include "ParallelFloodFill.h"
 #include "GraphicsTypes.h"
+#include "Framebuffer.h"
+#include "ShapeRenderer.h"
+#include "TiledRebuild.h"
+#include "Scene.h"
+#include "ShapeIndex.h"
+#include "DisplayList.h"
+#include "SceneFile.h"
+#include "SceneLoader.h"
 
 using namespace std;
 
+// Posted by the scene loader's thread when parsed shapes are waiting, and
+// by the window to itself while shapes remain to be drawn
+static const UINT WM_SCENE_LOAD = WM_APP + 1;
+
 // ========================================
 // MAIN GRAPHICS WINDOW CLASS
 // ========================================
@@ -35,13 +51,37 @@ private:
     HINSTANCE m_hInstance;
     HDC m_hdc;
 
-    // Offscreen drawing buffer for performance
+    // Offscreen drawing buffer for performance.
+    // Algorithms write into m_framebuffer directly; m_offscreenDC only has
+    // its DIB section selected so WM_PAINT can present it with one BitBlt.
+    Framebuffer m_framebuffer;
     HDC m_offscreenDC;
-    HBITMAP m_offscreenBitmap;
     HBITMAP m_oldBitmap;
     int m_canvasWidth;
     int m_canvasHeight;
 
+    // Region labels for the parallel flood fill, valid until the
+    // framebuffer changes
+    FloodFillLabels m_floodLabels;
+
+    // Redraws the whole scene on worker threads, one tile per task
+    TiledRebuilder m_rebuilder;
+
+    // Shape bounds by canvas cell; an edit redraws only what it touched
+    ShapeIndex m_shapeIndex;
+
+    // Each shape's rasterized runs, replayed by redraws instead of running
+    // the algorithms again
+    DisplayListCache m_displayLists;
+
+    // Presenting: dirty tiles become invalid rectangles, and WM_PAINT blits
+    // only the update region. The last paint's totals are kept, and sent to
+    // the debug output in builds with GFX_PAINT_STATS.
+    std::vector<Framebuffer::DirtyRect> m_dirtyRects;
+    std::vector<char> m_regionData;
+    int m_lastPaintRects;
+    std::size_t m_lastPaintBytes;
+
     // Drawing state
     DrawingMode m_currentDrawingMode;
     FillMode m_currentFillMode;
@@ -63,7 +103,22 @@ private:
     bool m_isDrawingPolygon;
 
     // Shape storage
-    std::vector<Shape> m_shapes;
+    Scene m_scene;
+
+    // Progressive loading: the loader parses on its own thread, and each
+    // WM_SCENE_LOAD appends what it has parsed to m_scene and draws shapes
+    // for up to one frame. The drawing being replaced is kept until the
+    // load ends, to come back if it fails or is cancelled. m_loadPosted is
+    // set while a WM_SCENE_LOAD is queued, so the loader's thread and the
+    // window never queue a second one; it is declared first so it outlives
+    // the loader's thread.
+    std::atomic<bool> m_loadPosted;
+    SceneLoader m_loader;
+    bool m_loading;
+    std::size_t m_loadDrawn;
+    Scene m_loadPrevious;
+    std::chrono::steady_clock::time_point m_loadStart;
+    double m_loadFirstPixelMs;
 
     // Pens and brushes
     HPEN m_currentPen;
@@ -99,16 +154,26 @@ private:
     void UpdateCurrentPen();
     void RedrawAll();
     void DrawShapeToBuffer(const Shape& shape);
+    void AddShape(const Shape& shape);
+    void RedrawChangedShape(std::size_t index);
 
     // Helper methods - Buffer
     void CreateOffscreenBuffer(int width, int height);
     void CleanupOffscreenBuffer();
     void ClearOffscreenBuffer();
     void RebuildOffscreenBuffer();
+    void PresentDirtyTiles();
+    void InvalidateStatusText();
+    void BlitUpdateRegion(HDC hdc, HRGN region);
 
     // Helper methods - File I/O
     void SaveToFile();
     void LoadFromFile();
+    void PostLoadMessage();
+    void ContinueLoad();
+    void FinishLoad();
+    void CancelLoad();
+    void RestorePreviousScene();
 
     // Helper methods - Canvas
     void ClearCanvas();
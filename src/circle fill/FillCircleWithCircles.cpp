@@ -1,9 +1,22 @@
 #include "../../include/CircleFillAlgorithms.h"
 
 // Fill circle with concentric circles (using actual circle algorithms)
-void FillCircleWithCircles(HDC hdc, int xc, int yc, int R, COLORREF c) {
+template <typename Sink>
+void FillCircleWithCircles(Sink& sink, int xc, int yc, int R, COLORREF c) {
     // Draw concentric circles from center outward using existing circle algorithm
     for (int r = 1; r <= R; r+=1) {
-        DrawCircleBresenham(hdc, xc, yc, r, c);
+        DrawCircleBresenham(sink, xc, yc, r, c);
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FillCircleWithCircles<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FillCircleWithCircles(HDC hdc, int xc, int yc, int R, COLORREF c) {
+    GdiSink sink(hdc);
+    FillCircleWithCircles(sink, xc, yc, R, c);
+}
+#endif
@@ -1,29 +1,32 @@
 #include "../../include/CircleFillAlgorithms.h"
 
 // Helper function to fill one octal with lines
-void FillOctalWithLines(HDC hdc, int xc, int yc, int x, int y, COLORREF c) {
+template <typename Sink>
+void FillOctalWithLines(Sink& sink, int xc, int yc, int x, int y, COLORREF c) {
     // Fill the first octal (0 to 45 degrees) with horizontal lines
     if (x <= y) {
         // Draw horizontal line from center to the circle point in first octal
-        DrawHorizontalLine(hdc, xc, xc + x, yc + y, c);
+        DrawHorizontalLine(sink, xc, xc + x, yc + y, c);
     }
 }
 
 // Helper function to fill using 8-point symmetry with lines
-void FillWithSymmetricLines(HDC hdc, int xc, int yc, int x, int y, COLORREF c) {
-    DrawHorizontalLine(hdc, xc - x, xc + x, yc + y, c);
-    DrawHorizontalLine(hdc, xc - x, xc + x, yc - y, c);
-    DrawHorizontalLine(hdc, xc - y, xc + y, yc + x, c);
-    DrawHorizontalLine(hdc, xc - y, xc + y, yc - x, c);
+template <typename Sink>
+void FillWithSymmetricLines(Sink& sink, int xc, int yc, int x, int y, COLORREF c) {
+    DrawHorizontalLine(sink, xc - x, xc + x, yc + y, c);
+    DrawHorizontalLine(sink, xc - x, xc + x, yc - y, c);
+    DrawHorizontalLine(sink, xc - y, xc + y, yc + x, c);
+    DrawHorizontalLine(sink, xc - y, xc + y, yc - x, c);
 }
 
 // Main algorithm: Fill circle with lines
-void FillCircleWithLines(HDC hdc, int xc, int yc, int R, COLORREF c) {
+template <typename Sink>
+void FillCircleWithLines(Sink& sink, int xc, int yc, int R, COLORREF c) {
     int x = 0, y = R;
     int d = 1 - R;
 
-    FillOctalWithLines(hdc, xc, yc, x, y, c);
-    FillWithSymmetricLines(hdc, xc, yc, x, y, c);
+    FillOctalWithLines(sink, xc, yc, x, y, c);
+    FillWithSymmetricLines(sink, xc, yc, x, y, c);
 
     while (x < y) {
         if (d < 0) {
@@ -35,7 +38,31 @@ void FillCircleWithLines(HDC hdc, int xc, int yc, int R, COLORREF c) {
             y--;
         }
 
-        FillOctalWithLines(hdc, xc, yc, x, y, c);
-        FillWithSymmetricLines(hdc, xc, yc, x, y, c);
+        FillOctalWithLines(sink, xc, yc, x, y, c);
+        FillWithSymmetricLines(sink, xc, yc, x, y, c);
     }
 }
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FillOctalWithLines<Sink>(Sink&, int, int, int, int, COLORREF); \
+    template void FillWithSymmetricLines<Sink>(Sink&, int, int, int, int, COLORREF); \
+    template void FillCircleWithLines<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FillOctalWithLines(HDC hdc, int xc, int yc, int x, int y, COLORREF c) {
+    GdiSink sink(hdc);
+    FillOctalWithLines(sink, xc, yc, x, y, c);
+}
+
+void FillWithSymmetricLines(HDC hdc, int xc, int yc, int x, int y, COLORREF c) {
+    GdiSink sink(hdc);
+    FillWithSymmetricLines(sink, xc, yc, x, y, c);
+}
+
+void FillCircleWithLines(HDC hdc, int xc, int yc, int R, COLORREF c) {
+    GdiSink sink(hdc);
+    FillCircleWithLines(sink, xc, yc, R, c);
+}
+#endif
@@ -1,11 +1,12 @@
 #include "../../include/CircleFillAlgorithms.h"
 
-void FillQuarterCircle(HDC hdc, int xc, int yc, int R, COLORREF c) {
+template <typename Sink>
+void FillQuarterCircle(Sink& sink, int xc, int yc, int R, COLORREF c) {
     int x = 0, y = R;
     int d = 1 - R;
     
     // Fill first quarter only with horizontal lines
-    DrawHorizontalLine(hdc, xc, xc + x, yc - y, c);
+    DrawHorizontalLine(sink, xc, xc + x, yc - y, c);
     
     while (x < y) {
         if (d < 0) {
@@ -20,10 +21,22 @@ void FillQuarterCircle(HDC hdc, int xc, int yc, int R, COLORREF c) {
         // Fill only the first quarter (top-right quadrant)
         // Draw horizontal lines from center to circle boundary
         if (y >= 0) {
-            DrawHorizontalLine(hdc, xc, xc + x, yc - y, c);
+            DrawHorizontalLine(sink, xc, xc + x, yc - y, c);
         }
         if (x <= y && x >= 0) {
-            DrawHorizontalLine(hdc, xc, xc + y, yc - x, c);
+            DrawHorizontalLine(sink, xc, xc + y, yc - x, c);
         }
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FillQuarterCircle<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FillQuarterCircle(HDC hdc, int xc, int yc, int R, COLORREF c) {
+    GdiSink sink(hdc);
+    FillQuarterCircle(sink, xc, yc, R, c);
+}
+#endif
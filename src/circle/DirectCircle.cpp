@@ -1,25 +1,31 @@
-#include <windows.h>
 #include <cmath>
 #include "../../include/Utils.h"
 #include "../../include/CircleAlgorithms.h"
 
-void DrawPoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c) {
-    SetPixel(hdc, xc+x, yc+y, c);
-    SetPixel(hdc, xc-x, yc+y, c);
-    SetPixel(hdc, xc-x, yc-y, c);
-    SetPixel(hdc, xc+x, yc-y, c);
-    SetPixel(hdc, xc+y, yc+x, c);
-    SetPixel(hdc, xc-y, yc+x, c);
-    SetPixel(hdc, xc-y, yc-x, c);
-    SetPixel(hdc, xc+y, yc-x, c);
-}
-
-void DrawDirectCircle(HDC hdc, int xc, int yc, int R, COLORREF c) {
+template <typename Sink>
+void DrawDirectCircle(Sink& sink, int xc, int yc, int R, COLORREF c) {
     int x = 0, y = R;
-    DrawPoint(hdc, xc, yc, x, y, c);
+    DrawPoint(sink, xc, yc, x, y, c);
     while (x < y) {
         x++;
         y = Round(sqrt(R*R - x*x));
-        DrawPoint(hdc, xc, yc, x, y, c);
+        DrawPoint(sink, xc, yc, x, y, c);
     }
-} 
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawDirectCircle<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawPoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawPoint(sink, xc, yc, x, y, c);
+}
+
+void DrawDirectCircle(HDC hdc, int xc, int yc, int R, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawDirectCircle(sink, xc, yc, R, c);
+}
+#endif
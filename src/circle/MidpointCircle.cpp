@@ -1,12 +1,9 @@
-#include <windows.h>
 #include "../../include/CircleAlgorithms.h"
 
-// Forward declaration of DrawPoint from DirectCircle.cpp
-void DrawPoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
-
-void DrawCircleBresenham(HDC hdc, int xc, int yc, int R, COLORREF c) {
+template <typename Sink>
+void DrawCircleBresenham(Sink& sink, int xc, int yc, int R, COLORREF c) {
     int x = 0, y = R, d = 1 - R;
-    DrawPoint(hdc, xc, yc, x, y, c);
+    DrawPoint(sink, xc, yc, x, y, c);
     while (x < y) {
         if (d < 0) {
             d += 2 * x + 3;
@@ -15,6 +12,18 @@ void DrawCircleBresenham(HDC hdc, int xc, int yc, int R, COLORREF c) {
             d += 2 * (x - y) + 5;
             x++; y--;
         }
-        DrawPoint(hdc, xc, yc, x, y, c);
+        DrawPoint(sink, xc, yc, x, y, c);
     }
-} 
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawCircleBresenham<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawCircleBresenham(HDC hdc, int xc, int yc, int R, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawCircleBresenham(sink, xc, yc, R, c);
+}
+#endif
@@ -1,19 +1,28 @@
-#include <windows.h>
 #include "../../include/CircleAlgorithms.h"
 
-// Forward declaration of DrawPoint from DirectCircle.cpp
-void DrawPoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
-
-void DrawCircleDDA1(HDC hdc, int xc, int yc, int R, COLORREF c) {
+template <typename Sink>
+void DrawCircleDDA1(Sink& sink, int xc, int yc, int R, COLORREF c) {
     int x = 0, y = R, d = 1 - R;
     int d1 = 3, d2 = 5 - 2 * R;
-    DrawPoint(hdc, xc, yc, x, y, c);
+    DrawPoint(sink, xc, yc, x, y, c);
     while (x < y) {
         if (d < 0) {
             d += d1; d1 += 2; d2 += 2; x++;
         } else {
             d += d2; d1 += 2; d2 += 4; x++; y--;
         }
-        DrawPoint(hdc, xc, yc, x, y, c);
+        DrawPoint(sink, xc, yc, x, y, c);
     }
-} 
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawCircleDDA1<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawCircleDDA1(HDC hdc, int xc, int yc, int R, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawCircleDDA1(sink, xc, yc, R, c);
+}
+#endif
@@ -1,19 +1,28 @@
-#include <windows.h>
 #include <cmath>
 #include "../../include/Utils.h"
 #include "../../include/CircleAlgorithms.h"
 
-// Forward declaration of DrawPoint from DirectCircle.cpp
-void DrawPoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c);
-
-void DrawPolarCircle(HDC hdc, int xc, int yc, int R, COLORREF c) {
+template <typename Sink>
+void DrawPolarCircle(Sink& sink, int xc, int yc, int R, COLORREF c) {
     int x = R, y = 0;
-    DrawPoint(hdc, xc, yc, x, y, c);
+    DrawPoint(sink, xc, yc, x, y, c);
     double theta = 0, dtheta = 1.0/R;
     while (x > y) {
         theta += dtheta;
         x = Round(R * cos(theta));
         y = Round(R * sin(theta));
-        DrawPoint(hdc, xc, yc, x, y, c);
+        DrawPoint(sink, xc, yc, x, y, c);
     }
-} 
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawPolarCircle<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawPolarCircle(HDC hdc, int xc, int yc, int R, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawPolarCircle(sink, xc, yc, R, c);
+}
+#endif
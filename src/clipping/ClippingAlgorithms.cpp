@@ -1,7 +1,7 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
-#include "ClippingAlgorithms.h"
+#include "../../include/ClippingAlgorithms.h"
 
 // Rectangle Point Clipping
 bool ClipPointRectangle(int x, int y, int xLeft, int xRight, int yTop, int yBottom) {
@@ -49,7 +49,7 @@ bool CohenSutherlandLineClip(int& x1, int& y1, int& x2, int& y2, int xLeft, int
             return false;
         } else {
             OutCode outP = out1.all ? out1 : out2;
-            int tempX, tempY;
+            int tempX = 0, tempY = 0;
             if (outP.left) {
                 VIntersect(cx1, cy1, cx2, cy2, xLeft, tempX, tempY);
             } else if (outP.right) {
@@ -79,71 +79,48 @@ static Point2 HIntersect(const Point2& v1, const Point2& v2, double yEdge) {
     double xi = v1.x + (yEdge - v1.y) * (v2.x - v1.x) / (v2.y - v1.y);
     return Point2(xi, yEdge);
 }
-static std::vector<Point2> clipLeft(const std::vector<Point2>& p, double xLeft) {
-    int n = p.size();
+// One Sutherland-Hodgman pass: keep the side of an edge where inside(v)
+// holds, cutting the polygon's edges with cut(v1, v2). 'out' needs room
+// for 2 * n points (each edge adds at most two); returns how many it got.
+template <typename Inside, typename Cut>
+static int ClipAgainstEdge(const Point2 p[], int n, Point2 out[], Inside inside, Cut cut) {
+    if (n == 0) return 0;
+    int count = 0;
     Point2 v1 = p[n-1];
-    bool in1 = v1.x >= xLeft;
-    std::vector<Point2> out;
+    bool in1 = inside(v1);
     for (int i = 0; i < n; i++) {
         Point2 v2 = p[i];
-        bool in2 = v2.x >= xLeft;
-        if (in1 && in2) out.push_back(v2);
-        else if (in1 && !in2) out.push_back(VIntersect(v1, v2, xLeft));
-        else if (!in1 && in2) { out.push_back(VIntersect(v1, v2, xLeft)); out.push_back(v2); }
+        bool in2 = inside(v2);
+        if (in1 && in2) out[count++] = v2;
+        else if (in1 && !in2) out[count++] = cut(v1, v2);
+        else if (!in1 && in2) { out[count++] = cut(v1, v2); out[count++] = v2; }
         v1 = v2; in1 = in2;
     }
-    return out;
-}
-static std::vector<Point2> clipRight(const std::vector<Point2>& p, double xRight) {
-    int n = p.size();
-    Point2 v1 = p[n-1];
-    bool in1 = v1.x <= xRight;
-    std::vector<Point2> out;
-    for (int i = 0; i < n; i++) {
-        Point2 v2 = p[i];
-        bool in2 = v2.x <= xRight;
-        if (in1 && in2) out.push_back(v2);
-        else if (in1 && !in2) out.push_back(VIntersect(v1, v2, xRight));
-        else if (!in1 && in2) { out.push_back(VIntersect(v1, v2, xRight)); out.push_back(v2); }
-        v1 = v2; in1 = in2;
-    }
-    return out;
+    return count;
 }
-static std::vector<Point2> clipBottom(const std::vector<Point2>& p, double yBottom) {
-    int n = p.size();
-    Point2 v1 = p[n-1];
-    bool in1 = v1.y <= yBottom;
-    std::vector<Point2> out;
-    for (int i = 0; i < n; i++) {
-        Point2 v2 = p[i];
-        bool in2 = v2.y <= yBottom;
-        if (in1 && in2) out.push_back(v2);
-        else if (in1 && !in2) out.push_back(HIntersect(v1, v2, yBottom));
-        else if (!in1 && in2) { out.push_back(HIntersect(v1, v2, yBottom)); out.push_back(v2); }
-        v1 = v2; in1 = in2;
-    }
-    return out;
-}
-static std::vector<Point2> clipTop(const std::vector<Point2>& p, double yTop) {
-    int n = p.size();
-    Point2 v1 = p[n-1];
-    bool in1 = v1.y >= yTop;
-    std::vector<Point2> out;
-    for (int i = 0; i < n; i++) {
-        Point2 v2 = p[i];
-        bool in2 = v2.y >= yTop;
-        if (in1 && in2) out.push_back(v2);
-        else if (in1 && !in2) out.push_back(HIntersect(v1, v2, yTop));
-        else if (!in1 && in2) { out.push_back(HIntersect(v1, v2, yTop)); out.push_back(v2); }
-        v1 = v2; in1 = in2;
-    }
-    return out;
+
+ArrayView<Point2> SutherlandHodgmanPolygonClip(ArrayView<Point2> polygon, int xLeft, int xRight, int yTop, int yBottom,
+                                               FrameArena& arena) {
+    int n = (int)polygon.size();
+    Point2* p1 = arena.Allocate<Point2>(2 * n);
+    n = ClipAgainstEdge(polygon.data(), n, p1, [&](const Point2& v) { return v.x >= xLeft; },
+                        [&](const Point2& a, const Point2& b) { return VIntersect(a, b, xLeft); });
+    Point2* p2 = arena.Allocate<Point2>(2 * n);
+    n = ClipAgainstEdge(p1, n, p2, [&](const Point2& v) { return v.x <= xRight; },
+                        [&](const Point2& a, const Point2& b) { return VIntersect(a, b, xRight); });
+    Point2* p3 = arena.Allocate<Point2>(2 * n);
+    n = ClipAgainstEdge(p2, n, p3, [&](const Point2& v) { return v.y <= yBottom; },
+                        [&](const Point2& a, const Point2& b) { return HIntersect(a, b, yBottom); });
+    Point2* p4 = arena.Allocate<Point2>(2 * n);
+    n = ClipAgainstEdge(p3, n, p4, [&](const Point2& v) { return v.y >= yTop; },
+                        [&](const Point2& a, const Point2& b) { return HIntersect(a, b, yTop); });
+    return ArrayView<Point2>(p4, n);
 }
+
 std::vector<Point2> SutherlandHodgmanPolygonClip(const std::vector<Point2>& polygon, int xLeft, int xRight, int yTop, int yBottom) {
-    std::vector<Point2> p1 = clipLeft(polygon, xLeft);
-    std::vector<Point2> p2 = clipRight(p1, xRight);
-    std::vector<Point2> p3 = clipBottom(p2, yBottom);
-    return clipTop(p3, yTop);
+    ArenaScope scope;
+    ArrayView<Point2> clipped = SutherlandHodgmanPolygonClip(polygon, xLeft, xRight, yTop, yBottom, scope.Arena());
+    return std::vector<Point2>(clipped.begin(), clipped.end());
 }
 
 // Square wrappers
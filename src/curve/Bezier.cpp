@@ -1,28 +1,173 @@
 #include "../../include/Bezier.h"
+#include "../../include/FrameArena.h"
 #include <cmath>
 #include <algorithm>
+#include <climits>
 
 BezierPoint RecBezier(double t, BezierPoint pts[], int si, int ei) {
-    if (si == ei) {
-        return pts[si];
+    ArenaScope scope;
+    BezierPoint* scratch = scope.Arena().Allocate<BezierPoint>(ei - si + 1);
+    return DeCasteljau(t, pts + si, ei - si + 1, scratch);
+}
+
+BezierPoint DeCasteljau(double t, const BezierPoint pts[], int numPoints, BezierPoint scratch[]) {
+    std::copy(pts, pts + numPoints, scratch);
+
+    // Each pass replaces scratch[0..n-1] with the next level of lerps
+    for (int n = numPoints - 1; n > 0; n--) {
+        for (int i = 0; i < n; i++) {
+            scratch[i].x = (1 - t) * scratch[i].x + t * scratch[i + 1].x;
+            scratch[i].y = (1 - t) * scratch[i].y + t * scratch[i + 1].y;
+        }
     }
-    
-    BezierPoint p1 = RecBezier(t, pts, si, ei - 1);
-    BezierPoint p2 = RecBezier(t, pts, si + 1, ei);
-    
-    BezierPoint result;
-    result.x = (1 - t) * p1.x + t * p2.x;
-    result.y = (1 - t) * p1.y + t * p2.y;
-    
-    return result;
+    return scratch[0];
 }
 
-void DrawBezierCurve(HDC hdc, BezierPoint pts[], int numPoints, int steps, COLORREF color) {
+void BernsteinBasis::Build(int degree, int steps) {
+    if (degree != m_degree) {
+        m_logFactorials.assign(degree + 1, 0.0);
+        for (int i = 2; i <= degree; i++) {
+            m_logFactorials[i] = m_logFactorials[i - 1] + std::log((double)i);
+        }
+    }
+    m_degree = degree;
+    m_steps = steps;
+    m_firstPoint.resize(steps + 1);
+    m_rowStart.resize(steps + 2);
+    m_weights.clear();
+
+    ArenaScope scope;
+    double* row = scope.Arena().Allocate<double>(degree + 1);
+    for (int step = 0; step <= steps; step++) {
+        int first, last;  // Inclusive
+        if (step == 0 || step == steps) {
+            first = last = (step == 0) ? 0 : degree;
+            row[first] = 1;
+        } else {
+            double t = (double)step / steps;
+            double s = 1 - t;
+
+            // Every other weight is a ratio away from the largest
+            int mode = std::min(degree, (int)((degree + 1) * t));
+            row[mode] = ModeWeight(mode, t);
+
+            // Weights only shrink away from the mode, so stop at the first
+            // negligible one on each side
+            const double up = t / s, down = s / t;
+            for (last = mode; last < degree; last++) {
+                double weight = row[last] * (degree - last) / (last + 1) * up;
+                if (weight < NEGLIGIBLE) break;
+                row[last + 1] = weight;
+            }
+            for (first = mode; first > 0; first--) {
+                double weight = row[first] * first / (degree - first + 1) * down;
+                if (weight < NEGLIGIBLE) break;
+                row[first - 1] = weight;
+            }
+        }
+        m_firstPoint[step] = first;
+        m_rowStart[step] = m_weights.size();
+        m_weights.insert(m_weights.end(), row + first, row + last + 1);
+    }
+    m_rowStart[steps + 1] = m_weights.size();
+}
+
+double BernsteinBasis::ModeWeight(int mode, double t) const {
+    // C(n, k) t^k s^(n-k) at k = floor((n + 1) t), in logs so nothing
+    // overflows
+    return std::exp(m_logFactorials[m_degree] - m_logFactorials[mode] - m_logFactorials[m_degree - mode] +
+                    mode * std::log(t) + (m_degree - mode) * std::log(1 - t));
+}
+
+BezierPoint BernsteinBasis::EvaluateAt(const BezierPoint pts[], double t) const {
+    if (t <= 0) return pts[0];
+    if (t >= 1) return pts[m_degree];
+
+    // Outward from the largest weight as Build() does, summing as it goes
+    const double s = 1 - t;
+    const double up = t / s, down = s / t;
+    const int mode = std::min(m_degree, (int)((m_degree + 1) * t));
+    const double peak = ModeWeight(mode, t);
+    double x = peak * pts[mode].x, y = peak * pts[mode].y;
+    double weight = peak;
+    for (int k = mode; k < m_degree; k++) {
+        weight *= (double)(m_degree - k) / (k + 1) * up;
+        if (weight < NEGLIGIBLE) break;
+        x += weight * pts[k + 1].x;
+        y += weight * pts[k + 1].y;
+    }
+    weight = peak;
+    for (int k = mode; k > 0; k--) {
+        weight *= (double)k / (m_degree - k + 1) * down;
+        if (weight < NEGLIGIBLE) break;
+        x += weight * pts[k - 1].x;
+        y += weight * pts[k - 1].y;
+    }
+    return BezierPoint(x, y);
+}
+
+CubicForwardDiffer::CubicForwardDiffer(const BezierPoint pts[4], int steps) {
+    // Power-basis form: P(t) = a t^3 + b t^2 + c t + d
+    double h = 1.0 / steps;
+    double h2 = h * h, h3 = h2 * h;
+
+    double ax = -pts[0].x + 3 * pts[1].x - 3 * pts[2].x + pts[3].x;
+    double ay = -pts[0].y + 3 * pts[1].y - 3 * pts[2].y + pts[3].y;
+    double bx = 3 * pts[0].x - 6 * pts[1].x + 3 * pts[2].x;
+    double by = 3 * pts[0].y - 6 * pts[1].y + 3 * pts[2].y;
+    double cx = 3 * (pts[1].x - pts[0].x);
+    double cy = 3 * (pts[1].y - pts[0].y);
+
+    m_p = pts[0];
+    m_d1 = BezierPoint(ax * h3 + bx * h2 + cx * h, ay * h3 + by * h2 + cy * h);
+    m_d2 = BezierPoint(6 * ax * h3 + 2 * bx * h2, 6 * ay * h3 + 2 * by * h2);
+    m_d3 = BezierPoint(6 * ax * h3, 6 * ay * h3);
+}
+
+// Plots a sample unless it rounds to the pixel just plotted
+template <typename Sink>
+static inline void PlotSample(Sink& sink, const BezierPoint& p, int& lastX, int& lastY, COLORREF color) {
+    int x = (int)round(p.x);
+    int y = (int)round(p.y);
+    if (x == lastX && y == lastY) return;
+    sink.Plot(x, y, color);
+    lastX = x;
+    lastY = y;
+}
+
+template <typename Sink>
+void DrawBezierCurve(Sink& sink, BezierPoint pts[], int numPoints, int steps, COLORREF color) {
     if (numPoints < 2 || steps < 1) return;
-    
-    double stepSize = 1.0 / steps;
-    for (double t = 0; t <= 1.0; t += stepSize) {
-        BezierPoint p = RecBezier(t, pts, 0, numPoints - 1);
-        SetPixel(hdc, (int)round(p.x), (int)round(p.y), color);
+
+    int lastX = INT_MIN, lastY = INT_MIN;
+    int degree = numPoints - 1;
+
+    if (numPoints == 4) {
+        CubicForwardDiffer curve(pts, steps);
+        for (int step = 0; step <= steps; step++) {
+            PlotSample(sink, curve.Current(), lastX, lastY, color);
+            curve.Next();
+        }
+    } else {
+        // Per-thread cache: repeated curves of the same shape reuse the table
+        thread_local BernsteinBasis basis;
+        if (!basis.Matches(degree, steps)) {
+            basis.Build(degree, steps);
+        }
+        for (int step = 0; step <= steps; step++) {
+            PlotSample(sink, basis.Evaluate(pts, step), lastX, lastY, color);
+        }
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawBezierCurve<Sink>(Sink&, BezierPoint[], int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawBezierCurve(HDC hdc, BezierPoint pts[], int numPoints, int steps, COLORREF color) {
+    GdiSink sink(hdc);
+    DrawBezierCurve(sink, pts, numPoints, steps, color);
+}
+#endif
@@ -1,11 +1,14 @@
 #include "../../include/CardinalSpline.h"
+#include "../../include/FrameArena.h"
 #include <cmath>
 #include <algorithm>
 
-void DrawCardinalSpline(HDC hdc, HermitePoint* points, int n, double c, int numPointsPerSegment, COLORREF color) {
+template <typename Sink>
+void DrawCardinalSpline(Sink& sink, HermitePoint* points, int n, double c, int numPointsPerSegment, COLORREF color) {
     if (n < 2) return;
 
-    HermitePoint* tangents = new HermitePoint[n];
+    ArenaScope scope;
+    HermitePoint* tangents = scope.Arena().Allocate<HermitePoint>(n);
 
     // First tangent
     tangents[0].x = (c / 2.0) * (points[1].x - points[0].x);
@@ -21,21 +24,32 @@ void DrawCardinalSpline(HDC hdc, HermitePoint* points, int n, double c, int numP
     tangents[n - 1].x = (c / 2.0) * (points[n - 1].x - points[n - 2].x);
     tangents[n - 1].y = (c / 2.0) * (points[n - 1].y - points[n - 2].y);
 
+    // All segments go through the batched Hermite kernel in one call
+    HermiteSegment* segments = scope.Arena().Allocate<HermiteSegment>(n - 1);
+    int* samples = scope.Arena().Allocate<int>(n - 1);
     for (int i = 0; i < n - 1; ++i) {
-    
         double dx = points[i + 1].x - points[i].x;
         double dy = points[i + 1].y - points[i].y;
         double distance = sqrt(dx * dx + dy * dy);
-        
-    
+
         int adaptivePoints = std::max(numPointsPerSegment, std::min(500, (int)(distance * 1.5) + 20));
-        
-        DrawHermiteCurve(hdc,
-                         points[i], tangents[i],
-                         points[i + 1], tangents[i + 1],
-                         adaptivePoints,
-                         color);
+
+        // Same per-segment count DrawHermiteCurve would pick
+        samples[i] = std::max(adaptivePoints, std::min(1000, (int)(distance * 2) + 10));
+        segments[i] = { points[i], tangents[i], points[i + 1], tangents[i + 1] };
     }
 
-    delete[] tangents;
-}
\ No newline at end of file
+    DrawHermiteSegments(sink, segments, samples, n - 1, color);
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawCardinalSpline<Sink>(Sink&, HermitePoint*, int, double, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawCardinalSpline(HDC hdc, HermitePoint* points, int n, double c, int numPointsPerSegment, COLORREF color) {
+    GdiSink sink(hdc);
+    DrawCardinalSpline(sink, points, n, c, numPointsPerSegment, color);
+}
+#endif
@@ -0,0 +1,265 @@
+#include "../../include/CurveTessellator.h"
+#include "../../include/FrameArena.h"
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+
+// Deep enough for any on-screen curve (2^16 segments)
+static const int MAX_SUBDIVISION_DEPTH = 16;
+
+// A split costs O(n^2) in the control points, so curves with more than this
+// many are flattened from points on the curve instead, O(sqrt(n)) each
+static const int MAX_SUBDIVIDED_POINTS = 12;
+
+// True when every interior control point is within sqrt(tolSq) of the chord
+static bool IsFlat(const BezierPoint pts[], int numPoints, double tolSq) {
+    const BezierPoint& a = pts[0];
+    const BezierPoint& b = pts[numPoints - 1];
+    double cx = b.x - a.x;
+    double cy = b.y - a.y;
+    double lenSq = cx * cx + cy * cy;
+
+    for (int i = 1; i < numPoints - 1; i++) {
+        double px = pts[i].x - a.x;
+        double py = pts[i].y - a.y;
+        double distSq;
+        if (lenSq < 1e-12) {
+            distSq = px * px + py * py;  // Closed or degenerate chord
+        } else {
+            double cross = px * cy - py * cx;
+            distSq = cross * cross / lenSq;
+        }
+        if (distSq > tolSq) return false;
+    }
+    return true;
+}
+
+// Split at t = 0.5 with de Casteljau. 'left' and 'right' get numPoints each.
+static void SplitHalf(const BezierPoint pts[], int numPoints, BezierPoint left[], BezierPoint right[],
+                      BezierPoint scratch[]) {
+    std::copy(pts, pts + numPoints, scratch);
+    left[0] = scratch[0];
+    right[numPoints - 1] = scratch[numPoints - 1];
+    for (int n = numPoints - 1, level = 1; n > 0; n--, level++) {
+        for (int i = 0; i < n; i++) {
+            scratch[i].x = 0.5 * (scratch[i].x + scratch[i + 1].x);
+            scratch[i].y = 0.5 * (scratch[i].y + scratch[i + 1].y);
+        }
+        left[level] = scratch[0];
+        right[numPoints - 1 - level] = scratch[n - 1];
+    }
+}
+
+// 'work' holds the halves of every level below this one (2 * numPoints
+// per level) followed by numPoints of split scratch
+static void FlattenRecursive(const BezierPoint pts[], int numPoints, double tolSq, int depth, BezierPoint work[],
+                             std::vector<BezierPoint>& out, CurveStats* stats) {
+    if (depth >= MAX_SUBDIVISION_DEPTH || IsFlat(pts, numPoints, tolSq)) {
+        out.push_back(pts[numPoints - 1]);
+        return;
+    }
+
+    BezierPoint* left = work + 2 * numPoints * depth;
+    BezierPoint* right = left + numPoints;
+    SplitHalf(pts, numPoints, left, right, work + 2 * numPoints * MAX_SUBDIVISION_DEPTH);
+    if (stats) stats->evaluations++;
+
+    FlattenRecursive(left, numPoints, tolSq, depth + 1, work, out, stats);
+    FlattenRecursive(right, numPoints, tolSq, depth + 1, work, out, stats);
+}
+
+// Squared distance from p to the segment a-b
+static double SegmentDistanceSq(const BezierPoint& p, const BezierPoint& a, const BezierPoint& b) {
+    double cx = b.x - a.x, cy = b.y - a.y;
+    double px = p.x - a.x, py = p.y - a.y;
+    double lenSq = cx * cx + cy * cy;
+    double u = lenSq < 1e-12 ? 0.0 : std::max(0.0, std::min(1.0, (px * cx + py * cy) / lenSq));
+    px -= u * cx;
+    py -= u * cy;
+    return px * px + py * py;
+}
+
+// Halve [t0, t1] until the curve's midpoint lies within sqrt(tolSq) of the
+// chord. Intervals above 'minDepth' are always halved: a degree n curve
+// turns at most about n times, so once there are 2n of them a chord can't
+// hide a turn behind a midpoint that happens to lie on it.
+static void FlattenSampled(const BernsteinBasis& basis, const BezierPoint pts[], double t0, const BezierPoint& p0,
+                           double t1, const BezierPoint& p1, double tolSq, int depth, int minDepth,
+                           std::vector<BezierPoint>& out, CurveStats* stats) {
+    if (depth >= MAX_SUBDIVISION_DEPTH) {
+        out.push_back(p1);
+        return;
+    }
+    const double tm = 0.5 * (t0 + t1);
+    const BezierPoint pm = basis.EvaluateAt(pts, tm);
+    if (stats) stats->evaluations++;
+    if (depth >= minDepth && SegmentDistanceSq(pm, p0, p1) <= tolSq) {
+        out.push_back(p1);
+        return;
+    }
+    FlattenSampled(basis, pts, t0, p0, tm, pm, tolSq, depth + 1, minDepth, out, stats);
+    FlattenSampled(basis, pts, tm, pm, t1, p1, tolSq, depth + 1, minDepth, out, stats);
+}
+
+void FlattenBezier(const BezierPoint pts[], int numPoints, double tolerance,
+                   std::vector<BezierPoint>& out, CurveStats* stats) {
+    if (numPoints < 2) return;
+    if (numPoints > MAX_SUBDIVIDED_POINTS) {
+        // Per thread, rebuilt only when the degree changes
+        thread_local BernsteinBasis basis;
+        const int degree = numPoints - 1;
+        if (basis.Degree() != degree) basis.Build(degree, 1);
+        int minDepth = 0;
+        while ((1 << minDepth) < 2 * degree && minDepth < MAX_SUBDIVISION_DEPTH) minDepth++;
+        FlattenSampled(basis, pts, 0.0, pts[0], 1.0, pts[degree], tolerance * tolerance, 0, minDepth, out, stats);
+        return;
+    }
+
+    // Room for the deepest split, from the thread's arena so no degree
+    // allocates
+    ArenaScope scope;
+    BezierPoint* work = scope.Arena().Allocate<BezierPoint>((2 * MAX_SUBDIVISION_DEPTH + 1) * numPoints);
+    FlattenRecursive(pts, numPoints, tolerance * tolerance, 0, work, out, stats);
+}
+
+void HermiteToBezier(HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1, BezierPoint out[4]) {
+    out[0] = BezierPoint(P0.x, P0.y);
+    out[1] = BezierPoint(P0.x + T0.x / 3.0, P0.y + T0.y / 3.0);
+    out[2] = BezierPoint(P1.x - T1.x / 3.0, P1.y - T1.y / 3.0);
+    out[3] = BezierPoint(P1.x, P1.y);
+}
+
+// Bresenham segment that leaves out its first pixel (already written as
+// the previous segment's end). Horizontal runs go out as a single span.
+template <typename Sink>
+static std::uint64_t DrawJoinedSegment(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c) {
+    int dx = abs(x2 - x1);
+    int dy = abs(y2 - y1);
+    int sx = (x1 < x2) ? 1 : -1;
+    int sy = (y1 < y2) ? 1 : -1;
+
+    if (dy == 0) {
+        int from = x1 + sx;
+        sink.Span(std::min(from, x2), std::max(from, x2), y1, c);
+        return (std::uint64_t)dx;
+    }
+
+    int err = dx - dy;
+    int x = x1, y = y1;
+    while (x != x2 || y != y2) {
+        int e2 = 2 * err;
+        if (e2 > -dy) { err -= dy; x += sx; }
+        if (e2 < dx) { err += dx; y += sy; }
+        sink.Plot(x, y, c);
+    }
+    return (std::uint64_t)std::max(dx, dy);
+}
+
+template <typename Sink>
+void DrawPolyline(Sink& sink, const BezierPoint pts[], int count, COLORREF color, CurveStats* stats) {
+    if (count < 1) return;
+
+    int lastX = (int)round(pts[0].x);
+    int lastY = (int)round(pts[0].y);
+    sink.Plot(lastX, lastY, color);
+    std::uint64_t pixels = 1, segments = 0;
+
+    for (int i = 1; i < count; i++) {
+        int x = (int)round(pts[i].x);
+        int y = (int)round(pts[i].y);
+        if (x == lastX && y == lastY) continue;
+        pixels += DrawJoinedSegment(sink, lastX, lastY, x, y, color);
+        segments++;
+        lastX = x;
+        lastY = y;
+    }
+
+    if (stats) {
+        stats->pixels += pixels;
+        stats->segments += segments;
+    }
+}
+
+// Reused per thread so steady-state drawing does not allocate
+static std::vector<BezierPoint>& PolylineBuffer() {
+    thread_local std::vector<BezierPoint> buffer;
+    buffer.clear();
+    return buffer;
+}
+
+template <typename Sink>
+void DrawBezierCurveAdaptive(Sink& sink, const BezierPoint pts[], int numPoints, COLORREF color,
+                             double tolerance, CurveStats* stats) {
+    if (numPoints < 2) return;
+
+    std::vector<BezierPoint>& polyline = PolylineBuffer();
+    polyline.push_back(pts[0]);
+    FlattenBezier(pts, numPoints, tolerance, polyline, stats);
+    DrawPolyline(sink, polyline.data(), (int)polyline.size(), color, stats);
+}
+
+template <typename Sink>
+void DrawHermiteCurveAdaptive(Sink& sink, HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1,
+                              COLORREF color, double tolerance, CurveStats* stats) {
+    BezierPoint bezier[4];
+    HermiteToBezier(P0, T0, P1, T1, bezier);
+    DrawBezierCurveAdaptive(sink, bezier, 4, color, tolerance, stats);
+}
+
+void FlattenCardinalSpline(const HermitePoint* points, int n, double c, double tolerance,
+                           std::vector<BezierPoint>& out, CurveStats* stats) {
+    if (n < 2) return;
+
+    // Same tangents as DrawCardinalSpline: one-sided at the ends
+    auto tangent = [&](int i) {
+        int prev = std::max(i - 1, 0);
+        int next = std::min(i + 1, n - 1);
+        return HermitePoint((c / 2.0) * (points[next].x - points[prev].x),
+                            (c / 2.0) * (points[next].y - points[prev].y));
+    };
+
+    HermitePoint t0 = tangent(0);
+    for (int i = 0; i < n - 1; ++i) {
+        HermitePoint t1 = tangent(i + 1);
+        BezierPoint bezier[4];
+        HermiteToBezier(points[i], t0, points[i + 1], t1, bezier);
+        FlattenBezier(bezier, 4, tolerance, out, stats);
+        t0 = t1;
+    }
+}
+
+template <typename Sink>
+void DrawCardinalSplineAdaptive(Sink& sink, const HermitePoint* points, int n, double c, COLORREF color,
+                                double tolerance, CurveStats* stats) {
+    if (n < 2) return;
+
+    std::vector<BezierPoint>& polyline = PolylineBuffer();
+    polyline.push_back(BezierPoint(points[0].x, points[0].y));
+    FlattenCardinalSpline(points, n, c, tolerance, polyline, stats);
+    DrawPolyline(sink, polyline.data(), (int)polyline.size(), color, stats);
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawPolyline<Sink>(Sink&, const BezierPoint[], int, COLORREF, CurveStats*); \
+    template void DrawBezierCurveAdaptive<Sink>(Sink&, const BezierPoint[], int, COLORREF, double, CurveStats*); \
+    template void DrawHermiteCurveAdaptive<Sink>(Sink&, HermitePoint, HermitePoint, HermitePoint, HermitePoint, COLORREF, double, CurveStats*); \
+    template void DrawCardinalSplineAdaptive<Sink>(Sink&, const HermitePoint*, int, double, COLORREF, double, CurveStats*);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawBezierCurveAdaptive(HDC hdc, const BezierPoint pts[], int numPoints, COLORREF color) {
+    GdiSink sink(hdc);
+    DrawBezierCurveAdaptive(sink, pts, numPoints, color);
+}
+
+void DrawHermiteCurveAdaptive(HDC hdc, HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1, COLORREF color) {
+    GdiSink sink(hdc);
+    DrawHermiteCurveAdaptive(sink, P0, T0, P1, T1, color);
+}
+
+void DrawCardinalSplineAdaptive(HDC hdc, const HermitePoint* points, int n, double c, COLORREF color) {
+    GdiSink sink(hdc);
+    DrawCardinalSplineAdaptive(sink, points, n, c, color);
+}
+#endif
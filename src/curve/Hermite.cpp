@@ -1,6 +1,7 @@
 #include "../../include/Hermite.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 
 
 void GetHermiteCoeff(double p0, double t0, double p1, double t1, double* coeffs) {
@@ -15,8 +16,88 @@ double EvaluatePolynomial(double* coeffs, double t) {
     return coeffs[0]*t*t*t + coeffs[1]*t*t + coeffs[2]*t + coeffs[3];
 }
 
-void DrawHermiteCurve(
-    HDC hdc,
+// Forward differences of P(t) = a t^3 + b t^2 + c t + d for step h
+struct CubicDeltas {
+    double p, d1, d2, d3;
+};
+
+static CubicDeltas HermiteDeltas(double p0, double t0, double p1, double t1, double h) {
+    double coeffs[4];
+    GetHermiteCoeff(p0, t0, p1, t1, coeffs);
+    double h2 = h * h, h3 = h2 * h;
+
+    CubicDeltas deltas;
+    deltas.p = coeffs[3];
+    deltas.d1 = coeffs[0] * h3 + coeffs[1] * h2 + coeffs[2] * h;
+    deltas.d2 = 6 * coeffs[0] * h3 + 2 * coeffs[1] * h2;
+    deltas.d3 = 6 * coeffs[0] * h3;
+    return deltas;
+}
+
+// Q23.40 fixed point: 64-bit integers with 40 fractional bits
+static const int FIXED_SHIFT = 40;
+static const double FIXED_ONE = (double)(1LL << FIXED_SHIFT);
+static const double FIXED_MAX_COORD = (double)(1 << 21);
+
+static inline std::int64_t ToFixed(double v) {
+    return (std::int64_t)llround(v * FIXED_ONE);
+}
+
+static bool FitsFixedPoint(const HermiteSegment& s) {
+    const HermitePoint* values[] = { &s.P0, &s.T0, &s.P1, &s.T1 };
+    for (const HermitePoint* v : values) {
+        if (std::fabs(v->x) >= FIXED_MAX_COORD || std::fabs(v->y) >= FIXED_MAX_COORD) return false;
+    }
+    return true;
+}
+
+template <typename Sink>
+static void DrawSegmentDouble(Sink& sink, const HermiteSegment& s, int count, COLORREF color) {
+    double h = 1.0 / (count - 1);
+    CubicDeltas x = HermiteDeltas(s.P0.x, s.T0.x, s.P1.x, s.T1.x, h);
+    CubicDeltas y = HermiteDeltas(s.P0.y, s.T0.y, s.P1.y, s.T1.y, h);
+
+    for (int i = 0; i < count; ++i) {
+        sink.Plot((int)round(x.p), (int)round(y.p), color);
+        x.p += x.d1; x.d1 += x.d2; x.d2 += x.d3;
+        y.p += y.d1; y.d1 += y.d2; y.d2 += y.d3;
+    }
+}
+
+template <typename Sink>
+static void DrawSegmentFixed(Sink& sink, const HermiteSegment& s, int count, COLORREF color) {
+    double h = 1.0 / (count - 1);
+    CubicDeltas x = HermiteDeltas(s.P0.x, s.T0.x, s.P1.x, s.T1.x, h);
+    CubicDeltas y = HermiteDeltas(s.P0.y, s.T0.y, s.P1.y, s.T1.y, h);
+
+    // Rounding bias folded into the start value so each step is add + shift
+    const std::int64_t half = 1LL << (FIXED_SHIFT - 1);
+    std::int64_t px = ToFixed(x.p) + half, dx1 = ToFixed(x.d1), dx2 = ToFixed(x.d2), dx3 = ToFixed(x.d3);
+    std::int64_t py = ToFixed(y.p) + half, dy1 = ToFixed(y.d1), dy2 = ToFixed(y.d2), dy3 = ToFixed(y.d3);
+
+    for (int i = 0; i < count; ++i) {
+        sink.Plot((int)(px >> FIXED_SHIFT), (int)(py >> FIXED_SHIFT), color);
+        px += dx1; dx1 += dx2; dx2 += dx3;
+        py += dy1; dy1 += dy2; dy2 += dy3;
+    }
+}
+
+template <typename Sink>
+void DrawHermiteSegments(Sink& sink, const HermiteSegment segments[], const int samples[], int numSegments,
+                         COLORREF color, bool fixedPoint) {
+    for (int i = 0; i < numSegments; ++i) {
+        int count = samples[i];
+        if (count < 2) continue;
+        if (fixedPoint && FitsFixedPoint(segments[i])) {
+            DrawSegmentFixed(sink, segments[i], count, color);
+        } else {
+            DrawSegmentDouble(sink, segments[i], count, color);
+        }
+    }
+}
+
+template <typename Sink>
+void DrawHermiteCurve(Sink& sink,
     HermitePoint P0, HermitePoint T0,
     HermitePoint P1, HermitePoint T1,
     int numpoints,
@@ -24,22 +105,25 @@ void DrawHermiteCurve(
 {
     if (numpoints < 2) return;
 
-    double xcoeff[4], ycoeff[4];
-    GetHermiteCoeff(P0.x, T0.x, P1.x, T1.x, xcoeff);
-    GetHermiteCoeff(P0.y, T0.y, P1.y, T1.y, ycoeff);
-
     double dx = P1.x - P0.x;
     double dy = P1.y - P0.y;
     double distance = sqrt(dx * dx + dy * dy);
     
     int adaptivePoints = std::max(numpoints, std::min(1000, (int)(distance * 2) + 10));
-    
-    double dt = 1.0 / (adaptivePoints - 1);
 
-    for (int i = 0; i < adaptivePoints; ++i) {
-        double t = i * dt;
-        int x = (int)round(EvaluatePolynomial(xcoeff, t));
-        int y = (int)round(EvaluatePolynomial(ycoeff, t));
-        SetPixel(hdc, x, y, color);
-    }
+    HermiteSegment segment = { P0, T0, P1, T1 };
+    DrawHermiteSegments(sink, &segment, &adaptivePoints, 1, color);
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawHermiteCurve<Sink>(Sink&, HermitePoint, HermitePoint, HermitePoint, HermitePoint, int, COLORREF); \
+    template void DrawHermiteSegments<Sink>(Sink&, const HermiteSegment[], const int[], int, COLORREF, bool);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawHermiteCurve(HDC hdc, HermitePoint P0, HermitePoint T0, HermitePoint P1, HermitePoint T1, int numpoints, COLORREF color) {
+    GdiSink sink(hdc);
+    DrawHermiteCurve(sink, P0, T0, P1, T1, numpoints, color);
 }
+#endif
@@ -1,16 +1,16 @@
-#include <windows.h>
 #include "../../include/EllipseAlgorithms.h"
 
 
 // Ellipse Midpoint Algorithm (Bresenham)
-void DrawEllipseBresenham(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
+template <typename Sink>
+void DrawEllipseBresenham(Sink& sink, int xc, int yc, int a, int b, COLORREF c) {
     int x = 0, y = b;
     long a2 = a * a, b2 = b * b;
     long d;
 
     // Region 1: |slope| <= 1 (x-dominant)
     d = b2 - a2 * b + a2 / 4;
-    DrawEllipsePoint(hdc, xc, yc, x, y, c);
+    DrawEllipsePoint(sink, xc, yc, x, y, c);
 
     while (b2 * x < a2 * y) {
         if (d < 0) {
@@ -20,7 +20,7 @@ void DrawEllipseBresenham(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
             d += b2 * (2 * x + 3) + a2 * (-2 * y + 2);
             x++; y--;
         }
-        DrawEllipsePoint(hdc, xc, yc, x, y, c);
+        DrawEllipsePoint(sink, xc, yc, x, y, c);
     }
 
     // Region 2: |slope| > 1 (y-dominant)
@@ -34,6 +34,18 @@ void DrawEllipseBresenham(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
             d += a2 * (-2 * y + 3);
             y--;
         }
-        DrawEllipsePoint(hdc, xc, yc, x, y, c);
+        DrawEllipsePoint(sink, xc, yc, x, y, c);
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawEllipseBresenham<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawEllipseBresenham(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawEllipseBresenham(sink, xc, yc, a, b, c);
+}
+#endif
@@ -1,22 +1,15 @@
-#include <windows.h>
 #include <cmath>
 #include "../../include/EllipseAlgorithms.h"
 #include "../../include/Utils.h"
 
-void DrawEllipsePoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c) {
-    SetPixel(hdc, xc+x, yc+y, c);
-    SetPixel(hdc, xc-x, yc+y, c);
-    SetPixel(hdc, xc-x, yc-y, c);
-    SetPixel(hdc, xc+x, yc-y, c);
-}
-
-void DrawDirectEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
+template <typename Sink>
+void DrawDirectEllipse(Sink& sink, int xc, int yc, int a, int b, COLORREF c) {
     int x, y;
 
     // Region 1: |slope| <= 1, loop on x
     for (x = 0; x <= a; x++) {
         y = Round(b * sqrt(1.0 - (x*x)/(double)(a*a)));
-        DrawEllipsePoint(hdc, xc, yc, x, y, c);
+        DrawEllipsePoint(sink, xc, yc, x, y, c);
 
         // Check if slope > 1, then break
         if (a*a * (y-0.5) < b*b * (x+1)) break;
@@ -25,6 +18,23 @@ void DrawDirectEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
     // Region 2: |slope| > 1, loop on y
     for (y = Round(b * sqrt(1.0 - (x*x)/(double)(a*a))); y >= 0; y--) {
         x = Round(a * sqrt(1.0 - (y*y)/(double)(b*b)));
-        DrawEllipsePoint(hdc, xc, yc, x, y, c);
+        DrawEllipsePoint(sink, xc, yc, x, y, c);
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawDirectEllipse<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawEllipsePoint(HDC hdc, int xc, int yc, int x, int y, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawEllipsePoint(sink, xc, yc, x, y, c);
+}
+
+void DrawDirectEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawDirectEllipse(sink, xc, yc, a, b, c);
+}
+#endif
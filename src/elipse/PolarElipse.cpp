@@ -1,4 +1,3 @@
-#include <windows.h>
 #include <cmath>
 #include <algorithm>
 #include "../../include/EllipseAlgorithms.h"
@@ -6,7 +5,8 @@
 
 
 
-void DrawPolarEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
+template <typename Sink>
+void DrawPolarEllipse(Sink& sink, int xc, int yc, int a, int b, COLORREF c) {
     double theta = 0;
     double dtheta = 1.0 / std::max(a, b);  // Adaptive step size
     int x, y;
@@ -15,7 +15,7 @@ void DrawPolarEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
     while (theta <= PI/2) {
         x = Round(a * cos(theta));
         y = Round(b * sin(theta));
-        DrawEllipsePoint(hdc, xc, yc, x, y, c);
+        DrawEllipsePoint(sink, xc, yc, x, y, c);
 
         // Check slope condition: dy/dx = -(b²x)/(a²y)
         // |slope| > 1 when b²x > a²y
@@ -29,7 +29,19 @@ void DrawPolarEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
     while (theta <= PI/2) {
         x = Round(a * cos(theta));
         y = Round(b * sin(theta));
-        DrawEllipsePoint(hdc, xc, yc, x, y, c);
+        DrawEllipsePoint(sink, xc, yc, x, y, c);
         theta += dtheta;
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawPolarEllipse<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawPolarEllipse(HDC hdc, int xc, int yc, int a, int b, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawPolarEllipse(sink, xc, yc, a, b, c);
+}
+#endif
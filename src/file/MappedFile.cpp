@@ -0,0 +1,99 @@
+#include "../../include/MappedFile.h"
+#include "../../include/Color.h"
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GFX_MMAP_POSIX
+#elif defined(GFX_WITH_GDI)
+#define GFX_MMAP_WIN32
+#endif
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+#if defined(GFX_MMAP_POSIX)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    m_size = (std::size_t)info.st_size;
+    if (m_size > 0) {
+        // The mapping keeps the file open after the descriptor is closed
+        void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            m_size = 0;
+            return false;
+        }
+        m_data = static_cast<const char*>(data);
+        m_mapped = true;
+    } else {
+        ::close(fd);
+    }
+    return true;
+#elif defined(GFX_MMAP_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    m_size = (std::size_t)size.QuadPart;
+    if (m_size > 0) {
+        // The view keeps the file open after both handles are closed
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            m_size = 0;
+            return false;
+        }
+        m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+        if (!m_data) {
+            m_size = 0;
+            return false;
+        }
+        m_mapped = true;
+    } else {
+        CloseHandle(file);
+    }
+    return true;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    std::streamoff size = in.tellg();
+    if (size < 0) return false;
+    in.seekg(0);
+    m_copy.resize((std::size_t)size);
+    if (size > 0 && !in.read(m_copy.data(), size)) {
+        m_copy = std::vector<char>();
+        return false;
+    }
+    m_data = m_copy.data();
+    m_size = m_copy.size();
+    return true;
+#endif
+}
+
+void MappedFile::Close() {
+    if (m_mapped) {
+#if defined(GFX_MMAP_POSIX)
+        ::munmap(const_cast<char*>(m_data), m_size);
+#elif defined(GFX_MMAP_WIN32)
+        UnmapViewOfFile(m_data);
+#endif
+    }
+    m_copy = std::vector<char>();
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
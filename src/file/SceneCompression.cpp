@@ -0,0 +1,217 @@
+#include "../../include/SceneCompression.h"
+#include <cstdint>
+#include <cstring>
+
+// ========================================
+// POINT DELTAS
+// ========================================
+
+static std::uint32_t ZigZag(std::uint32_t delta) {
+    return (delta << 1) ^ (0u - (delta >> 31));
+}
+
+static std::uint32_t UnZigZag(std::uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1));
+}
+
+static unsigned ByteLength(std::uint32_t value) {
+    return value < (1u << 8) ? 1 : value < (1u << 16) ? 2 : value < (1u << 24) ? 3 : 4;
+}
+
+// Per control byte: where each value starts in its group, and the group's length
+struct GroupTable {
+    unsigned char offsets[256][4];
+    unsigned char lengths[256];
+
+    GroupTable() {
+        for (unsigned control = 0; control < 256; control++) {
+            unsigned offset = 0;
+            for (unsigned k = 0; k < 4; k++) {
+                offsets[control][k] = (unsigned char)offset;
+                offset += ((control >> (2 * k)) & 3) + 1;
+            }
+            lengths[control] = (unsigned char)offset;
+        }
+    }
+};
+
+static const std::uint32_t LENGTH_MASKS[4] = { 0xFFu, 0xFFFFu, 0xFFFFFFu, 0xFFFFFFFFu };
+
+void EncodePointDeltas(const Point* points, std::size_t count, std::vector<unsigned char>& out) {
+    const std::size_t groups = (2 * count + 3) / 4;
+    std::size_t control = out.size();
+    out.resize(control + groups);
+
+    std::uint32_t previousX = 0, previousY = 0;
+    std::uint32_t values[4];
+    for (std::size_t g = 0; g < groups; g++) {
+        for (unsigned k = 0; k < 4; k++) {
+            std::size_t v = 4 * g + k;
+            values[k] = 0;
+            if (v >= 2 * count) continue;
+            std::uint32_t coordinate = (std::uint32_t)((v & 1) ? points[v / 2].y : points[v / 2].x);
+            std::uint32_t& previous = (v & 1) ? previousY : previousX;
+            values[k] = ZigZag(coordinate - previous);
+            previous = coordinate;
+        }
+
+        unsigned char lengths = 0;
+        for (unsigned k = 0; k < 4; k++) {
+            unsigned length = ByteLength(values[k]);
+            lengths |= (unsigned char)((length - 1) << (2 * k));
+            for (unsigned b = 0; b < length; b++) out.push_back((unsigned char)(values[k] >> (8 * b)));
+        }
+        out[control + g] = lengths;
+    }
+}
+
+bool DecodePointDeltas(const unsigned char* data, std::size_t size, Point* points, std::size_t count) {
+    static const GroupTable table;  // Thread-safe one-time init
+
+    const std::size_t groups = (2 * count + 3) / 4;
+    if (size < groups) return false;
+    const unsigned char* control = data;
+    const unsigned char* p = data + groups;
+    const unsigned char* end = data + size;
+
+    std::uint32_t x = 0, y = 0;
+    std::uint32_t values[4];
+    for (std::size_t g = 0; g < groups; g++) {
+        const unsigned lengths = control[g];
+        const std::size_t groupLength = table.lengths[lengths];
+        if ((std::size_t)(end - p) >= 16) {
+            // Four unaligned loads, each masked to its value's length
+            for (unsigned k = 0; k < 4; k++) {
+                std::uint32_t word;
+                std::memcpy(&word, p + table.offsets[lengths][k], 4);
+                values[k] = word & LENGTH_MASKS[(lengths >> (2 * k)) & 3];
+            }
+        } else {
+            // Near the end a 4-byte load could run past the data
+            if (groupLength > (std::size_t)(end - p)) return false;
+            for (unsigned k = 0; k < 4; k++) {
+                const unsigned char* q = p + table.offsets[lengths][k];
+                unsigned length = ((lengths >> (2 * k)) & 3) + 1;
+                values[k] = 0;
+                for (unsigned b = 0; b < length; b++) values[k] |= (std::uint32_t)q[b] << (8 * b);
+            }
+        }
+        p += groupLength;
+
+        // A group is two points; the last may hold one point and padding
+        x += UnZigZag(values[0]);
+        y += UnZigZag(values[1]);
+        points[2 * g] = Point((int)x, (int)y);
+        if (2 * g + 1 < count) {
+            x += UnZigZag(values[2]);
+            y += UnZigZag(values[3]);
+            points[2 * g + 1] = Point((int)x, (int)y);
+        } else if (values[2] != 0 || values[3] != 0) {
+            return false;
+        }
+    }
+    // Every data byte must belong to a value
+    return p == end;
+}
+
+// ========================================
+// LZ77 BLOCKS
+// ========================================
+
+static const std::size_t MIN_MATCH = 4;
+static const std::size_t MAX_OFFSET = 65535;
+static const int HASH_BITS = 14;
+
+static std::uint32_t Read32(const unsigned char* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, 4);
+    return value;
+}
+
+static std::uint32_t Hash(std::uint32_t value) {
+    return (value * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static void PutLength(std::vector<unsigned char>& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back((unsigned char)length);
+}
+
+static void PutSequence(std::vector<unsigned char>& out, const unsigned char* literals, std::size_t literalCount,
+                        std::size_t offset, std::size_t matchLength) {
+    const std::size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+    out.push_back((unsigned char)((literalCount < 15 ? literalCount : 15) << 4 | (matchCode < 15 ? matchCode : 15)));
+    if (literalCount >= 15) PutLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (matchLength == 0) return;
+    out.push_back((unsigned char)offset);
+    out.push_back((unsigned char)(offset >> 8));
+    if (matchCode >= 15) PutLength(out, matchCode - 15);
+}
+
+void CompressBlock(const unsigned char* data, std::size_t size, std::vector<unsigned char>& out) {
+    // Positions + 1 of the last 4 bytes seen with each hash; 0 is none
+    std::vector<std::uint32_t> seen(std::size_t(1) << HASH_BITS, 0);
+    std::size_t anchor = 0, i = 0;
+    while (i + MIN_MATCH <= size) {
+        const std::uint32_t word = Read32(data + i);
+        std::uint32_t& slot = seen[Hash(word)];
+        const std::size_t candidate = slot;
+        slot = (std::uint32_t)(i + 1);
+        if (candidate == 0 || i - (candidate - 1) > MAX_OFFSET || Read32(data + candidate - 1) != word) {
+            i++;
+            continue;
+        }
+
+        const std::size_t match = candidate - 1;
+        std::size_t length = MIN_MATCH;
+        while (i + length < size && data[match + length] == data[i + length]) length++;
+        PutSequence(out, data + anchor, i - anchor, i - match, length);
+        i += length;
+        anchor = i;
+    }
+    PutSequence(out, data + anchor, size - anchor, 0, 0);
+}
+
+// Add the length bytes that follow a code of 15
+static bool GetLength(const unsigned char*& p, const unsigned char* end, std::size_t& length) {
+    unsigned char byte;
+    do {
+        if (p == end) return false;
+        byte = *p++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool DecompressBlock(const unsigned char* data, std::size_t size, unsigned char* out, std::size_t outSize) {
+    const unsigned char* p = data;
+    const unsigned char* end = data + size;
+    std::size_t written = 0;
+    while (p < end) {
+        const unsigned token = *p++;
+        std::size_t literalCount = token >> 4;
+        if (literalCount == 15 && !GetLength(p, end, literalCount)) return false;
+        if (literalCount > (std::size_t)(end - p) || literalCount > outSize - written) return false;
+        std::memcpy(out + written, p, literalCount);
+        p += literalCount;
+        written += literalCount;
+        if (p == end) break;  // The last sequence
+
+        if (end - p < 2) return false;
+        const std::size_t offset = p[0] | (std::size_t)p[1] << 8;
+        p += 2;
+        std::size_t length = (token & 15) + MIN_MATCH;
+        if ((token & 15) == 15 && !GetLength(p, end, length)) return false;
+        if (offset == 0 || offset > written || length > outSize - written) return false;
+
+        // Byte by byte: a match may overlap the bytes it produces
+        const unsigned char* from = out + written - offset;
+        for (std::size_t k = 0; k < length; k++) out[written + k] = from[k];
+        written += length;
+    }
+    return written == outSize;
+}
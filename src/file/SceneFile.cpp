@@ -0,0 +1,716 @@
+#include "../../include/SceneFile.h"
+#include "../../include/MappedFile.h"
+#include "../../include/SceneCompression.h"
+#include "../../include/ShapeRenderer.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+static_assert(sizeof(Point) == 2 * sizeof(std::int32_t), "Point must be two packed 32-bit ints");
+static_assert(sizeof(FillSpan) == 3 * sizeof(std::int32_t), "FillSpan must be three packed 32-bit ints");
+static_assert(sizeof(PixelRect) == 4 * sizeof(std::int32_t), "PixelRect must be four packed 32-bit ints");
+static_assert(sizeof(ShapeGeometry) == 4 * sizeof(std::int32_t), "ShapeGeometry must be four packed 32-bit ints");
+static_assert(sizeof(COLORREF) == sizeof(std::uint32_t), "COLORREF must be 32 bits");
+
+template <typename T>
+static void WriteValue(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// ========================================
+// VERSION 1
+// ========================================
+
+bool WriteLegacyScene(std::ostream& out, const Scene& scene) {
+    WriteValue<std::int32_t>(out, (std::int32_t)scene.Size());
+
+    for (std::size_t i = 0; i < scene.Size(); ++i) {
+        const ShapeView shape = scene.View(i);
+        WriteValue<std::int32_t>(out, (std::int32_t)shape.mode);
+        WriteValue<std::uint32_t>(out, (std::uint32_t)shape.color);
+        WriteValue<std::int32_t>(out, (std::int32_t)shape.fillMode);
+        WriteValue<std::int32_t>(out, (std::int32_t)shape.thickness);
+
+        std::int32_t pointCnt = (std::int32_t)shape.points.size();
+        WriteValue(out, pointCnt);
+        if (pointCnt > 0) {
+            out.write(reinterpret_cast<const char*>(shape.points.data()), pointCnt * sizeof(Point));
+        }
+
+        if (shape.mode == DrawingMode::FLOOD_FILL) {
+            std::int32_t spanCnt = (std::int32_t)shape.spans.size();
+            WriteValue(out, spanCnt);
+            if (spanCnt > 0) {
+                out.write(reinterpret_cast<const char*>(shape.spans.data()), spanCnt * sizeof(FillSpan));
+            }
+        }
+    }
+    return (bool)out;
+}
+
+// Bounds-checked reader over a file held in memory
+class FileCursor {
+public:
+    FileCursor(const char* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (m_size - m_pos < sizeof(T)) return false;
+        std::memcpy(&value, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    // Step over 'count' records of 'size' bytes; returns where they start,
+    // or nullptr if the file ends first
+    const char* Take(std::int32_t count, std::size_t size) {
+        if (count < 0 || (std::size_t)count > (m_size - m_pos) / size) return nullptr;
+        const char* start = m_data + m_pos;
+        m_pos += (std::size_t)count * size;
+        return start;
+    }
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_pos = 0;
+};
+
+// One shape as laid out in the file
+struct ShapeRecord {
+    std::int32_t mode, fillMode, thickness, pointCnt, spanCnt;
+    std::uint32_t color;
+    const char* points;
+    const char* spans;
+};
+
+static bool NextShape(FileCursor& cursor, ShapeRecord& record) {
+    if (!cursor.Read(record.mode) || !cursor.Read(record.color) || !cursor.Read(record.fillMode) ||
+        !cursor.Read(record.thickness) || !cursor.Read(record.pointCnt)) {
+        return false;
+    }
+    record.points = cursor.Take(record.pointCnt, sizeof(Point));
+    if (!record.points) return false;
+    record.spanCnt = 0;
+    record.spans = nullptr;
+    if ((DrawingMode)record.mode == DrawingMode::FLOOD_FILL) {
+        if (!cursor.Read(record.spanCnt)) return false;
+        record.spans = cursor.Take(record.spanCnt, sizeof(FillSpan));
+        if (!record.spans) return false;
+    }
+    return true;
+}
+
+// Modes must be ones this build knows, as in a version 2 file, and spans
+// must run left to right
+static bool RecordValid(const ShapeRecord& record) {
+    if (record.mode < 0 || record.mode > (std::int32_t)DrawingMode::FLOOD_FILL || record.fillMode < 0 ||
+        record.fillMode > (std::int32_t)FillMode::ANTIALIASED_NON_ZERO) {
+        return false;
+    }
+    for (std::int32_t k = 0; k < record.spanCnt; ++k) {
+        FillSpan span;
+        std::memcpy(&span, record.spans + k * sizeof(FillSpan), sizeof(FillSpan));
+        if (span.x1 > span.x2) return false;
+    }
+    return true;
+}
+
+static void AddRecord(Scene& scene, const ShapeRecord& record) {
+    // Copied out because the file's arrays may not be aligned
+    thread_local std::vector<Point> points;
+    thread_local std::vector<FillSpan> spans;
+    points.resize(record.pointCnt);
+    spans.resize(record.spanCnt);
+    if (record.pointCnt > 0) std::memcpy(points.data(), record.points, record.pointCnt * sizeof(Point));
+    if (record.spanCnt > 0) std::memcpy(spans.data(), record.spans, record.spanCnt * sizeof(FillSpan));
+
+    ShapeView shape;
+    shape.mode = (DrawingMode)record.mode;
+    shape.color = (COLORREF)record.color;
+    shape.fillMode = (FillMode)record.fillMode;
+    shape.thickness = record.thickness;
+    shape.points = points;
+    shape.spans = spans;
+    scene.Add(shape);
+}
+
+static bool ReadLegacyScene(const char* data, std::size_t size, Scene& scene) {
+    // First pass: validate the whole file and total up the arenas, so the
+    // scene is sized once and nothing is built from a file that fails
+    FileCursor cursor(data, size);
+    std::int32_t shapeCnt = 0;
+    if (!cursor.Read(shapeCnt) || shapeCnt < 0) return false;
+    std::size_t pointTotal = 0, spanTotal = 0;
+    ShapeRecord record;
+    for (std::int32_t i = 0; i < shapeCnt; ++i) {
+        if (!NextShape(cursor, record) || !RecordValid(record)) return false;
+        pointTotal += record.pointCnt;
+        spanTotal += record.spanCnt;
+    }
+
+    // Second pass: add the shapes, which can no longer fail
+    Scene loaded;
+    loaded.Reserve(shapeCnt, pointTotal, spanTotal);
+    cursor = FileCursor(data, size);
+    cursor.Read(shapeCnt);
+    for (std::int32_t i = 0; i < shapeCnt; ++i) {
+        NextShape(cursor, record);
+        AddRecord(loaded, record);
+    }
+
+    scene = std::move(loaded);
+    return true;
+}
+
+// ========================================
+// VERSION 2
+// ========================================
+
+static const char MAGIC[8] = { 'G', 'F', 'X', 'S', 'C', 'E', 'N', 'E' };
+static const std::uint32_t VERSION = 2;
+static const std::uint64_t CHUNK_ALIGNMENT = 64;
+
+// Header flags. A file with either is compact: it leaves out the derived
+// columns and is decoded into memory on load rather than mapped.
+static const std::uint32_t FLAG_DELTA_POINTS = 1;
+static const std::uint32_t FLAG_COMPRESSED_TABLE = 2;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version, headerSize;
+    std::uint32_t chunkCount, flags;
+    std::uint64_t shapeCount, pointCount, spanCount;
+    std::uint64_t reserved;  // Written as 0, ignored on read
+    std::uint64_t fileSize;
+};
+static_assert(sizeof(FileHeader) == 64, "FileHeader must be packed");
+
+struct ChunkEntry {
+    std::uint32_t id, elementSize;
+    std::uint64_t offset, count;
+};
+static_assert(sizeof(ChunkEntry) == 24, "ChunkEntry must be packed");
+
+static constexpr std::uint32_t ChunkId(const char (&name)[5]) {
+    return (std::uint32_t)(unsigned char)name[0] | (std::uint32_t)(unsigned char)name[1] << 8 |
+           (std::uint32_t)(unsigned char)name[2] << 16 | (std::uint32_t)(unsigned char)name[3] << 24;
+}
+
+enum ChunkCount { PER_SHAPE, PER_SHAPE_PLUS_ONE, PER_POINT, PER_SPAN, ENCODED_BYTES };
+
+// Which files hold a chunk
+enum ChunkRole {
+    DERIVED,           // Mapped files only; compact files recompute it
+    TABLE,             // Files without FLAG_COMPRESSED_TABLE
+    POINTS,            // Files without FLAG_DELTA_POINTS
+    DELTA_POINTS,      // Files with FLAG_DELTA_POINTS
+    COMPRESSED_TABLE,  // Files with FLAG_COMPRESSED_TABLE
+};
+
+struct ChunkSpec {
+    std::uint32_t id;
+    std::uint32_t elementSize;
+    std::uint32_t alignment;
+    ChunkCount count;
+    ChunkRole role;
+};
+
+// The Scene's columns in the order they are written, then their encoded forms
+enum ChunkIndex {
+    MODE_CHUNK, FILL_CHUNK, BOUNDED_CHUNK, COLOR_CHUNK, THICKNESS_CHUNK, BOUNDS_CHUNK, GEOMETRY_CHUNK,
+    POINT_START_CHUNK, SPAN_START_CHUNK, POINTS_CHUNK, SPANS_CHUNK,
+    DELTA_POINTS_CHUNK, COMPRESSED_TABLE_CHUNK, CHUNK_COUNT
+};
+static const int COLUMN_COUNT = DELTA_POINTS_CHUNK;
+
+static const ChunkSpec CHUNKS[] = {
+    { ChunkId("MODE"), 1, 1, PER_SHAPE, TABLE },
+    { ChunkId("FILL"), 1, 1, PER_SHAPE, TABLE },
+    { ChunkId("BNDF"), 1, 1, PER_SHAPE, DERIVED },
+    { ChunkId("COLR"), 4, 4, PER_SHAPE, TABLE },
+    { ChunkId("THCK"), 4, 4, PER_SHAPE, TABLE },
+    { ChunkId("BNDS"), sizeof(PixelRect), 4, PER_SHAPE, DERIVED },
+    { ChunkId("GEOM"), sizeof(ShapeGeometry), 4, PER_SHAPE, DERIVED },
+    { ChunkId("PSTR"), 4, 4, PER_SHAPE_PLUS_ONE, TABLE },
+    { ChunkId("SSTR"), 4, 4, PER_SHAPE_PLUS_ONE, TABLE },
+    { ChunkId("PNTS"), sizeof(Point), 4, PER_POINT, POINTS },
+    { ChunkId("SPNS"), sizeof(FillSpan), 4, PER_SPAN, TABLE },
+    { ChunkId("PDLT"), 1, 1, ENCODED_BYTES, DELTA_POINTS },
+    { ChunkId("ZTAB"), 1, 1, ENCODED_BYTES, COMPRESSED_TABLE },
+};
+static_assert(sizeof(CHUNKS) / sizeof(CHUNKS[0]) == CHUNK_COUNT, "one spec per chunk");
+
+static bool InFile(ChunkRole role, std::uint32_t flags) {
+    switch (role) {
+        case DERIVED: return flags == 0;
+        case TABLE: return !(flags & FLAG_COMPRESSED_TABLE);
+        case POINTS: return !(flags & FLAG_DELTA_POINTS);
+        case DELTA_POINTS: return (flags & FLAG_DELTA_POINTS) != 0;
+        default: return (flags & FLAG_COMPRESSED_TABLE) != 0;
+    }
+}
+
+// Column data in CHUNKS order
+static void ColumnData(const SceneColumns& columns, const void* data[COLUMN_COUNT]) {
+    const void* ordered[] = { columns.modes, columns.fillModes, columns.bounded, columns.colors,
+                              columns.thickness, columns.bounds, columns.geometry, columns.pointStart,
+                              columns.spanStart, columns.points, columns.spans };
+    static_assert(sizeof(ordered) / sizeof(ordered[0]) == COLUMN_COUNT, "one column per chunk");
+    std::copy(ordered, ordered + COLUMN_COUNT, data);
+}
+
+static void SetColumnData(SceneColumns& columns, const char* const data[COLUMN_COUNT]) {
+    columns.modes = reinterpret_cast<const std::uint8_t*>(data[MODE_CHUNK]);
+    columns.fillModes = reinterpret_cast<const std::uint8_t*>(data[FILL_CHUNK]);
+    columns.bounded = reinterpret_cast<const std::uint8_t*>(data[BOUNDED_CHUNK]);
+    columns.colors = reinterpret_cast<const COLORREF*>(data[COLOR_CHUNK]);
+    columns.thickness = reinterpret_cast<const std::int32_t*>(data[THICKNESS_CHUNK]);
+    columns.bounds = reinterpret_cast<const PixelRect*>(data[BOUNDS_CHUNK]);
+    columns.geometry = reinterpret_cast<const ShapeGeometry*>(data[GEOMETRY_CHUNK]);
+    columns.pointStart = reinterpret_cast<const std::uint32_t*>(data[POINT_START_CHUNK]);
+    columns.spanStart = reinterpret_cast<const std::uint32_t*>(data[SPAN_START_CHUNK]);
+    columns.points = reinterpret_cast<const Point*>(data[POINTS_CHUNK]);
+    columns.spans = reinterpret_cast<const FillSpan*>(data[SPANS_CHUNK]);
+}
+
+// Elements in a column chunk
+static std::uint64_t ElementCount(ChunkCount count, const FileHeader& header) {
+    switch (count) {
+        case PER_SHAPE: return header.shapeCount;
+        case PER_SHAPE_PLUS_ONE: return header.shapeCount + 1;
+        case PER_POINT: return header.pointCount;
+        default: return header.spanCount;
+    }
+}
+
+static std::uint64_t AlignChunk(std::uint64_t offset) {
+    return (offset + CHUNK_ALIGNMENT - 1) & ~(CHUNK_ALIGNMENT - 1);
+}
+
+static bool IsLittleEndian() {
+    const std::uint32_t one = 1;
+    unsigned char first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+// Shape i as the columns hold it
+static ShapeView ColumnView(const SceneColumns& c, std::size_t i) {
+    ShapeView shape;
+    shape.mode = (DrawingMode)c.modes[i];
+    shape.color = c.colors[i];
+    shape.fillMode = (FillMode)c.fillModes[i];
+    shape.thickness = c.thickness[i];
+    shape.points = ArrayView<Point>(c.points + c.pointStart[i], c.pointStart[i + 1] - c.pointStart[i]);
+    shape.spans = ArrayView<FillSpan>(c.spans + c.spanStart[i], c.spanStart[i + 1] - c.spanStart[i]);
+    return shape;
+}
+
+// The compressed table is the table columns back to back, with the start
+// columns written as per-shape counts, which repeat where offsets never do
+static std::uint64_t PackedTableBytes(const FileHeader& header) {
+    std::uint64_t bytes = 0;
+    for (int k = 0; k < COLUMN_COUNT; k++) {
+        if (CHUNKS[k].role != TABLE) continue;
+        std::uint64_t count = CHUNKS[k].count == PER_SHAPE_PLUS_ONE ? header.shapeCount
+                                                                     : ElementCount(CHUNKS[k].count, header);
+        bytes += count * CHUNKS[k].elementSize;
+    }
+    return bytes;
+}
+
+static void PackTable(const SceneColumns& columns, std::vector<unsigned char>& packed) {
+    const void* data[COLUMN_COUNT];
+    ColumnData(columns, data);
+    FileHeader header = {};
+    header.shapeCount = columns.shapeCount;
+    header.pointCount = columns.pointCount;
+    header.spanCount = columns.spanCount;
+    packed.reserve((std::size_t)PackedTableBytes(header));
+
+    for (int k = 0; k < COLUMN_COUNT; k++) {
+        if (CHUNKS[k].role != TABLE) continue;
+        const unsigned char* bytes = static_cast<const unsigned char*>(data[k]);
+        if (CHUNKS[k].count == PER_SHAPE_PLUS_ONE) {
+            const std::uint32_t* starts = static_cast<const std::uint32_t*>(data[k]);
+            for (std::size_t i = 0; i < columns.shapeCount; i++) {
+                const std::uint32_t count = starts[i + 1] - starts[i];
+                const unsigned char* countBytes = reinterpret_cast<const unsigned char*>(&count);
+                packed.insert(packed.end(), countBytes, countBytes + sizeof(count));
+            }
+        } else if (bytes) {
+            packed.insert(packed.end(), bytes, bytes + ElementCount(CHUNKS[k].count, header) * CHUNKS[k].elementSize);
+        }
+    }
+}
+
+// Spread a packed table of PackedTableBytes(header) over the columns,
+// summing the counts back into starts
+static bool UnpackTable(const unsigned char* packed, const FileHeader& header, char* const columns[COLUMN_COUNT]) {
+    for (int k = 0; k < COLUMN_COUNT; k++) {
+        if (CHUNKS[k].role != TABLE) continue;
+        if (CHUNKS[k].count == PER_SHAPE_PLUS_ONE) {
+            std::uint32_t* starts = reinterpret_cast<std::uint32_t*>(columns[k]);
+            std::uint64_t total = 0;
+            starts[0] = 0;
+            for (std::uint64_t i = 0; i < header.shapeCount; i++) {
+                std::uint32_t count;
+                std::memcpy(&count, packed, sizeof(count));
+                packed += sizeof(count);
+                total += count;
+                if (total > UINT32_MAX) return false;
+                starts[i + 1] = (std::uint32_t)total;
+            }
+        } else {
+            const std::size_t bytes = (std::size_t)(ElementCount(CHUNKS[k].count, header) * CHUNKS[k].elementSize);
+            std::memcpy(columns[k], packed, bytes);
+            packed += bytes;
+        }
+    }
+    return true;
+}
+
+bool WriteScene(std::ostream& out, const Scene& scene, const SceneFileOptions& options) {
+    if (!IsLittleEndian()) return false;
+    const SceneColumns columns = scene.Columns();
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(FileHeader);
+    header.flags = (options.deltaPoints ? FLAG_DELTA_POINTS : 0) | (options.compressTable ? FLAG_COMPRESSED_TABLE : 0);
+    header.shapeCount = columns.shapeCount;
+    header.pointCount = columns.pointCount;
+    header.spanCount = columns.spanCount;
+
+    const void* data[CHUNK_COUNT] = {};
+    ColumnData(columns, data);
+    std::vector<unsigned char> encoded[CHUNK_COUNT];
+    if (header.flags & FLAG_DELTA_POINTS) {
+        EncodePointDeltas(columns.points, columns.pointCount, encoded[DELTA_POINTS_CHUNK]);
+    }
+    if (header.flags & FLAG_COMPRESSED_TABLE) {
+        std::vector<unsigned char> packed;
+        PackTable(columns, packed);
+        CompressBlock(packed.data(), packed.size(), encoded[COMPRESSED_TABLE_CHUNK]);
+    }
+
+    std::vector<ChunkEntry> directory;
+    std::vector<const void*> chunkData;
+    for (int k = 0; k < CHUNK_COUNT; k++) {
+        if (!InFile(CHUNKS[k].role, header.flags)) continue;
+        if (CHUNKS[k].count == ENCODED_BYTES) {
+            directory.push_back({ CHUNKS[k].id, 1, 0, encoded[k].size() });
+            chunkData.push_back(encoded[k].data());
+        } else {
+            directory.push_back({ CHUNKS[k].id, CHUNKS[k].elementSize, 0, ElementCount(CHUNKS[k].count, header) });
+            chunkData.push_back(data[k]);
+        }
+    }
+    header.chunkCount = (std::uint32_t)directory.size();
+    std::uint64_t end = sizeof(FileHeader) + directory.size() * sizeof(ChunkEntry);
+    for (ChunkEntry& entry : directory) {
+        entry.offset = AlignChunk(end);
+        end = entry.offset + entry.count * entry.elementSize;
+    }
+    header.fileSize = end;
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(directory.data()), (std::streamsize)(directory.size() * sizeof(ChunkEntry)));
+    std::uint64_t position = sizeof(FileHeader) + directory.size() * sizeof(ChunkEntry);
+    const char padding[CHUNK_ALIGNMENT] = {};
+    for (std::size_t c = 0; c < directory.size(); c++) {
+        out.write(padding, (std::streamsize)(directory[c].offset - position));
+        std::uint64_t bytes = directory[c].count * directory[c].elementSize;
+        if (bytes > 0) out.write(static_cast<const char*>(chunkData[c]), (std::streamsize)bytes);
+        position = directory[c].offset + bytes;
+    }
+    return (bool)out;
+}
+
+static bool IsVersion2(const char* data, std::size_t size) {
+    return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+// Check a version 2 file's header and chunk directory against the file,
+// and find the chunks its flags call for. 'chunks' and 'counts' are
+// indexed like CHUNKS.
+static bool ReadDirectory(const char* data, std::size_t size, FileHeader& header, const char* chunks[CHUNK_COUNT],
+                          std::uint64_t counts[CHUNK_COUNT]) {
+    if (!IsLittleEndian() || size < sizeof(FileHeader)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != VERSION || header.headerSize < sizeof(FileHeader) || header.fileSize != size ||
+        header.headerSize > size || header.chunkCount > (size - header.headerSize) / sizeof(ChunkEntry) ||
+        (header.flags & ~(FLAG_DELTA_POINTS | FLAG_COMPRESSED_TABLE)) != 0) {
+        return false;
+    }
+    // Offsets are 32-bit in the start tables
+    if (header.shapeCount >= UINT32_MAX || header.pointCount > UINT32_MAX || header.spanCount > UINT32_MAX) {
+        return false;
+    }
+
+    std::fill(chunks, chunks + CHUNK_COUNT, nullptr);
+    for (std::uint32_t c = 0; c < header.chunkCount; c++) {
+        ChunkEntry entry;
+        std::memcpy(&entry, data + header.headerSize + c * sizeof(ChunkEntry), sizeof(entry));
+        int k = 0;
+        while (k < CHUNK_COUNT && CHUNKS[k].id != entry.id) k++;
+        if (k == CHUNK_COUNT) continue;  // A later version's chunk
+        const ChunkSpec& spec = CHUNKS[k];
+        if (!InFile(spec.role, header.flags) || chunks[k] || entry.elementSize != spec.elementSize ||
+            (spec.count != ENCODED_BYTES && entry.count != ElementCount(spec.count, header)) ||
+            entry.offset > size || entry.count > (size - entry.offset) / entry.elementSize ||
+            reinterpret_cast<std::uintptr_t>(data + entry.offset) % spec.alignment != 0) {
+            return false;
+        }
+        chunks[k] = data + entry.offset;
+        counts[k] = entry.count;
+    }
+    for (int k = 0; k < CHUNK_COUNT; k++) {
+        if (InFile(CHUNKS[k].role, header.flags) && !chunks[k]) return false;
+    }
+    return true;
+}
+
+// One pass over the shape table checking every shape's fields and its runs
+// of points and spans, so a scene adopting the columns can index anything
+// it finds there. With 'storedGeometry' the radii a shape
+// is drawn with and its bounds must also be the ones its points give: the
+// renderer and the shape index trust both, and a bound too small would
+// let a redraw miss the shape or a fill write past its region.
+static bool ValidateShapes(const SceneColumns& c, bool storedGeometry) {
+    if (c.pointStart[0] != 0 || c.spanStart[0] != 0 || c.pointStart[c.shapeCount] != c.pointCount ||
+        c.spanStart[c.shapeCount] != c.spanCount) {
+        return false;
+    }
+    for (std::size_t i = 0; i < c.shapeCount; i++) {
+        const DrawingMode mode = (DrawingMode)c.modes[i];
+        if (c.modes[i] > (std::uint8_t)DrawingMode::FLOOD_FILL ||
+            c.fillModes[i] > (std::uint8_t)FillMode::ANTIALIASED_NON_ZERO) {
+            return false;
+        }
+        const std::uint32_t p0 = c.pointStart[i], p1 = c.pointStart[i + 1];
+        const std::uint32_t s0 = c.spanStart[i], s1 = c.spanStart[i + 1];
+        // Each run must end inside its array, not only the last one: a
+        // later shape going backwards is only seen after this one is read
+        if (p1 < p0 || s1 < s0 || p1 > c.pointCount || s1 > c.spanCount) {
+            return false;
+        }
+
+        // Only recorded flood fills have spans
+        if (s1 > s0 && mode != DrawingMode::FLOOD_FILL) return false;
+        for (std::uint32_t k = s0; k < s1; k++) {
+            if (c.spans[k].x1 > c.spans[k].x2) return false;
+        }
+
+        if (!storedGeometry) continue;
+        ShapeView shape = ColumnView(c, i);
+        const ShapeGeometry expected = GetShapeGeometry(shape);
+        const ShapeGeometry& stored = c.geometry[i];
+        if (stored.center.x != expected.center.x || stored.center.y != expected.center.y ||
+            stored.rx != expected.rx || stored.ry != expected.ry) {
+            return false;
+        }
+        shape.geometry = &stored;
+        PixelRect bounds;
+        const bool bounded = GetShapeBounds(shape, bounds);
+        const PixelRect& storedBounds = c.bounds[i];
+        if (c.bounded[i] != (std::uint8_t)bounded || storedBounds.left != bounds.left ||
+            storedBounds.top != bounds.top || storedBounds.right != bounds.right ||
+            storedBounds.bottom != bounds.bottom) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Expand a compact file into memory laid out as the Scene's columns, check
+// it as a mapped file is checked, and work out the columns it leaves out
+static bool DecodeScene(const FileHeader& header, const char* const chunks[CHUNK_COUNT],
+                        const std::uint64_t counts[CHUNK_COUNT], Scene& scene) {
+    // Neither encoding can expand further than this, so a header claiming
+    // more is refused before anything is allocated for it
+    const std::uint64_t packedBytes = PackedTableBytes(header);
+    if ((header.flags & FLAG_COMPRESSED_TABLE) && packedBytes / 255 > counts[COMPRESSED_TABLE_CHUNK]) return false;
+    if ((header.flags & FLAG_DELTA_POINTS) && header.pointCount / 2 > counts[DELTA_POINTS_CHUNK]) return false;
+
+    std::uint64_t offsets[COLUMN_COUNT], total = 0;
+    for (int k = 0; k < COLUMN_COUNT; k++) {
+        offsets[k] = AlignChunk(total);
+        total = offsets[k] + ElementCount(CHUNKS[k].count, header) * CHUNKS[k].elementSize;
+    }
+    auto image = std::make_shared<std::vector<char>>((std::size_t)total);
+    char* column[COLUMN_COUNT];
+    for (int k = 0; k < COLUMN_COUNT; k++) column[k] = image->data() + offsets[k];
+
+    if (header.flags & FLAG_COMPRESSED_TABLE) {
+        std::vector<unsigned char> packed((std::size_t)packedBytes);
+        const unsigned char* block = reinterpret_cast<const unsigned char*>(chunks[COMPRESSED_TABLE_CHUNK]);
+        if (!DecompressBlock(block, (std::size_t)counts[COMPRESSED_TABLE_CHUNK], packed.data(), packed.size()) ||
+            !UnpackTable(packed.data(), header, column)) {
+            return false;
+        }
+    } else {
+        for (int k = 0; k < COLUMN_COUNT; k++) {
+            if (CHUNKS[k].role != TABLE) continue;
+            std::memcpy(column[k], chunks[k], (std::size_t)(counts[k] * CHUNKS[k].elementSize));
+        }
+    }
+    if (header.flags & FLAG_DELTA_POINTS) {
+        const unsigned char* deltas = reinterpret_cast<const unsigned char*>(chunks[DELTA_POINTS_CHUNK]);
+        if (!DecodePointDeltas(deltas, (std::size_t)counts[DELTA_POINTS_CHUNK],
+                               reinterpret_cast<Point*>(column[POINTS_CHUNK]), (std::size_t)header.pointCount)) {
+            return false;
+        }
+    } else {
+        std::memcpy(column[POINTS_CHUNK], chunks[POINTS_CHUNK], (std::size_t)(header.pointCount * sizeof(Point)));
+    }
+
+    SceneColumns columns;
+    columns.shapeCount = (std::size_t)header.shapeCount;
+    columns.pointCount = (std::size_t)header.pointCount;
+    columns.spanCount = (std::size_t)header.spanCount;
+    SetColumnData(columns, column);
+    if (!ValidateShapes(columns, false)) return false;
+
+    std::uint8_t* bounded = reinterpret_cast<std::uint8_t*>(column[BOUNDED_CHUNK]);
+    PixelRect* bounds = reinterpret_cast<PixelRect*>(column[BOUNDS_CHUNK]);
+    ShapeGeometry* geometry = reinterpret_cast<ShapeGeometry*>(column[GEOMETRY_CHUNK]);
+    for (std::size_t i = 0; i < columns.shapeCount; i++) {
+        ShapeView shape = ColumnView(columns, i);
+        geometry[i] = GetShapeGeometry(shape);
+        shape.geometry = &geometry[i];
+        bounded[i] = GetShapeBounds(shape, bounds[i]);
+    }
+    scene.Adopt(columns, image);
+    return true;
+}
+
+// Load a version 2 file: a plain file is checked and adopted where it
+// lies, a compact one decoded
+static bool LoadVersion2(const char* data, std::size_t size, std::shared_ptr<const void> backing, Scene& scene) {
+    FileHeader header;
+    const char* chunks[CHUNK_COUNT];
+    std::uint64_t counts[CHUNK_COUNT];
+    if (!ReadDirectory(data, size, header, chunks, counts)) return false;
+    if (header.flags != 0) return DecodeScene(header, chunks, counts, scene);
+
+    SceneColumns columns;
+    columns.shapeCount = (std::size_t)header.shapeCount;
+    columns.pointCount = (std::size_t)header.pointCount;
+    columns.spanCount = (std::size_t)header.spanCount;
+    SetColumnData(columns, chunks);
+    if (!ValidateShapes(columns, true)) return false;
+    scene.Adopt(columns, std::move(backing));
+    return true;
+}
+
+// ========================================
+// STREAMS AND FILES
+// ========================================
+
+// Read the rest of 'in' into 'data': in one read when the stream can tell
+// its length, otherwise in blocks of doubling size
+static bool ReadAll(std::istream& in, std::vector<char>& data) {
+    data.clear();
+    std::streampos start = in.tellg();
+    if (start != std::streampos(-1) && in.seekg(0, std::ios::end)) {
+        std::streamoff size = in.tellg() - start;
+        in.seekg(start);
+        if (size >= 0 && in) {
+            data.resize((std::size_t)size);
+            return size == 0 || (bool)in.read(data.data(), size);
+        }
+    }
+    in.clear();
+    std::size_t block = 1 << 16;
+    while (in) {
+        std::size_t used = data.size();
+        data.resize(used + block);
+        in.read(data.data() + used, (std::streamsize)block);
+        data.resize(used + (std::size_t)in.gcount());
+        block = std::min<std::size_t>(block * 2, 64u << 20);
+    }
+    return in.eof() && !in.bad();
+}
+
+// Load a file of either version held at 'data', which 'backing' keeps alive
+static bool LoadScene(const char* data, std::size_t size, std::shared_ptr<const void> backing, Scene& scene) {
+    if (!IsVersion2(data, size)) return ReadLegacyScene(data, size, scene);
+    return LoadVersion2(data, size, std::move(backing), scene);
+}
+
+bool ReadScene(std::istream& in, Scene& scene) {
+    auto data = std::make_shared<std::vector<char>>();
+    if (!ReadAll(in, *data)) return false;
+    return LoadScene(data->data(), data->size(), data, scene);
+}
+
+bool SaveSceneToFile(const std::string& path, const Scene& scene, const SceneFileOptions& options) {
+    std::ofstream outFile(path, std::ios::binary);
+    if (!outFile) return false;
+    return WriteScene(outFile, scene, options);
+}
+
+bool LoadSceneFromFile(const std::string& path, Scene& scene) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(path)) return false;
+    return LoadScene(file->Data(), file->Size(), file, scene);
+}
+
+// ========================================
+// BATCHED LOADING
+// ========================================
+
+// The first batch is small so the first shapes come out quickly; each
+// after is twice the last, up to the caller's size
+static const std::size_t FIRST_BATCH = 64;
+
+bool LoadSceneInBatches(const std::string& path, std::size_t batchShapes, const SceneBatchCallback& deliver) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(path)) return false;
+    const std::size_t maxBatch = std::max<std::size_t>(batchShapes, 1);
+    std::size_t batchSize = std::min(FIRST_BATCH, maxBatch);
+    SceneLoadProgress progress;
+    Scene batch;
+
+    if (IsVersion2(file->Data(), file->Size())) {
+        // Checked whole, which costs a pass over the shape table, then
+        // handed out a range at a time
+        Scene loaded;
+        if (!LoadVersion2(file->Data(), file->Size(), file, loaded)) return false;
+        progress.totalShapes = loaded.Size();
+        while (progress.shapes < loaded.Size()) {
+            const std::size_t end = std::min(loaded.Size(), progress.shapes + batchSize);
+            batch.Clear();
+            batch.Append(loaded, progress.shapes, end);
+            progress.shapes = end;
+            if (!deliver(batch, progress)) return false;
+            batchSize = std::min(batchSize * 2, maxBatch);
+        }
+        return true;
+    }
+
+    // Version 1 is parsed as it goes; a bad shape ends the load after the
+    // batches before it went out
+    FileCursor cursor(file->Data(), file->Size());
+    std::int32_t shapeCnt = 0;
+    if (!cursor.Read(shapeCnt) || shapeCnt < 0) return false;
+    progress.totalShapes = (std::size_t)shapeCnt;
+    ShapeRecord record;
+    for (std::int32_t i = 0; i < shapeCnt; ++i) {
+        if (!NextShape(cursor, record) || !RecordValid(record)) return false;
+        AddRecord(batch, record);
+        if (batch.Size() == batchSize || i + 1 == shapeCnt) {
+            progress.shapes = (std::size_t)i + 1;
+            if (!deliver(batch, progress)) return false;
+            batch.Clear();
+            batchSize = std::min(batchSize * 2, maxBatch);
+        }
+    }
+    return true;
+}
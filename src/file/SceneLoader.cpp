@@ -0,0 +1,90 @@
+#include "../../include/SceneLoader.h"
+
+void SceneLoader::Start(const std::string& path, std::function<void()> notify, std::size_t batchShapes) {
+    Cancel();
+    Join();
+    m_notify = std::move(notify);
+    m_cancel = false;
+    m_start = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.Clear();
+        m_state = State::LOADING;
+        m_progress = SceneLoadProgress();
+        m_firstBatchMs = -1;
+        m_totalMs = -1;
+    }
+    m_worker = std::thread(&SceneLoader::Run, this, path, batchShapes);
+}
+
+void SceneLoader::Cancel() {
+    m_cancel = true;
+    Join();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_state == State::LOADING) m_state = State::CANCELLED;
+    m_pending.Clear();
+}
+
+void SceneLoader::Join() {
+    if (m_worker.joinable()) m_worker.join();
+}
+
+std::size_t SceneLoader::TakeShapes(Scene& scene) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::size_t count = m_pending.Size();
+    if (count == 0) return 0;
+    scene.Append(m_pending, 0, count);
+    m_pending.Clear();
+    return count;
+}
+
+SceneLoader::State SceneLoader::GetState() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_state;
+}
+
+SceneLoadProgress SceneLoader::Progress() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_progress;
+}
+
+double SceneLoader::FirstBatchMs() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_firstBatchMs;
+}
+
+double SceneLoader::TotalMs() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_totalMs;
+}
+
+void SceneLoader::Run(const std::string& path, std::size_t batchShapes) {
+    auto elapsedMs = [this]() {
+        return std::chrono::duration<double, std::milli>(Clock::now() - m_start).count();
+    };
+
+    bool ok = LoadSceneInBatches(path, batchShapes, [&](const Scene& batch, const SceneLoadProgress& progress) {
+        if (m_cancel) return false;
+        bool wasEmpty;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            wasEmpty = m_pending.Empty();
+            m_pending.Append(batch, 0, batch.Size());
+            m_progress = progress;
+            if (m_firstBatchMs < 0) m_firstBatchMs = elapsedMs();
+        }
+        if (wasEmpty && m_notify) m_notify();
+        return !m_cancel;
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_cancel) {
+            m_state = State::CANCELLED;
+        } else {
+            m_state = ok ? State::DONE : State::FAILED;
+        }
+        m_totalMs = elapsedMs();
+    }
+    if (m_notify) m_notify();
+}
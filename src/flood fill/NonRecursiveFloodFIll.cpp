@@ -1,7 +1,8 @@
 #include "../../include/FloodFill.h"
 #include <stack>
 
-void FloodFillNonRecursive(HDC hdc, int x, int y, COLORREF fillColor, COLORREF originalColor) {
+template <typename Sink>
+void FloodFillNonRecursive(Sink& sink, int x, int y, COLORREF fillColor, COLORREF originalColor) {
     std::stack<FloodPoint> stack;
     stack.push(FloodPoint(x, y));
 
@@ -12,8 +13,8 @@ void FloodFillNonRecursive(HDC hdc, int x, int y, COLORREF fillColor, COLORREF o
         int cx = current.x;
         int cy = current.y;
 
-        if (GetPixel(hdc, cx, cy) == originalColor && GetPixel(hdc, cx, cy) != fillColor) {
-            SetPixel(hdc, cx, cy, fillColor);
+        if (sink.Read(cx, cy) == originalColor && sink.Read(cx, cy) != fillColor) {
+            sink.Plot(cx, cy, fillColor);
 
             stack.push(FloodPoint(cx + 1, cy));
             stack.push(FloodPoint(cx - 1, cy));
@@ -21,4 +22,16 @@ void FloodFillNonRecursive(HDC hdc, int x, int y, COLORREF fillColor, COLORREF o
             stack.push(FloodPoint(cx, cy - 1));
         }
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FloodFillNonRecursive<Sink>(Sink&, int, int, COLORREF, COLORREF);
+FOR_EACH_READABLE_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FloodFillNonRecursive(HDC hdc, int x, int y, COLORREF fillColor, COLORREF originalColor) {
+    GdiSink sink(hdc);
+    FloodFillNonRecursive(sink, x, y, fillColor, originalColor);
+}
+#endif
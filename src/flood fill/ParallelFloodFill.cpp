@@ -0,0 +1,176 @@
+#include "../../include/ParallelFloodFill.h"
+#include <algorithm>
+#include <thread>
+
+// Below this many pixels a recolor is not worth starting threads for
+static const std::size_t PARALLEL_FILL_MIN_PIXELS = 1 << 16;
+
+// Run fn(0) .. fn(count - 1) on 'count' threads, the first one inline
+template <typename Fn>
+static void ParallelFor(int count, Fn fn) {
+    std::vector<std::thread> workers;
+    for (int i = 1; i < count; i++) workers.emplace_back(fn, i);
+    if (count > 0) fn(0);
+    for (auto& worker : workers) worker.join();
+}
+
+FloodFillLabels::FloodFillLabels(int threads)
+    : m_threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+bool FloodFillLabels::IsCurrent(const Framebuffer& framebuffer) const {
+    return m_source == &framebuffer && m_version == framebuffer.Version() &&
+           m_width == framebuffer.Width() && m_height == framebuffer.Height();
+}
+
+// Path halving; only touches the sets of 'i'
+std::uint32_t FloodFillLabels::Find(std::uint32_t i) {
+    while (m_parent[i] != i) {
+        m_parent[i] = m_parent[m_parent[i]];
+        i = m_parent[i];
+    }
+    return i;
+}
+
+// The lower index becomes the root. Swapping the successors of the two
+// roots splices their circular run lists into one.
+void FloodFillLabels::Union(std::uint32_t a, std::uint32_t b) {
+    a = Find(a);
+    b = Find(b);
+    if (a == b) return;
+    if (b < a) std::swap(a, b);
+    m_parent[b] = a;
+    std::swap(m_next[a], m_next[b]);
+}
+
+// Union same-colored runs of two adjacent rows that overlap in x
+void FloodFillLabels::UnionRows(int upper, int lower) {
+    std::uint32_t i = m_rowStart[upper], iEnd = m_rowStart[upper + 1];
+    std::uint32_t j = m_rowStart[lower], jEnd = m_rowStart[lower + 1];
+    while (i < iEnd && j < jEnd) {
+        const Run& a = m_runs[i];
+        const Run& b = m_runs[j];
+        if (a.pixel == b.pixel && a.x1 <= b.x2 && b.x1 <= a.x2) Union(i, j);
+        if (a.x2 < b.x2) i++; else j++;
+    }
+}
+
+std::uint32_t FloodFillLabels::RunAt(int x, int y) const {
+    auto first = m_runs.begin() + m_rowStart[y];
+    auto last = m_runs.begin() + m_rowStart[y + 1];
+    auto it = std::upper_bound(first, last, x, [](int value, const Run& run) { return value < run.x1; });
+    return (std::uint32_t)(it - m_runs.begin() - 1);
+}
+
+void FloodFillLabels::Build(const Framebuffer& framebuffer) {
+    m_source = &framebuffer;
+    m_version = framebuffer.Version();
+    m_width = framebuffer.Width();
+    m_height = framebuffer.Height();
+    m_runs.clear();
+    m_rowStart.assign(m_height + 1, 0);
+    if (m_width <= 0 || m_height <= 0) return;
+
+    const int strips = std::min(m_threads, m_height);
+    std::vector<int> stripStart(strips + 1);
+    for (int k = 0; k <= strips; k++) stripStart[k] = (int)((long long)m_height * k / strips);
+
+    // Pass 1: split each strip's rows into runs
+    std::vector<std::vector<Run>> stripRuns(strips);
+    ParallelFor(strips, [&](int k) {
+        std::vector<Run>& runs = stripRuns[k];
+        for (int y = stripStart[k]; y < stripStart[k + 1]; y++) {
+            const std::uint32_t* row = framebuffer.Row(y);
+            std::size_t before = runs.size();
+            int x = 0;
+            while (x < m_width) {
+                int start = x;
+                std::uint32_t pixel = row[x];
+                while (x < m_width && row[x] == pixel) x++;
+                runs.push_back({start, x - 1, y, pixel});
+            }
+            m_rowStart[y + 1] = (std::uint32_t)(runs.size() - before);
+        }
+    });
+
+    for (int y = 0; y < m_height; y++) m_rowStart[y + 1] += m_rowStart[y];
+    m_runs.resize(m_rowStart[m_height]);
+    m_parent.resize(m_runs.size());
+    m_next.resize(m_runs.size());
+
+    // Pass 2: label within each strip. A strip only touches its own runs.
+    ParallelFor(strips, [&](int k) {
+        std::uint32_t base = m_rowStart[stripStart[k]];
+        std::copy(stripRuns[k].begin(), stripRuns[k].end(), m_runs.begin() + base);
+        for (std::uint32_t i = base; i < base + stripRuns[k].size(); i++) {
+            m_parent[i] = i;
+            m_next[i] = i;
+        }
+        for (int y = stripStart[k] + 1; y < stripStart[k + 1]; y++) UnionRows(y - 1, y);
+    });
+
+    // Pass 3: merge across strip borders
+    for (int k = 1; k < strips; k++) UnionRows(stripStart[k] - 1, stripStart[k]);
+}
+
+// After a recolor, join the region with touching regions of its new color
+void FloodFillLabels::MergeNeighbors(const std::vector<std::uint32_t>& members) {
+    for (std::uint32_t i : members) {
+        const Run run = m_runs[i];
+        if (i > m_rowStart[run.y] && m_runs[i - 1].pixel == run.pixel) Union(i, i - 1);
+        if (i + 1 < m_rowStart[run.y + 1] && m_runs[i + 1].pixel == run.pixel) Union(i, i + 1);
+
+        for (int y = run.y - 1; y <= run.y + 1; y += 2) {
+            if (y < 0 || y >= m_height) continue;
+            for (std::uint32_t j = RunAt(run.x1, y); j < m_rowStart[y + 1] && m_runs[j].x1 <= run.x2; j++) {
+                if (m_runs[j].pixel == run.pixel) Union(i, j);
+            }
+        }
+    }
+}
+
+std::size_t FloodFillLabels::Fill(Framebuffer& framebuffer, int x, int y, COLORREF fillColor,
+                                  std::vector<FillSpan>* spans) {
+    if (!framebuffer.Contains(x, y)) return 0;
+    if (!IsCurrent(framebuffer)) Build(framebuffer);
+
+    const std::uint32_t pixel = Framebuffer::ToPixel(fillColor);
+    const std::uint32_t root = Find(RunAt(x, y));
+    if (m_runs[root].pixel == pixel) return 0;
+
+    // Every run of the region, via its circular list
+    m_members.clear();
+    std::size_t filled = 0;
+    std::uint32_t i = root;
+    do {
+        m_members.push_back(i);
+        filled += (std::size_t)(m_runs[i].x2 - m_runs[i].x1 + 1);
+        if (spans) spans->push_back({m_runs[i].y, m_runs[i].x1, m_runs[i].x2});
+        i = m_next[i];
+    } while (i != root);
+
+    const int workers = filled < PARALLEL_FILL_MIN_PIXELS ? 1 : m_threads;
+    ParallelFor(workers, [&](int k) {
+        std::size_t first = m_members.size() * k / workers;
+        std::size_t last = m_members.size() * (k + 1) / workers;
+        for (std::size_t m = first; m < last; m++) {
+            Run& run = m_runs[m_members[m]];
+            std::uint32_t* row = framebuffer.Row(run.y);
+            std::fill(row + run.x1, row + run.x2 + 1, pixel);
+            run.pixel = pixel;
+        }
+    });
+
+    MergeNeighbors(m_members);
+
+    // Dirty tiles are bytes shared between runs, so they are marked here
+    // rather than by the workers
+    for (std::uint32_t m : m_members) {
+        const Run& run = m_runs[m];
+        framebuffer.MarkDirty(run.x1, run.y, run.x2, run.y);
+    }
+
+    // Our own write: keep the labels current
+    framebuffer.MarkModified();
+    m_version = framebuffer.Version();
+    return filled;
+}
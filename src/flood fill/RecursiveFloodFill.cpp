@@ -1,14 +1,27 @@
 #include "../../include/FloodFill.h"
 
-void FloodFillRecursive(HDC hdc, int x, int y, COLORREF fillColor, COLORREF originalColor) {
-    if (GetPixel(hdc, x, y) != originalColor || GetPixel(hdc, x, y) == fillColor) {
+template <typename Sink>
+void FloodFillRecursive(Sink& sink, int x, int y, COLORREF fillColor, COLORREF originalColor) {
+    if (sink.Read(x, y) != originalColor || sink.Read(x, y) == fillColor) {
         return;
     }
 
-    SetPixel(hdc, x, y, fillColor);
+    sink.Plot(x, y, fillColor);
+
+    FloodFillRecursive(sink, x + 1, y, fillColor, originalColor);
+    FloodFillRecursive(sink, x - 1, y, fillColor, originalColor);
+    FloodFillRecursive(sink, x, y + 1, fillColor, originalColor);
+    FloodFillRecursive(sink, x, y - 1, fillColor, originalColor);
+}
 
-    FloodFillRecursive(hdc, x + 1, y, fillColor, originalColor);
-    FloodFillRecursive(hdc, x - 1, y, fillColor, originalColor);
-    FloodFillRecursive(hdc, x, y + 1, fillColor, originalColor);
-    FloodFillRecursive(hdc, x, y - 1, fillColor, originalColor);
-}
\ No newline at end of file
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FloodFillRecursive<Sink>(Sink&, int, int, COLORREF, COLORREF);
+FOR_EACH_READABLE_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FloodFillRecursive(HDC hdc, int x, int y, COLORREF fillColor, COLORREF originalColor) {
+    GdiSink sink(hdc);
+    FloodFillRecursive(sink, x, y, fillColor, originalColor);
+}
+#endif
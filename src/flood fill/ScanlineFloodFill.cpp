@@ -0,0 +1,136 @@
+#include "../../include/FloodFill.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+// A run still to be scanned: any pixel of row y between x1 and x2
+struct FloodSeed {
+    int x1, x2, y;
+};
+
+// One bit per pixel of the area a fill is confined to, each row starting
+// on a word. Reset() clears only the rows the previous fill marked, so a
+// small fill doesn't pay for clearing a bitset the size of the canvas.
+class VisitedBits {
+public:
+    void Reset(const PixelRect& area) {
+        if (m_lastRow >= m_firstRow) {
+            std::fill(m_bits.begin() + (std::size_t)m_firstRow * m_rowWords,
+                      m_bits.begin() + (std::size_t)(m_lastRow + 1) * m_rowWords, 0);
+        }
+        m_left = area.left;
+        m_top = area.top;
+        m_rowWords = ((std::size_t)(area.right - area.left) + 64) / 64;
+        // Every word is clear here, so growing only adds clear words
+        std::size_t words = m_rowWords * (std::size_t)(area.bottom - area.top + 1);
+        if (m_bits.size() < words) m_bits.resize(words, 0);
+        m_firstRow = INT_MAX;
+        m_lastRow = -1;
+    }
+
+    bool Test(int x, int y) const {
+        std::size_t i = (std::size_t)(x - m_left);
+        return (m_bits[(std::size_t)(y - m_top) * m_rowWords + (i >> 6)] >> (i & 63)) & 1;
+    }
+
+    // Mark [x1, x2] on row y, a word at a time
+    void SetRun(int x1, int x2, int y) {
+        const int row = y - m_top;
+        m_firstRow = std::min(m_firstRow, row);
+        m_lastRow = std::max(m_lastRow, row);
+        std::uint64_t* bits = &m_bits[(std::size_t)row * m_rowWords];
+        std::size_t i = (std::size_t)(x1 - m_left);
+        std::size_t end = (std::size_t)(x2 - m_left) + 1;
+        while (i < end) {
+            std::size_t word = i >> 6;
+            std::size_t bit = i & 63;
+            std::size_t count = std::min<std::size_t>(64 - bit, end - i);
+            std::uint64_t mask = (count == 64) ? ~0ULL : (((1ULL << count) - 1) << bit);
+            bits[word] |= mask;
+            i += count;
+        }
+    }
+
+private:
+    int m_left = 0;
+    int m_top = 0;
+    std::size_t m_rowWords = 0;
+    int m_firstRow = INT_MAX;  // Rows marked since Reset(), relative to m_top
+    int m_lastRow = -1;
+    std::vector<std::uint64_t> m_bits;
+};
+
+std::size_t FloodFillScanline(BgraSink& sink, int x, int y, COLORREF fillColor, COLORREF originalColor,
+                              std::vector<FillSpan>* spans) {
+    // The region stays within the sink's clip rectangle
+    const PixelRect& clip = sink.Clip();
+    if (x < clip.left || x > clip.right || y < clip.top || y > clip.bottom) return 0;
+
+    const std::uint32_t target = Framebuffer::ToPixel(originalColor);
+    const std::uint32_t fill = Framebuffer::ToPixel(fillColor);
+    if (sink.Row(y)[x] != target) return 0;
+
+    // Reused per thread so repeated fills do not reallocate
+    thread_local VisitedBits visited;
+    thread_local std::vector<FloodSeed> stack;
+    visited.Reset(clip);
+    stack.clear();
+    auto fillable = [&](const std::uint32_t* row, int px, int py) {
+        return row[px] == target && !visited.Test(px, py);
+    };
+
+    stack.push_back({x, x, y});
+    std::size_t filled = 0;
+
+    while (!stack.empty()) {
+        FloodSeed seed = stack.back();
+        stack.pop_back();
+        std::uint32_t* row = sink.Row(seed.y);
+
+        // Each fillable pixel in the seed range starts (or continues) a run
+        for (int sx = seed.x1; sx <= seed.x2; sx++) {
+            if (!fillable(row, sx, seed.y)) continue;
+
+            // Grow the run in both directions
+            int left = sx, right = sx;
+            while (left > clip.left && fillable(row, left - 1, seed.y)) left--;
+            while (right < clip.right && fillable(row, right + 1, seed.y)) right++;
+
+            std::fill(row + left, row + right + 1, fill);
+            sink.MarkDirty(left, right, seed.y);
+            visited.SetRun(left, right, seed.y);
+            filled += (std::size_t)(right - left + 1);
+            if (spans) spans->push_back({seed.y, left, right});
+
+            // The rows above and below only need scanning over this run
+            if (seed.y > clip.top) stack.push_back({left, right, seed.y - 1});
+            if (seed.y < clip.bottom) stack.push_back({left, right, seed.y + 1});
+
+            sx = right + 1;
+        }
+    }
+    return filled;
+}
+
+std::size_t FloodFillScanline(Framebuffer& framebuffer, int x, int y, COLORREF fillColor, COLORREF originalColor,
+                              std::vector<FillSpan>* spans) {
+    BgraSink sink(framebuffer);
+    return FloodFillScanline(sink, x, y, fillColor, originalColor, spans);
+}
+
+void NormalizeSpans(std::vector<FillSpan>& spans) {
+    std::sort(spans.begin(), spans.end(), [](const FillSpan& a, const FillSpan& b) {
+        return a.y != b.y ? a.y < b.y : a.x1 < b.x1;
+    });
+
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < spans.size(); i++) {
+        if (out > 0 && spans[out - 1].y == spans[i].y && spans[i].x1 <= spans[out - 1].x2 + 1) {
+            spans[out - 1].x2 = std::max(spans[out - 1].x2, spans[i].x2);
+        } else {
+            spans[out++] = spans[i];
+        }
+    }
+    spans.resize(out);
+}
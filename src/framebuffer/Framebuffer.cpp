@@ -0,0 +1,162 @@
+#include "../../include/Framebuffer.h"
+#include <algorithm>
+
+#ifdef GFX_WITH_GDI
+#include <windows.h>
+#else
+#include <cstdlib>
+#endif
+
+Framebuffer::Framebuffer()
+    : m_pixels(nullptr)
+    , m_bitmap(nullptr)
+    , m_width(0)
+    , m_height(0)
+    , m_version(0)
+    , m_tilesX(0)
+    , m_tilesY(0)
+{
+}
+
+Framebuffer::~Framebuffer() {
+    Release();
+}
+
+bool Framebuffer::Create(int width, int height) {
+    Release();
+    if (width <= 0 || height <= 0) return false;
+
+#ifdef GFX_WITH_GDI
+    BITMAPINFO bmi;
+    ZeroMemory(&bmi, sizeof(bmi));
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = width;
+    bmi.bmiHeader.biHeight = -height;  // Negative height = top-down rows
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    HBITMAP bitmap = CreateDIBSection(NULL, &bmi, DIB_RGB_COLORS, &bits, NULL, 0);
+    if (!bitmap || !bits) return false;
+
+    m_bitmap = bitmap;
+    m_pixels = static_cast<std::uint32_t*>(bits);
+#else
+    m_pixels = static_cast<std::uint32_t*>(std::malloc((std::size_t)width * height * sizeof(std::uint32_t)));
+    if (!m_pixels) return false;
+#endif
+
+    m_width = width;
+    m_height = height;
+    m_version++;
+
+    m_tilesX = (width + TILE_SIZE - 1) >> TILE_SHIFT;
+    m_tilesY = (height + TILE_SIZE - 1) >> TILE_SHIFT;
+    m_dirtyTiles.assign((std::size_t)m_tilesX * m_tilesY, TILE_DIRTY);
+    return true;
+}
+
+void Framebuffer::Release() {
+#ifdef GFX_WITH_GDI
+    if (m_bitmap) {
+        DeleteObject((HBITMAP)m_bitmap);
+    }
+#else
+    std::free(m_pixels);
+#endif
+    m_bitmap = nullptr;
+    m_pixels = nullptr;
+    m_width = 0;
+    m_height = 0;
+    m_dirtyTiles.clear();
+    m_tilesX = 0;
+    m_tilesY = 0;
+}
+
+void Framebuffer::Clear(COLORREF color) {
+    if (!m_pixels) return;
+    std::fill(m_pixels, m_pixels + (std::size_t)m_width * m_height, ToPixel(color));
+    m_version++;
+    MarkAllDirty();
+}
+
+void Framebuffer::FillSpan(int x1, int x2, int y, COLORREF c) {
+    if ((unsigned)y >= (unsigned)m_height) return;
+    if (x1 > x2) std::swap(x1, x2);
+    x1 = std::max(x1, 0);
+    x2 = std::min(x2, m_width - 1);
+    if (x1 > x2) return;
+
+    std::uint32_t* row = Row(y);
+    std::fill(row + x1, row + x2 + 1, ToPixel(c));
+    MarkDirty(x1, y, x2, y);
+}
+
+void Framebuffer::MarkDirty(int x1, int y1, int x2, int y2) {
+    x1 = std::max(x1, 0);
+    y1 = std::max(y1, 0);
+    x2 = std::min(x2, m_width - 1);
+    y2 = std::min(y2, m_height - 1);
+    if (x1 > x2 || y1 > y2) return;
+
+    for (int ty = y1 >> TILE_SHIFT; ty <= y2 >> TILE_SHIFT; ty++) {
+        TileState* row = m_dirtyTiles.data() + (std::size_t)ty * m_tilesX;
+        std::fill(row + (x1 >> TILE_SHIFT), row + (x2 >> TILE_SHIFT) + 1, TILE_DIRTY);
+    }
+}
+
+void Framebuffer::MarkAllDirty() {
+    std::fill(m_dirtyTiles.begin(), m_dirtyTiles.end(), TILE_DIRTY);
+}
+
+bool Framebuffer::HasDirtyTiles() const {
+    return std::find(m_dirtyTiles.begin(), m_dirtyTiles.end(), TILE_DIRTY) != m_dirtyTiles.end();
+}
+
+std::size_t Framebuffer::TakeDirtyRects(std::vector<DirtyRect>& rects) {
+    rects.clear();
+
+    // Rectangles still growing downwards, in tiles: they end on the previous
+    // tile row and are ordered by their first column
+    struct Open {
+        int tx1, tx2, ty1;
+    };
+    std::vector<Open> open, next;
+    std::size_t dirty = 0;
+
+    auto close = [&](const Open& r, int tyEnd) {
+        int x = r.tx1 << TILE_SHIFT, y = r.ty1 << TILE_SHIFT;
+        rects.push_back({ x, y, std::min((r.tx2 + 1) << TILE_SHIFT, m_width) - x,
+                          std::min(tyEnd << TILE_SHIFT, m_height) - y });
+    };
+
+    for (int ty = 0; ty <= m_tilesY; ty++) {
+        next.clear();
+        std::size_t o = 0;
+        int tx = 0;
+        while (ty < m_tilesY) {
+            // Next run of dirty tiles in this row
+            const TileState* row = m_dirtyTiles.data() + (std::size_t)ty * m_tilesX;
+            while (tx < m_tilesX && !row[tx]) tx++;
+            if (tx == m_tilesX) break;
+            int tx1 = tx;
+            while (tx < m_tilesX && row[tx]) tx++;
+            int tx2 = tx - 1;
+            dirty += (std::size_t)(tx2 - tx1 + 1);
+
+            // Open rectangles left of the run can no longer continue
+            while (o < open.size() && open[o].tx1 < tx1) close(open[o++], ty);
+            if (o < open.size() && open[o].tx1 == tx1 && open[o].tx2 == tx2) {
+                next.push_back(open[o++]);
+            } else {
+                next.push_back({ tx1, tx2, ty });
+            }
+        }
+        while (o < open.size()) close(open[o++], ty);
+        open.swap(next);
+    }
+
+    std::fill(m_dirtyTiles.begin(), m_dirtyTiles.end(), TILE_CLEAN);
+    return dirty;
+}
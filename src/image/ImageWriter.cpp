@@ -0,0 +1,156 @@
+#include "../../include/ImageWriter.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// Expand one framebuffer row (0x00RRGGBB) to packed RGB bytes
+static void RowToRGB(const std::uint32_t* row, int width, unsigned char* out) {
+    for (int x = 0; x < width; x++) {
+        std::uint32_t p = row[x];
+        out[3 * x + 0] = (unsigned char)(p >> 16);
+        out[3 * x + 1] = (unsigned char)(p >> 8);
+        out[3 * x + 2] = (unsigned char)p;
+    }
+}
+
+bool WritePPM(const std::string& path, const Framebuffer& framebuffer) {
+    if (!framebuffer.IsValid()) return false;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    int width = framebuffer.Width();
+    int height = framebuffer.Height();
+    out << "P6\n" << width << " " << height << "\n255\n";
+
+    std::vector<unsigned char> rgb((std::size_t)width * 3);
+    for (int y = 0; y < height; y++) {
+        RowToRGB(framebuffer.Row(y), width, rgb.data());
+        out.write(reinterpret_cast<const char*>(rgb.data()), rgb.size());
+    }
+    return (bool)out;
+}
+
+// ========================================
+// PNG ENCODER
+// ========================================
+
+struct CrcTable {
+    std::uint32_t entries[256];
+
+    CrcTable() {
+        for (std::uint32_t n = 0; n < 256; n++) {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+    }
+};
+
+static std::uint32_t Crc32(std::uint32_t crc, const unsigned char* data, std::size_t size) {
+    static const CrcTable table;  // Thread-safe one-time init; the batch renderer writes in parallel
+
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; i++) {
+        crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static std::uint32_t Adler32(const unsigned char* data, std::size_t size) {
+    std::uint32_t a = 1, b = 0;
+    while (size > 0) {
+        // 5552 is the largest run that cannot overflow b before the modulo
+        std::size_t run = std::min<std::size_t>(size, 5552);
+        for (std::size_t i = 0; i < run; i++) {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += run;
+        size -= run;
+    }
+    return (b << 16) | a;
+}
+
+static void PutBE32(std::vector<unsigned char>& out, std::uint32_t v) {
+    out.push_back((unsigned char)(v >> 24));
+    out.push_back((unsigned char)(v >> 16));
+    out.push_back((unsigned char)(v >> 8));
+    out.push_back((unsigned char)v);
+}
+
+static void WriteChunk(std::ofstream& out, const char type[4], const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> header;
+    PutBE32(header, (std::uint32_t)data.size());
+    header.insert(header.end(), type, type + 4);
+    out.write(reinterpret_cast<const char*>(header.data()), header.size());
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    std::uint32_t crc = Crc32(0, reinterpret_cast<const unsigned char*>(type), 4);
+    crc = Crc32(crc, data.data(), data.size());
+    std::vector<unsigned char> trailer;
+    PutBE32(trailer, crc);
+    out.write(reinterpret_cast<const char*>(trailer.data()), trailer.size());
+}
+
+bool WritePNG(const std::string& path, const Framebuffer& framebuffer) {
+    if (!framebuffer.IsValid()) return false;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    int width = framebuffer.Width();
+    int height = framebuffer.Height();
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    out.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<unsigned char> ihdr;
+    PutBE32(ihdr, (std::uint32_t)width);
+    PutBE32(ihdr, (std::uint32_t)height);
+    ihdr.push_back(8);  // Bit depth
+    ihdr.push_back(2);  // Color type: RGB
+    ihdr.push_back(0);  // Compression
+    ihdr.push_back(0);  // Filter
+    ihdr.push_back(0);  // Interlace
+    WriteChunk(out, "IHDR", ihdr);
+
+    // Raw scanlines: filter byte 0 followed by RGB
+    std::size_t rowBytes = (std::size_t)width * 3 + 1;
+    std::vector<unsigned char> raw(rowBytes * height);
+    for (int y = 0; y < height; y++) {
+        unsigned char* row = raw.data() + rowBytes * y;
+        row[0] = 0;
+        RowToRGB(framebuffer.Row(y), width, row + 1);
+    }
+
+    // zlib stream of stored (uncompressed) deflate blocks
+    const std::size_t maxBlock = 65535;
+    std::vector<unsigned char> idat;
+    idat.reserve(raw.size() + raw.size() / maxBlock * 5 + 16);
+    idat.push_back(0x78);
+    idat.push_back(0x01);
+
+    std::size_t pos = 0;
+    do {
+        std::size_t len = std::min(maxBlock, raw.size() - pos);
+        bool last = pos + len == raw.size();
+        idat.push_back(last ? 1 : 0);
+        idat.push_back((unsigned char)len);
+        idat.push_back((unsigned char)(len >> 8));
+        idat.push_back((unsigned char)~len);
+        idat.push_back((unsigned char)(~len >> 8));
+        idat.insert(idat.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+    } while (pos < raw.size());
+    PutBE32(idat, Adler32(raw.data(), raw.size()));
+
+    WriteChunk(out, "IDAT", idat);
+    WriteChunk(out, "IEND", std::vector<unsigned char>());
+    return (bool)out;
+}
@@ -1,8 +1,8 @@
-#include <windows.h>
 #include <cmath>
 #include "../../include/LineAlgorithms.h"
 
-void DrawLineBresenham(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
+template <typename Sink>
+void DrawLineBresenham(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c)
 {
     // Handle negative slopes and ensure we're drawing in positive direction
     int dx = abs(x2 - x1);
@@ -14,7 +14,7 @@ void DrawLineBresenham(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
     int y = y1;
 
     // Set starting pixel
-    SetPixel(hdc, x, y, c);
+    sink.Plot(x, y, c);
 
     // Case 1: dx >= dy (slope <= 1)
     if (dx >= dy) {
@@ -32,7 +32,7 @@ void DrawLineBresenham(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
                 x += sx;
                 y += sy;
             }
-            SetPixel(hdc, x, y, c);
+            sink.Plot(x, y, c);
         }
     }
     // Case 2: dy > dx (slope > 1)
@@ -51,7 +51,19 @@ void DrawLineBresenham(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
                 y += sy;
                 x += sx;
             }
-            SetPixel(hdc, x, y, c);
+            sink.Plot(x, y, c);
         }
     }
-} 
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawLineBresenham<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawLineBresenham(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawLineBresenham(sink, x1, y1, x2, y2, c);
+}
+#endif
@@ -1,14 +1,16 @@
+#include <cstdlib>
 #include "../../include/LineAlgorithms.h"
 
 
-void drawLineBresenhamPolygon(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c) {
+template <typename Sink>
+void drawLineBresenhamPolygon(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c) {
     int dx = x2 - x1;
     int dy = y2 - y1;
     int sx = x1 < x2 ? 1 : -1;
     int sy = y1 < y2 ? 1 : -1;
     int x = x1, y = y1;
 
-    SetPixel(hdc, x, y, c);
+    sink.Plot(x, y, c);
 
     if(abs(dx) > abs(dy)) {
         int d = sy * dx - 2 * sx * dy;
@@ -23,7 +25,7 @@ void drawLineBresenhamPolygon(HDC hdc, int x1, int y1, int x2, int y2, COLORREF
                 d += d2;
             }
             x += sx;
-            SetPixel(hdc, x, y, c);
+            sink.Plot(x, y, c);
         }
     } else {
         int d = 2 * sy * dx - sx * dy;
@@ -38,7 +40,19 @@ void drawLineBresenhamPolygon(HDC hdc, int x1, int y1, int x2, int y2, COLORREF
                 d += d2;
             }
             y += sy;
-            SetPixel(hdc, x, y, c);
+            sink.Plot(x, y, c);
         }
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void drawLineBresenhamPolygon<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void drawLineBresenhamPolygon(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c) {
+    GdiSink sink(hdc);
+    drawLineBresenhamPolygon(sink, x1, y1, x2, y2, c);
+}
+#endif
@@ -1,12 +1,12 @@
-#include <windows.h>
 #include <cmath>
 #include "../../include/Utils.h"
 #include "../../include/LineAlgorithms.h"
 
-void DrawLineDDA(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
+template <typename Sink>
+void DrawLineDDA(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c)
 {
     int dx = x2 - x1, dy = y2 - y1;
-    SetPixel(hdc, x1, y1, c);
+    sink.Plot(x1, y1, c);
     
     if (abs(dx) >= abs(dy))
     {
@@ -26,7 +26,7 @@ void DrawLineDDA(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
         {
             x++;
             y += m;
-            SetPixel(hdc, x, Round(y), c);
+            sink.Plot(x, Round(y), c);
         }
     }
     else {
@@ -46,7 +46,19 @@ void DrawLineDDA(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
         {
             y++;
             x += mi;
-            SetPixel(hdc, Round(x), y, c);
+            sink.Plot(Round(x), y, c);
         }
     }
-} 
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawLineDDA<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawLineDDA(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawLineDDA(sink, x1, y1, x2, y2, c);
+}
+#endif
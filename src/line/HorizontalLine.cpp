@@ -1,13 +1,23 @@
-#include <windows.h>
 #include "../../include/LineAlgorithms.h"
 
-void DrawHorizontalLine(HDC hdc, int x1, int x2, int y, COLORREF c) {
+template <typename Sink>
+void DrawHorizontalLine(Sink& sink, int x1, int x2, int y, COLORREF c) {
     if (x1 > x2) {
         int temp = x1;
         x1 = x2;
         x2 = temp;
     }
-    for (int x = x1; x <= x2; x++) {
-        SetPixel(hdc, x, y, c);
-    }
-}
\ No newline at end of file
+    sink.Span(x1, x2, y, c);
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawHorizontalLine<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawHorizontalLine(HDC hdc, int x1, int x2, int y, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawHorizontalLine(sink, x1, x2, y, c);
+}
+#endif
@@ -1,9 +1,9 @@
-#include <windows.h>
 #include <cmath>
 #include <algorithm>
 #include "../../include/LineAlgorithms.h"
 
-void DrawLineParametric(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
+template <typename Sink>
+void DrawLineParametric(Sink& sink, int x1, int y1, int x2, int y2, COLORREF c)
 {
     double alpha_x = x2 - x1, alpha_y = y2 - y1;
     double steps = 1.0 / (std::max(abs(alpha_x), abs(alpha_y)));
@@ -11,6 +11,18 @@ void DrawLineParametric(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c)
     for (double i = 0.0; i <= 1.0; i += steps) {
         int x = x1 + (int)(alpha_x * i);
         int y = y1 + (int)(alpha_y * i);
-        SetPixel(hdc, x, y, c);
+        sink.Plot(x, y, c);
     }
-} 
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawLineParametric<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawLineParametric(HDC hdc, int x1, int y1, int x2, int y2, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawLineParametric(sink, x1, y1, x2, y2, c);
+}
+#endif
@@ -0,0 +1,65 @@
+#include "../../include/FrameArena.h"
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+static std::atomic<std::uint64_t> g_heapAllocations(0);
+
+FrameArena::~FrameArena() {
+    for (const Block& block : m_blocks) ::operator delete(block.data);
+}
+
+void FrameArena::AddBlock(std::size_t size) {
+    // Pushed first so a failed allocation leaves nothing to free
+    m_blocks.push_back({ nullptr, 0 });
+    m_blocks.back().data = static_cast<unsigned char*>(::operator new(size));
+    m_blocks.back().size = size;
+    m_stats.capacity += size;
+    m_stats.heapAllocations++;
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+// The current block is full: move on to the next one that fits, adding a
+// larger one when none does. Blocks come from operator new, so they are
+// aligned for any fundamental type.
+void* FrameArena::AllocateSlow(std::size_t bytes, std::size_t align) {
+    std::size_t next = m_block < m_blocks.size() ? m_block + 1 : m_blocks.size();
+    while (next < m_blocks.size() && m_blocks[next].size < bytes) next++;
+    if (next == m_blocks.size()) {
+        std::size_t size = m_blocks.empty() ? m_blockSize : m_blocks.back().size * 2;
+        AddBlock(std::max(size, bytes + align));
+    }
+    m_block = next;
+    m_offset = 0;
+    return AllocateBytes(bytes, align);
+}
+
+void FrameArena::Rewind(const Mark& mark) {
+    m_block = mark.block;
+    m_offset = mark.offset;
+    m_stats.used = mark.used;
+}
+
+void FrameArena::Reset() {
+    if (m_blocks.size() > 1) {
+        // The last frame needed more than one block: next time it fits in one
+        std::size_t size = m_stats.capacity;
+        for (const Block& block : m_blocks) ::operator delete(block.data);
+        m_blocks.clear();
+        m_stats.capacity = 0;
+        AddBlock(size);
+    }
+    m_block = 0;
+    m_offset = 0;
+    m_stats.used = 0;
+    m_stats.peak = 0;
+}
+
+std::uint64_t FrameArena::TotalHeapAllocations() {
+    return g_heapAllocations.load(std::memory_order_relaxed);
+}
+
+FrameArena& ThreadArena() {
+    thread_local FrameArena arena;
+    return arena;
+}
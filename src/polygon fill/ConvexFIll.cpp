@@ -1,49 +1,69 @@
 #include "../../include/PolygonFillAlgorithms.h"
+#include <limits>
+#include <vector>
 
+// Leftmost and rightmost crossing of one row
+struct RowBounds {
+    double left, right;
+};
 
-void initEdgeTable(EdgeTable tbl) {
-    for (int i = 0; i < 800; i++) {
-        tbl[i].xleft = 10000;
-        tbl[i].xright = -10000;
-    }
-}
+// One span per row between the outermost edge crossings. Edges cover rows
+// ceil(ymin) .. ceil(ymax) - 1 like NonConvexFill, so both fillers produce
+// the same pixels wherever each row crosses the boundary twice.
+template <typename Sink>
+void ConvexFill(Sink& sink, PolygonPoint p[], int n, COLORREF c) {
+    if (n < 3) return;
 
-void Edge2Table(PolygonPoint* v1, PolygonPoint* v2, EdgeTable tbl) {
-    if(v1->y == v2->y) return;
-    if(v1->y > v2->y) std::swap(v1, v2);
+    double minY = p[0].y, maxY = p[0].y;
+    for (int i = 1; i < n; i++) {
+        minY = std::min(minY, p[i].y);
+        maxY = std::max(maxY, p[i].y);
+    }
+    const int top = (int)std::max(std::ceil(minY), 0.0);
+    const int bottom = (int)std::min(std::ceil(maxY), (double)MAX_FILL_ROW);
+    if (top >= bottom) return;
 
-    int y = v1->y;
-    double x = v1->x;
-    double minv = (v2->x - v1->x) / (v2->y - v1->y);
+    // Only the polygon's rows; reused per thread
+    thread_local std::vector<RowBounds> rows;
+    const double inf = std::numeric_limits<double>::infinity();
+    rows.assign(bottom - top, { inf, -inf });
 
-    while(y < v2->y) {
-        if(x < tbl[y].xleft) tbl[y].xleft = (int)ceil(x);
-        if(x > tbl[y].xright) tbl[y].xright = (int)floor(x);
-        y++;
-        x += minv;
-    }
-}
+    for (int i = 0, prev = n - 1; i < n; prev = i++) {
+        const PolygonPoint* v1 = &p[prev];
+        const PolygonPoint* v2 = &p[i];
+        if (v1->y == v2->y) continue;
+        if (v1->y > v2->y) std::swap(v1, v2);
 
-void Polygon2Table(PolygonPoint p[], int n, EdgeTable tbl) {
-    PolygonPoint v1 = p[n-1];
-    for(int i = 0; i < n; i++) {
-        PolygonPoint v2 = p[i];
-        Edge2Table(&v1, &v2, tbl);
-        v1 = p[i];
+        double minv = (v2->x - v1->x) / (v2->y - v1->y);
+        int first = (int)std::max(std::ceil(v1->y), (double)top);
+        int last = (int)std::min(std::ceil(v2->y), (double)bottom);
+        double x = v1->x + (first - v1->y) * minv;
+        for (int y = first; y < last; y++) {
+            RowBounds& row = rows[y - top];
+            row.left = std::min(row.left, x);
+            row.right = std::max(row.right, x);
+            x += minv;
+        }
     }
-}
 
-void Table2Screen(HDC hdc, EdgeTable tbl, COLORREF c) {
-    for(int i = 0; i < 800; i++) {
-        if(tbl[i].xleft < tbl[i].xright) {
-            drawLineBresenhamPolygon(hdc, tbl[i].xleft, i, tbl[i].xright, i, c);
+    for (int y = top; y < bottom; y++) {
+        const RowBounds& row = rows[y - top];
+        int x1 = (int)std::ceil(row.left);
+        int x2 = (int)std::floor(row.right);
+        if (x1 <= x2) {
+            sink.Span(x1, x2, y, c);
         }
     }
 }
 
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void ConvexFill<Sink>(Sink&, PolygonPoint[], int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
 void ConvexFill(HDC hdc, PolygonPoint p[], int n, COLORREF c) {
-    EdgeTable tbl;
-    initEdgeTable(tbl);
-    Polygon2Table(p, n, tbl);
-    Table2Screen(hdc, tbl, c);
+    GdiSink sink(hdc);
+    ConvexFill(sink, p, n, c);
 }
+#endif
@@ -0,0 +1,299 @@
+#include "../../include/CoverageRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+// ========================================
+// CELL ACCUMULATION
+// ========================================
+
+void CoverageRasterizer::AddCell(int x, int y, double cover, double area) {
+    // Consecutive pieces of one edge often land in the same cell
+    if (!m_cells.empty()) {
+        Cell& last = m_cells.back();
+        if (last.x == x && last.y == y) {
+            last.cover += cover;
+            last.area += area;
+            return;
+        }
+    }
+    m_cells.push_back({ y, x, cover, area });
+}
+
+// Part of an edge inside row y, with ya < yb relative to the row's top.
+// Each cell gets the height the edge spans in it and that height times the
+// distance of the edge's midpoint from the cell's left side.
+void CoverageRasterizer::AddRowSegment(int y, double xa, double ya, double xb, double yb, double dir) {
+    int ca = (int)std::floor(xa);
+    int cb = (int)std::floor(xb);
+    if (ca == cb) {
+        double h = dir * (yb - ya);
+        AddCell(ca, y, h, h * ((xa + xb) * 0.5 - ca));
+        return;
+    }
+
+    const int step = xb > xa ? 1 : -1;
+    const double dydx = (yb - ya) / (xb - xa);
+    double x = xa, yy = ya;
+    for (int cx = ca;; cx += step) {
+        double xNext = cx == cb ? xb : (step > 0 ? cx + 1.0 : (double)cx);
+        double yNext = cx == cb ? yb : ya + (xNext - xa) * dydx;
+        double h = dir * (yNext - yy);
+        AddCell(cx, y, h, h * ((x + xNext) * 0.5 - cx));
+        if (cx == cb) break;
+        x = xNext;
+        yy = yNext;
+    }
+}
+
+// Edge in cell space with x already clipped to [-0.5, MAX_FILL_ROW];
+// split into rows, clipped to the rows being accumulated
+void CoverageRasterizer::AddClippedLine(double x0, double y0, double x1, double y1) {
+    if (y0 == y1) return;
+    double dir = 1;
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        dir = -1;
+    }
+
+    const double dxdy = (x1 - x0) / (y1 - y0);
+    const double xMin = std::min(x0, x1), xMax = std::max(x0, x1);
+    int first = (int)std::max(std::floor(y0), (double)m_rowFirst);
+    int last = (int)std::min(std::ceil(y1), (double)m_rowEnd);
+    for (int y = first; y < last; y++) {
+        double ya = std::max(y0, (double)y);
+        double yb = std::min(y1, y + 1.0);
+        double xa = std::clamp(x0 + (ya - y0) * dxdy, xMin, xMax);
+        double xb = std::clamp(x0 + (yb - y0) * dxdy, xMin, xMax);
+        AddRowSegment(y, xa, ya - y, xb, yb - y, dir);
+    }
+}
+
+void CoverageRasterizer::AddLine(double x0, double y0, double x1, double y1) {
+    // Pixel centers to cell corners
+    x0 += 0.5; y0 += 0.5;
+    x1 += 0.5; y1 += 0.5;
+    if (y0 == y1) return;
+
+    // Right of the last column nothing is drawn, and cover only affects
+    // pixels further right: drop that part
+    const double right = MAX_FILL_ROW;
+    if (x0 >= right && x1 >= right) return;
+    if (x0 > right || x1 > right) {
+        double ym = y0 + (right - x0) * (y1 - y0) / (x1 - x0);
+        if (x0 > right) { x0 = right; y0 = ym; }
+        else { x1 = right; y1 = ym; }
+    }
+
+    // Left of column 0 only the cover matters: that part becomes a vertical
+    // edge in column -1, which is never drawn
+    if (x0 < 0 || x1 < 0) {
+        if (x0 < 0 && x1 < 0) {
+            AddClippedLine(-0.5, y0, -0.5, y1);
+            return;
+        }
+        double ym = y0 - x0 * (y1 - y0) / (x1 - x0);
+        if (x0 < 0) {
+            AddClippedLine(-0.5, y0, -0.5, ym);
+            AddClippedLine(0, ym, x1, y1);
+        } else {
+            AddClippedLine(x0, y0, 0, ym);
+            AddClippedLine(-0.5, ym, -0.5, y1);
+        }
+        return;
+    }
+    AddClippedLine(x0, y0, x1, y1);
+}
+
+void CoverageRasterizer::AddPolygon(const PolygonPoint p[], int n) {
+    for (int i = 0, prev = n - 1; i < n; prev = i++) {
+        AddLine(p[prev].x, p[prev].y, p[i].x, p[i].y);
+    }
+}
+
+void CoverageRasterizer::AddPolygon(const BezierPoint p[], int n) {
+    for (int i = 0, prev = n - 1; i < n; prev = i++) {
+        AddLine(p[prev].x, p[prev].y, p[i].x, p[i].y);
+    }
+}
+
+// Inscribed polygon whose sagitta stays within 'tolerance'
+void CoverageRasterizer::AddEllipse(double xc, double yc, double rx, double ry, double tolerance) {
+    rx = std::fabs(rx);
+    ry = std::fabs(ry);
+    double r = std::max(rx, ry);
+    if (r <= 0) return;
+
+    const double pi = 3.14159265358979323846;
+    double step = tolerance < r ? 2 * std::acos(1 - tolerance / r) : pi / 2;
+    int segments = std::max(8, (int)std::ceil(2 * pi / step));
+
+    double px = xc + rx, py = yc;
+    for (int i = 1; i <= segments; i++) {
+        double angle = 2 * pi * i / segments;
+        double x = i == segments ? xc + rx : xc + rx * std::cos(angle);
+        double y = i == segments ? yc : yc + ry * std::sin(angle);
+        AddLine(px, py, x, y);
+        px = x;
+        py = y;
+    }
+}
+
+// ========================================
+// SWEEP
+// ========================================
+
+// Fraction of a pixel covered for winding 'w', as 0..255
+static int CoverageAlpha(double w, FillRule rule) {
+    double a = std::fabs(w);
+    if (rule == FillRule::NON_ZERO) {
+        a = std::min(a, 1.0);
+    } else {
+        a = std::fmod(a, 2.0);
+        if (a > 1) a = 2 - a;
+    }
+    return (int)(a * 255 + 0.5);
+}
+
+template <typename Sink>
+static void PlotCoverage(Sink& sink, int x, int y, COLORREF c, int alpha) {
+    if (alpha <= 0) return;
+    if (alpha >= 255) {
+        sink.Plot(x, y, c);
+        return;
+    }
+    if constexpr (SinkCanBlend<Sink>::value) {
+        sink.Blend(x, y, c, alpha);
+    } else if constexpr (SinkCanRead<Sink>::value) {
+        COLORREF under = sink.Read(x, y);
+        if (under != CLR_INVALID) sink.Plot(x, y, BlendColor(under, c, alpha));
+    } else if (alpha >= 128) {
+        sink.Plot(x, y, c);
+    }
+}
+
+// Bucket the cells by row (counting sort), then order each row by x. Rows
+// hold few cells, so this stays close to linear in the perimeter.
+void CoverageRasterizer::SortCells() {
+    if (m_cells.empty()) return;
+    int top = m_cells[0].y, bottom = m_cells[0].y;
+    for (const Cell& cell : m_cells) {
+        top = std::min(top, cell.y);
+        bottom = std::max(bottom, cell.y);
+    }
+
+    m_rowStart.assign(bottom - top + 2, 0);
+    for (const Cell& cell : m_cells) m_rowStart[cell.y - top + 1]++;
+    for (size_t y = 1; y < m_rowStart.size(); y++) m_rowStart[y] += m_rowStart[y - 1];
+
+    m_sorted.resize(m_cells.size());
+    m_rowNext.assign(m_rowStart.begin(), m_rowStart.end() - 1);
+    for (const Cell& cell : m_cells) m_sorted[m_rowNext[cell.y - top]++] = cell;
+    m_cells.swap(m_sorted);
+
+    auto byX = [](const Cell& a, const Cell& b) { return a.x < b.x; };
+    for (size_t y = 0; y + 1 < m_rowStart.size(); y++) {
+        std::sort(m_cells.begin() + m_rowStart[y], m_cells.begin() + m_rowStart[y + 1], byX);
+    }
+}
+
+template <typename Sink>
+void CoverageRasterizer::Render(Sink& sink, COLORREF c, FillRule rule) {
+    SortCells();
+
+    const std::size_t count = m_cells.size();
+    std::size_t i = 0;
+    while (i < count) {
+        const int y = m_cells[i].y;
+        double winding = 0;
+        while (i < count && m_cells[i].y == y) {
+            const int x = m_cells[i].x;
+            double cover = 0, area = 0;
+            for (; i < count && m_cells[i].y == y && m_cells[i].x == x; i++) {
+                cover += m_cells[i].cover;
+                area += m_cells[i].area;
+            }
+
+            // The edges' own cell: the part right of them is inside
+            if (x >= 0) PlotCoverage(sink, x, y, c, CoverageAlpha(winding + cover - area, rule));
+            winding += cover;
+
+            // Interior up to the next cell of the row
+            if (i == count || m_cells[i].y != y) break;
+            int x1 = std::max(x + 1, 0);
+            int x2 = m_cells[i].x - 1;
+            if (x1 > x2) continue;
+            int alpha = CoverageAlpha(winding, rule);
+            if (alpha >= 255) {
+                sink.Span(x1, x2, y, c);
+            } else if (alpha > 0) {
+                for (int px = x1; px <= x2; px++) PlotCoverage(sink, px, y, c, alpha);
+            }
+        }
+    }
+}
+
+// ========================================
+// SHAPES
+// ========================================
+
+// Reused per thread so steady-state fills do not allocate. A clipped sink
+// (a parallel rebuild tile, a display list recording) only needs its rows.
+template <typename Sink>
+static CoverageRasterizer& Rasterizer(const Sink& sink) {
+    thread_local CoverageRasterizer rasterizer;
+    rasterizer.Reset();
+    if constexpr (SinkHasClip<Sink>::value) {
+        rasterizer.SetRows(sink.Clip().top, sink.Clip().bottom);
+    }
+    return rasterizer;
+}
+
+template <typename Sink>
+void FillPolygonAA(Sink& sink, const PolygonPoint p[], int n, COLORREF c, FillRule rule) {
+    if (n < 3) return;
+    CoverageRasterizer& rasterizer = Rasterizer(sink);
+    rasterizer.AddPolygon(p, n);
+    rasterizer.Render(sink, c, rule);
+}
+
+template <typename Sink>
+void FillEllipseAA(Sink& sink, double xc, double yc, double rx, double ry, COLORREF c) {
+    CoverageRasterizer& rasterizer = Rasterizer(sink);
+    rasterizer.AddEllipse(xc, yc, rx, ry);
+    rasterizer.Render(sink, c, FillRule::NON_ZERO);
+}
+
+template <typename Sink>
+void FillPolylineAA(Sink& sink, const BezierPoint p[], int n, COLORREF c, FillRule rule) {
+    if (n < 3) return;
+    CoverageRasterizer& rasterizer = Rasterizer(sink);
+    rasterizer.AddPolygon(p, n);
+    rasterizer.Render(sink, c, rule);
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void CoverageRasterizer::Render<Sink>(Sink&, COLORREF, FillRule); \
+    template void FillPolygonAA<Sink>(Sink&, const PolygonPoint[], int, COLORREF, FillRule); \
+    template void FillEllipseAA<Sink>(Sink&, double, double, double, double, COLORREF); \
+    template void FillPolylineAA<Sink>(Sink&, const BezierPoint[], int, COLORREF, FillRule);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FillPolygonAA(HDC hdc, const PolygonPoint p[], int n, COLORREF c, FillRule rule) {
+    GdiSink sink(hdc);
+    FillPolygonAA(sink, p, n, c, rule);
+}
+
+void FillEllipseAA(HDC hdc, double xc, double yc, double rx, double ry, COLORREF c) {
+    GdiSink sink(hdc);
+    FillEllipseAA(sink, xc, yc, rx, ry, c);
+}
+
+void FillPolylineAA(HDC hdc, const BezierPoint p[], int n, COLORREF c, FillRule rule) {
+    GdiSink sink(hdc);
+    FillPolylineAA(sink, p, n, c, rule);
+}
+#endif
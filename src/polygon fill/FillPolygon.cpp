@@ -0,0 +1,110 @@
+#include "../../include/PolygonFillAlgorithms.h"
+#include <atomic>
+
+// Fills taken by each path since the last reset
+static std::atomic<std::uint64_t> g_convexFills(0);
+static std::atomic<std::uint64_t> g_monotoneFills(0);
+static std::atomic<std::uint64_t> g_generalFills(0);
+
+static int Sign(double v) {
+    return (v > 0) - (v < 0);
+}
+
+// Count sign changes of a cyclic sequence, ignoring zeros
+struct SignFlips {
+    int first = 0, last = 0, flips = 0;
+
+    void Add(int sign) {
+        if (sign == 0) return;
+        if (first == 0) first = sign;
+        else if (sign != last) flips++;
+        last = sign;
+    }
+
+    int Total() const { return flips + (first != 0 && last != first ? 1 : 0); }
+};
+
+PolygonClass ClassifyPolygon(const PolygonPoint p[], int n) {
+    if (n < 3) return PolygonClass::CONVEX;
+
+    SignFlips xFlips, yFlips;
+    bool turnsLeft = false, turnsRight = false;
+    double firstDx = 0, firstDy = 0, prevDx = 0, prevDy = 0;
+    bool havePrev = false;
+
+    auto turn = [&](double dx, double dy) {
+        double cross = prevDx * dy - prevDy * dx;
+        if (cross > 0) turnsLeft = true;
+        else if (cross < 0) turnsRight = true;
+    };
+
+    for (int i = 0; i < n; i++) {
+        const PolygonPoint& a = p[i];
+        const PolygonPoint& b = p[(i + 1) % n];
+        double dx = b.x - a.x, dy = b.y - a.y;
+        if (dx == 0 && dy == 0) continue;  // Repeated vertex
+
+        xFlips.Add(Sign(dx));
+        yFlips.Add(Sign(dy));
+        if (havePrev) {
+            turn(dx, dy);
+        } else {
+            firstDx = dx;
+            firstDy = dy;
+            havePrev = true;
+        }
+        prevDx = dx;
+        prevDy = dy;
+    }
+    if (havePrev) turn(firstDx, firstDy);
+
+    // More than one top and one bottom: some row crosses four edges
+    if (yFlips.Total() > 2) return PolygonClass::GENERAL;
+    // Turning both ways, or winding around more than once, is not convex
+    if ((turnsLeft && turnsRight) || xFlips.Total() > 2) return PolygonClass::MONOTONE;
+    return PolygonClass::CONVEX;
+}
+
+template <typename Sink>
+void FillPolygon(Sink& sink, PolygonPoint p[], int n, COLORREF c) {
+    switch (ClassifyPolygon(p, n)) {
+        case PolygonClass::CONVEX:
+            g_convexFills.fetch_add(1, std::memory_order_relaxed);
+            ConvexFill(sink, p, n, c);
+            break;
+        case PolygonClass::MONOTONE:
+            g_monotoneFills.fetch_add(1, std::memory_order_relaxed);
+            ConvexFill(sink, p, n, c);
+            break;
+        default:
+            g_generalFills.fetch_add(1, std::memory_order_relaxed);
+            NonConvexFill(sink, p, n, c);
+            break;
+    }
+}
+
+PolygonFillStats GetPolygonFillStats() {
+    PolygonFillStats stats;
+    stats.convex = g_convexFills.load(std::memory_order_relaxed);
+    stats.monotone = g_monotoneFills.load(std::memory_order_relaxed);
+    stats.general = g_generalFills.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ResetPolygonFillStats() {
+    g_convexFills = 0;
+    g_monotoneFills = 0;
+    g_generalFills = 0;
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FillPolygon<Sink>(Sink&, PolygonPoint[], int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FillPolygon(HDC hdc, PolygonPoint p[], int n, COLORREF c) {
+    GdiSink sink(hdc);
+    FillPolygon(sink, p, n, c);
+}
+#endif
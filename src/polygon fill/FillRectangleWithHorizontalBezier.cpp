@@ -1,8 +1,10 @@
 #include "../../include/PolygonFillAlgorithms.h"
 #include "../../include/Bezier.h"
+#include "../../include/CurveTessellator.h"
 
 
-void FillRectangleWithHorizontalBezier(HDC hdc, int centerX, int centerY, int vertexX, int vertexY, COLORREF color) {
+template <typename Sink>
+void FillRectangleWithHorizontalBezier(Sink& sink, int centerX, int centerY, int vertexX, int vertexY, COLORREF color) {
 
     int halfWidth = abs(vertexX - centerX);
     int halfHeight = abs(vertexY - centerY);
@@ -13,7 +15,6 @@ void FillRectangleWithHorizontalBezier(HDC hdc, int centerX, int centerY, int ve
     int bottom = centerY + halfHeight;
     
     int width = right - left;
-    int numpoints = std::max(2, width + 1);
     
     int spacing = 1;
     
@@ -31,6 +32,19 @@ void FillRectangleWithHorizontalBezier(HDC hdc, int centerX, int centerY, int ve
         
         controlPoints[3] = BezierPoint(right, y);
         
-        DrawBezierCurve(hdc, controlPoints, 4, numpoints, color);
+        // Flat rows tessellate to a single segment, written as one span
+        DrawBezierCurveAdaptive(sink, controlPoints, 4, color);
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FillRectangleWithHorizontalBezier<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FillRectangleWithHorizontalBezier(HDC hdc, int centerX, int centerY, int vertexX, int vertexY, COLORREF color) {
+    GdiSink sink(hdc);
+    FillRectangleWithHorizontalBezier(sink, centerX, centerY, vertexX, vertexY, color);
+}
+#endif
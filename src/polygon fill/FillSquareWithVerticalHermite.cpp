@@ -1,8 +1,12 @@
 #include "../../include/PolygonFillAlgorithms.h"
+#include "../../include/FrameArena.h"
 #include "../../include/Hermite.h"
+#include <algorithm>
+#include <type_traits>
 
 
-void FillSquareWithVerticalHermite(HDC hdc, int centerX, int centerY, int halfSize, COLORREF color) {
+template <typename Sink>
+void FillSquareWithVerticalHermite(Sink& sink, int centerX, int centerY, int halfSize, COLORREF color) {
     int left   = centerX - halfSize;
     int right  = centerX + halfSize;
     int top    = centerY - halfSize;
@@ -13,7 +17,20 @@ void FillSquareWithVerticalHermite(HDC hdc, int centerX, int centerY, int halfSi
 
     int spacing = 1;
 
-    for (int x = left; x <= right; x += spacing) {
+    // Each column only writes its own x, so a clipped sink (a parallel
+    // rebuild tile, a display list recording) skips the columns outside it
+    int first = left, last = right;
+    if constexpr (SinkHasClip<Sink>::value) {
+        first = std::max(left, sink.Clip().left);
+        last = std::min(right, sink.Clip().right);
+    }
+
+    // One vertical Hermite segment per column, evaluated as a single batch
+    if (first > last) return;
+    ArenaScope scope;
+    HermiteSegment* columns = scope.Arena().Allocate<HermiteSegment>(last - first + 1);
+    int count = 0;
+    for (int x = first; x <= last; x += spacing) {
         HermitePoint P0(x, top);
         HermitePoint P1(x, bottom);
 
@@ -21,6 +38,24 @@ void FillSquareWithVerticalHermite(HDC hdc, int centerX, int centerY, int halfSi
         HermitePoint T0(0, height);
         HermitePoint T1(0, height);
 
-        DrawHermiteCurve(hdc, P0, T0, P1, T1, numpoints, color);
+        columns[count++] = { P0, T0, P1, T1 };
     }
-}
\ No newline at end of file
+
+    // Same sample count DrawHermiteCurve picks for a segment of this length
+    int samples = std::max(numpoints, std::min(1000, height * 2 + 10));
+    int* counts = scope.Arena().Allocate<int>(count);
+    std::fill(counts, counts + count, samples);
+    DrawHermiteSegments(sink, columns, counts, count, color, true);
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FillSquareWithVerticalHermite<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FillSquareWithVerticalHermite(HDC hdc, int centerX, int centerY, int halfSize, COLORREF color) {
+    GdiSink sink(hdc);
+    FillSquareWithVerticalHermite(sink, centerX, centerY, halfSize, color);
+}
+#endif
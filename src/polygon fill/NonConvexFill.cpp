@@ -1,78 +1,128 @@
 #include "../../include/PolygonFillAlgorithms.h"
-
-void initNonConvexEdgeTable(NonConvexEdgeTable& tbl) {
-    for (int i = 0; i < 800; i++) {
-        tbl[i].clear();
-    }
+#include <vector>
+
+// Per-thread working storage, reused so steady-state fills do not allocate
+struct ScanlineScratch {
+    std::vector<Node> edges;       // Edges in input order
+    std::vector<int> edgeRow;      // First row of each edge
+    std::vector<int> bucketStart;  // Edges starting at row y: bucketed[bucketStart[y - top] ..]
+    std::vector<int> bucketNext;   // Fill position per bucket while bucketing
+    std::vector<Node> bucketed;
+    std::vector<Node> active;      // Active edge table, kept sorted by x
+    std::vector<Node> merged;
+};
+
+static ScanlineScratch& Scratch() {
+    thread_local ScanlineScratch scratch;
+    return scratch;
 }
 
-void Edge2NonConvexTable(PolygonPoint* v1, PolygonPoint* v2, NonConvexEdgeTable& t) {
+// Add edge v1-v2 covering rows ceil(ymin) .. ceil(ymax) - 1, clipped to
+// rows [0, MAX_FILL_ROW). Horizontal edges never cross a row and are skipped.
+static void AddEdge(const PolygonPoint& p1, const PolygonPoint& p2, ScanlineScratch& s) {
+    const PolygonPoint* v1 = &p1;
+    const PolygonPoint* v2 = &p2;
     if (v1->y == v2->y) return;
     if (v1->y > v2->y) std::swap(v1, v2);
 
-    double minv = (double)(v2->x - v1->x) / (v2->y - v1->y);
-    int y = (int)ceil(v1->y);
-    double x = v1->x + (y - v1->y) * minv;
+    double minv = (v2->x - v1->x) / (v2->y - v1->y);
+    double first = std::max(std::ceil(v1->y), 0.0);
+    double last = std::min(std::ceil(v2->y), (double)MAX_FILL_ROW);
+    if (first >= last) return;
 
-    t[y].push_back(Node(x, minv, (int)v2->y));
+    int y = (int)first;
+    s.edges.push_back(Node(v1->x + (y - v1->y) * minv, minv, (int)last));
+    s.edgeRow.push_back(y);
 }
 
-void Polygon2NonConvexTable(PolygonPoint p[], int n, NonConvexEdgeTable& t) {
-    PolygonPoint* v1 = &p[n-1];
-    for (int i = 0; i < n; i++) {
-        PolygonPoint* v2 = &p[i];
-        Edge2NonConvexTable(v1, v2, t);
-        v1 = &p[i];
+// Restore x order after the edges moved by one row. Edges only swap where
+// they cross, so this is close to linear.
+static void SortActive(std::vector<Node>& active) {
+    for (size_t i = 1; i < active.size(); i++) {
+        Node node = active[i];
+        size_t j = i;
+        while (j > 0 && active[j - 1].x > node.x) {
+            active[j] = active[j - 1];
+            j--;
+        }
+        active[j] = node;
     }
 }
 
-void NonConvexFill(HDC hdc, PolygonPoint p[], int n, COLORREF c) {
+// Even-odd scanline fill with an active edge table
+template <typename Sink>
+void NonConvexFill(Sink& sink, PolygonPoint p[], int n, COLORREF c) {
     if (n < 3) return;
 
-    NonConvexEdgeTable t;
-    initNonConvexEdgeTable(t);
-    Polygon2NonConvexTable(p, n, t);
-
-    int y = 0;
-    while (y < 800) {
-        if (t[y].empty()) {
-            y++;
-            continue;
-        }
-
-        LList active = t[y];
-
-        while (!active.empty()) {
-            active.sort([](const Node& n1, const Node& n2) {
-                return n1.x < n2.x;
-            });
+    ScanlineScratch& s = Scratch();
+    s.edges.clear();
+    s.edgeRow.clear();
+    for (int i = 0, prev = n - 1; i < n; prev = i++) {
+        AddEdge(p[prev], p[i], s);
+    }
+    if (s.edges.empty()) return;
 
-            auto it = active.begin();
-            while (it != active.end()) {
-                int x1 = (int)ceil(it->x);
-                it++;
-                if (it == active.end()) break;
-                int x2 = (int)floor(it->x);
-                it++;
+    // Bucket the edges by first row; the table spans only the polygon's rows
+    int top = *std::min_element(s.edgeRow.begin(), s.edgeRow.end());
+    int bottom = 0;
+    for (const Node& edge : s.edges) bottom = std::max(bottom, edge.ymax);
 
-                if (x1 <= x2) {
-                    drawLineBresenhamPolygon(hdc, x1, y, x2, y, c);
-                }
-            }
+    s.bucketStart.assign(bottom - top + 1, 0);
+    for (int row : s.edgeRow) s.bucketStart[row - top + 1]++;
+    for (size_t i = 1; i < s.bucketStart.size(); i++) s.bucketStart[i] += s.bucketStart[i - 1];
 
-            y++;
+    s.bucketed.resize(s.edges.size());
+    s.bucketNext.assign(s.bucketStart.begin(), s.bucketStart.end() - 1);
+    for (size_t i = 0; i < s.edges.size(); i++) {
+        s.bucketed[s.bucketNext[s.edgeRow[i] - top]++] = s.edges[i];
+    }
 
-            active.remove_if([y](const Node& node) {
-                return node.ymax <= y;
-            });
+    auto byX = [](const Node& a, const Node& b) { return a.x < b.x; };
+    std::vector<Node>& active = s.active;
+    active.clear();
+    for (int y = top; y < bottom; y++) {
+        // Edges carried over are nearly sorted; entering edges are sorted
+        // on their own and merged in
+        SortActive(active);
+        auto first = s.bucketed.begin() + s.bucketStart[y - top];
+        auto last = s.bucketed.begin() + s.bucketStart[y - top + 1];
+        if (first != last) {
+            std::sort(first, last, byX);
+            s.merged.resize(active.size() + (last - first));
+            std::merge(active.begin(), active.end(), first, last, s.merged.begin(), byX);
+            active.swap(s.merged);
+        }
+        if (active.empty()) continue;
 
-            for (auto& node : active) {
-                node.x += node.minv;
+        for (size_t i = 0; i + 1 < active.size(); i += 2) {
+            int x1 = (int)std::ceil(active[i].x);
+            int x2 = (int)std::floor(active[i + 1].x);
+            if (x1 <= x2) {
+                sink.Span(x1, x2, y, c);
             }
+        }
 
-            if (!t[y].empty()) {
-                active.insert(active.end(), t[y].begin(), t[y].end());
+        // Drop edges that end here and step the rest to the next row
+        size_t kept = 0;
+        for (const Node& edge : active) {
+            if (edge.ymax > y + 1) {
+                active[kept] = edge;
+                active[kept].x += edge.minv;
+                kept++;
             }
         }
+        active.resize(kept);
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void NonConvexFill<Sink>(Sink&, PolygonPoint[], int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void NonConvexFill(HDC hdc, PolygonPoint p[], int n, COLORREF c) {
+    GdiSink sink(hdc);
+    NonConvexFill(sink, p, n, c);
+}
+#endif
@@ -0,0 +1,111 @@
+#include "../../include/TriangleFill.h"
+#include "../../include/PolygonFillAlgorithms.h"
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+// Floor of n / d for d > 0
+static std::int64_t FloorDiv(std::int64_t n, std::int64_t d) {
+    std::int64_t q = n / d;
+    return (n % d != 0 && n < 0) ? q - 1 : q;
+}
+
+// One edge's bound on x, stepped down a row at a time. For the edge function
+// E(x, y) = a*x + b*y + c, E >= 0 solves to x >= -(b*y + c) / a when a > 0
+// and x <= (b*y + c) / -a when a < 0. The quotient is kept as an integer
+// part and remainder, so the bound stays exact without dividing per row.
+struct EdgeWalker {
+    std::int64_t quotient, remainder, divisor;
+    std::int64_t stepQuotient, stepRemainder;
+
+    void Setup(std::int64_t numerator, std::int64_t step, std::int64_t d) {
+        divisor = d;
+        quotient = FloorDiv(numerator, d);
+        remainder = numerator - quotient * d;
+        stepQuotient = FloorDiv(step, d);
+        stepRemainder = step - stepQuotient * d;
+    }
+
+    void Step() {
+        quotient += stepQuotient;
+        remainder += stepRemainder;
+        if (remainder >= divisor) {
+            quotient++;
+            remainder -= divisor;
+        }
+    }
+
+    std::int64_t Floor() const { return quotient; }
+    std::int64_t Ceil() const { return quotient + (remainder != 0); }
+};
+
+template <typename Sink>
+static void FillTriangle(Sink& sink, Point p0, Point p1, Point p2, COLORREF c, const PixelRect& clip) {
+    std::int64_t area = (std::int64_t)(p1.x - p0.x) * (p2.y - p0.y) - (std::int64_t)(p1.y - p0.y) * (p2.x - p0.x);
+    if (area == 0) return;
+    if (area < 0) std::swap(p1, p2);
+
+    // Rows top .. bottom - 1 like the scanline fills; columns inclusive
+    const int left = std::max({ std::min({ p0.x, p1.x, p2.x }), clip.left });
+    const int right = std::min({ std::max({ p0.x, p1.x, p2.x }), clip.right });
+    const int top = std::max({ std::min({ p0.y, p1.y, p2.y }), clip.top });
+    const int bottom = std::min({ std::max({ p0.y, p1.y, p2.y }), clip.bottom + 1 });
+    if (left > right || top >= bottom) return;
+
+    // Each non-horizontal edge bounds the row from the left or the right. A
+    // horizontal edge lies on the top or bottom row and excludes nothing
+    // in between.
+    EdgeWalker lower[2], upper[2];
+    int lowerCount = 0, upperCount = 0;
+    const Point* vertices[3] = { &p0, &p1, &p2 };
+    for (int i = 0; i < 3; i++) {
+        const Point& p = *vertices[i];
+        const Point& q = *vertices[(i + 1) % 3];
+        std::int64_t a = -(std::int64_t)(q.y - p.y);
+        std::int64_t b = (std::int64_t)(q.x - p.x);
+        std::int64_t rowValue = b * top - (a * p.x + b * p.y);  // b*y + c at the top row
+        if (a > 0) {
+            lower[lowerCount++].Setup(-rowValue, -b, a);
+        } else if (a < 0) {
+            upper[upperCount++].Setup(rowValue, b, -a);
+        }
+    }
+
+    for (int y = top; y < bottom; y++) {
+        std::int64_t x1 = left, x2 = right;
+        for (int k = 0; k < lowerCount; k++) {
+            x1 = std::max(x1, lower[k].Ceil());
+            lower[k].Step();
+        }
+        for (int k = 0; k < upperCount; k++) {
+            x2 = std::min(x2, upper[k].Floor());
+            upper[k].Step();
+        }
+        if (x1 <= x2) sink.Span((int)x1, (int)x2, y, c);
+    }
+}
+
+template <typename Sink>
+void FillTriangles(Sink& sink, const Point p[], const int indices[], int indexCount, COLORREF c) {
+    // Rows and columns outside the target are never walked
+    PixelRect clip = { 0, 0, MAX_FILL_ROW - 1, MAX_FILL_ROW - 1 };
+    if constexpr (SinkHasClip<Sink>::value) {
+        clip = sink.Clip();
+    }
+
+    for (int i = 0; i + 2 < indexCount; i += 3) {
+        FillTriangle(sink, p[indices[i]], p[indices[i + 1]], p[indices[i + 2]], c, clip);
+    }
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void FillTriangles<Sink>(Sink&, const Point[], const int[], int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void FillTriangles(HDC hdc, const Point p[], const int indices[], int indexCount, COLORREF c) {
+    GdiSink sink(hdc);
+    FillTriangles(sink, p, indices, indexCount, c);
+}
+#endif
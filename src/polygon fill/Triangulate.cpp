@@ -0,0 +1,142 @@
+#include "../../include/TriangleFill.h"
+#include "../../include/FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+// Coordinates are bounded by MAX_TRIANGLE_COORD, so these are exact
+static std::int64_t Cross(const Point& o, const Point& a, const Point& b) {
+    return (std::int64_t)(a.x - o.x) * (b.y - o.y) - (std::int64_t)(a.y - o.y) * (b.x - o.x);
+}
+
+static int Sign(std::int64_t v) {
+    return (v > 0) - (v < 0);
+}
+
+// c lies on segment a-b, given that the three are collinear
+static bool OnSegment(const Point& a, const Point& b, const Point& c) {
+    return std::min(a.x, b.x) <= c.x && c.x <= std::max(a.x, b.x) &&
+           std::min(a.y, b.y) <= c.y && c.y <= std::max(a.y, b.y);
+}
+
+// Segments a-b and c-d cross or touch
+static bool SegmentsIntersect(const Point& a, const Point& b, const Point& c, const Point& d) {
+    int d1 = Sign(Cross(c, d, a)), d2 = Sign(Cross(c, d, b));
+    int d3 = Sign(Cross(a, b, c)), d4 = Sign(Cross(a, b, d));
+    if (d1 * d2 < 0 && d3 * d4 < 0) return true;
+    return (d1 == 0 && OnSegment(c, d, a)) || (d2 == 0 && OnSegment(c, d, b)) ||
+           (d3 == 0 && OnSegment(a, b, c)) || (d4 == 0 && OnSegment(a, b, d));
+}
+
+// No two non-adjacent edges of the ring meet
+static bool IsSimple(const Point p[], const int ring[], int n) {
+    for (int i = 0; i < n; i++) {
+        const Point& a = p[ring[i]];
+        const Point& b = p[ring[(i + 1) % n]];
+        int minX = std::min(a.x, b.x), maxX = std::max(a.x, b.x);
+        int minY = std::min(a.y, b.y), maxY = std::max(a.y, b.y);
+        for (int j = i + 2; j < n; j++) {
+            if (i == 0 && j == n - 1) continue;  // Adjacent through the wrap
+            const Point& c = p[ring[j]];
+            const Point& d = p[ring[(j + 1) % n]];
+            if (std::max(c.x, d.x) < minX || std::min(c.x, d.x) > maxX ||
+                std::max(c.y, d.y) < minY || std::min(c.y, d.y) > maxY) {
+                continue;
+            }
+            if (SegmentsIntersect(a, b, c, d)) return false;
+        }
+    }
+    return true;
+}
+
+// Inside or on triangle a-b-c, which has positive orientation
+static bool InTriangle(const Point& a, const Point& b, const Point& c, const Point& q) {
+    return Cross(a, b, q) >= 0 && Cross(b, c, q) >= 0 && Cross(c, a, q) >= 0;
+}
+
+static bool SamePoint(const Point& a, const Point& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+bool TriangulatePolygon(const Point p[], int n, std::vector<int>& triangles) {
+    triangles.clear();
+    if (n < 3 || n > MAX_TRIANGULATED_VERTICES) return false;
+
+    // Drop repeated vertices; reject coordinates the edge functions can't take.
+    // The ring and its links are scratch from the thread's arena.
+    ArenaScope scope;
+    int* ring = scope.Arena().Allocate<int>(n);
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        if (std::abs(p[i].x) > MAX_TRIANGLE_COORD || std::abs(p[i].y) > MAX_TRIANGLE_COORD) return false;
+        if (m > 0 && SamePoint(p[ring[m - 1]], p[i])) continue;
+        ring[m++] = i;
+    }
+    while (m > 1 && SamePoint(p[ring[m - 1]], p[ring[0]])) m--;
+    if (m < 3 || !IsSimple(p, ring, m)) return false;
+
+    // Ears are convex vertices, so fix a positive orientation
+    std::int64_t area = 0;
+    for (int i = 0; i < m; i++) {
+        const Point& a = p[ring[i]];
+        const Point& b = p[ring[(i + 1) % m]];
+        area += (std::int64_t)a.x * b.y - (std::int64_t)b.x * a.y;
+    }
+    if (area == 0) return false;
+    if (area < 0) std::reverse(ring, ring + m);
+
+    int* prev = scope.Arena().Allocate<int>(m);
+    int* next = scope.Arena().Allocate<int>(m);
+    for (int i = 0; i < m; i++) {
+        prev[i] = (i + m - 1) % m;
+        next[i] = (i + 1) % m;
+    }
+
+    // v is an ear when it is convex (or a straight continuation) and no
+    // other remaining vertex lies in the triangle it cuts off
+    auto isEar = [&](int v) {
+        const Point& a = p[ring[prev[v]]];
+        const Point& b = p[ring[v]];
+        const Point& c = p[ring[next[v]]];
+        std::int64_t turn = Cross(a, b, c);
+        if (turn < 0) return false;
+        if (turn == 0) {
+            // Collinear: removable unless the outline doubles back here
+            return (std::int64_t)(b.x - a.x) * (c.x - b.x) + (std::int64_t)(b.y - a.y) * (c.y - b.y) > 0;
+        }
+        for (int r = next[next[v]]; r != prev[v]; r = next[r]) {
+            const Point& q = p[ring[r]];
+            if (SamePoint(q, a) || SamePoint(q, b) || SamePoint(q, c)) continue;
+            if (InTriangle(a, b, c, q)) return false;
+        }
+        return true;
+    };
+
+    triangles.reserve(3 * (m - 2));
+    int remaining = m, v = 0, misses = 0;
+    while (remaining > 3) {
+        if (isEar(v)) {
+            int u = prev[v], w = next[v];
+            if (Cross(p[ring[u]], p[ring[v]], p[ring[w]]) != 0) {
+                triangles.push_back(ring[u]);
+                triangles.push_back(ring[v]);
+                triangles.push_back(ring[w]);
+            }
+            next[u] = w;
+            prev[w] = u;
+            remaining--;
+            misses = 0;
+            v = w;
+        } else {
+            v = next[v];
+            if (++misses > remaining) {
+                triangles.clear();  // No ear left: not triangulable as given
+                return false;
+            }
+        }
+    }
+    triangles.push_back(ring[prev[v]]);
+    triangles.push_back(ring[v]);
+    triangles.push_back(ring[next[v]]);
+    return true;
+}
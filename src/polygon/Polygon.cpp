@@ -1,16 +1,28 @@
-#include <windows.h>
 #include "../../include/PolygonAlgorithms.h"
 
-void DrawPolygon(HDC hdc , vector<Point> points , COLORREF c) {
+template <typename Sink>
+void DrawPolygon(Sink& sink, const Point* points, int n, COLORREF c) {
 
     // Draw polygon outline
-    for (size_t i = 0; i < points.size() - 1; i++) {
-        DrawLineBresenham(hdc, points[i].x, points[i].y,
+    for (int i = 0; i < n - 1; i++) {
+        DrawLineBresenham(sink, points[i].x, points[i].y,
                          points[i + 1].x, points[i + 1].y, c);
     }
     // Close the polygon
-    DrawLineBresenham(hdc, points.back().x, points.back().y,
+    DrawLineBresenham(sink, points[n - 1].x, points[n - 1].y,
                      points[0].x, points[0].y, c);
 
 
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawPolygon<Sink>(Sink&, const Point*, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawPolygon(HDC hdc, vector<Point> points, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawPolygon(sink, points.data(), (int)points.size(), c);
+}
+#endif
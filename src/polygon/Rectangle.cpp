@@ -1,9 +1,9 @@
-#include <windows.h>
 #include <cmath>
 #include "../../include/PolygonAlgorithms.h"
 
 
-void DrawRectangle(HDC hdc, int centerX, int centerY, int vertexX, int vertexY, COLORREF c) {
+template <typename Sink>
+void DrawRectangle(Sink& sink, int centerX, int centerY, int vertexX, int vertexY, COLORREF c) {
     
     int halfWidth = abs(vertexX - centerX);
     int halfHeight = abs(vertexY - centerY);
@@ -13,8 +13,20 @@ void DrawRectangle(HDC hdc, int centerX, int centerY, int vertexX, int vertexY,
     int top = centerY - halfHeight;
     int bottom = centerY + halfHeight;
     
-    DrawLineBresenham(hdc, left, top, right, top, c);
-    DrawLineBresenham(hdc, right, top, right, bottom, c);
-    DrawLineBresenham(hdc, right, bottom, left, bottom, c);
-    DrawLineBresenham(hdc, left, bottom, left, top, c);
+    DrawLineBresenham(sink, left, top, right, top, c);
+    DrawLineBresenham(sink, right, top, right, bottom, c);
+    DrawLineBresenham(sink, right, bottom, left, bottom, c);
+    DrawLineBresenham(sink, left, bottom, left, top, c);
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawRectangle<Sink>(Sink&, int, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawRectangle(HDC hdc, int centerX, int centerY, int vertexX, int vertexY, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawRectangle(sink, centerX, centerY, vertexX, vertexY, c);
 }
+#endif
@@ -1,15 +1,27 @@
-#include <windows.h>
 #include "../../include/PolygonAlgorithms.h"
 
-void DrawSquare(HDC hdc, int centerX, int centerY, int halfSize, COLORREF c) {
+template <typename Sink>
+void DrawSquare(Sink& sink, int centerX, int centerY, int halfSize, COLORREF c) {
    
     int left = centerX - halfSize;
     int right = centerX + halfSize;
     int top = centerY - halfSize;
     int bottom = centerY + halfSize;
     
-    DrawLineBresenham(hdc, left, top, right, top, c);      
-    DrawLineBresenham(hdc, right, top, right, bottom, c);  
-    DrawLineBresenham(hdc, right, bottom, left, bottom, c); 
-    DrawLineBresenham(hdc, left, bottom, left, top, c);   
+    DrawLineBresenham(sink, left, top, right, top, c);      
+    DrawLineBresenham(sink, right, top, right, bottom, c);  
+    DrawLineBresenham(sink, right, bottom, left, bottom, c); 
+    DrawLineBresenham(sink, left, bottom, left, top, c);   
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DrawSquare<Sink>(Sink&, int, int, int, COLORREF);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void DrawSquare(HDC hdc, int centerX, int centerY, int halfSize, COLORREF c) {
+    GdiSink sink(hdc);
+    DrawSquare(sink, centerX, centerY, halfSize, c);
 }
+#endif
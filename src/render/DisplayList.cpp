@@ -0,0 +1,336 @@
+#include "../../include/DisplayList.h"
+#include "../../include/ShapeRenderer.h"
+#include <algorithm>
+#include <type_traits>
+
+// ========================================
+// DISPLAY LIST
+// ========================================
+
+// Stable counting sort by row, then by x within each row. Rows hold few
+// entries and most arrive in x order (outlines, column-by-column fills),
+// so this stays close to linear where a comparison sort would not.
+template <typename Entry, typename Key>
+static void SortByRow(std::vector<Entry>& entries, std::vector<Entry>& scratch, Key x) {
+    if (entries.size() < 2) return;
+    int top = entries[0].y, bottom = entries[0].y;
+    for (const Entry& entry : entries) {
+        top = std::min(top, entry.y);
+        bottom = std::max(bottom, entry.y);
+    }
+
+    thread_local std::vector<std::uint32_t> rowStart;
+    rowStart.assign((std::size_t)(bottom - top) + 2, 0);
+    for (const Entry& entry : entries) rowStart[entry.y - top + 1]++;
+    for (std::size_t y = 1; y < rowStart.size(); y++) rowStart[y] += rowStart[y - 1];
+    scratch.resize(entries.size());
+    for (const Entry& entry : entries) scratch[rowStart[entry.y - top]++] = entry;
+    entries.swap(scratch);
+
+    // rowStart[y] is now where row y ends
+    auto byX = [&x](const Entry& a, const Entry& b) { return x(a) < x(b); };
+    for (std::size_t y = 0, begin = 0; y + 1 < rowStart.size(); begin = rowStart[y++]) {
+        auto first = entries.begin() + begin, last = entries.begin() + rowStart[y];
+        if (!std::is_sorted(first, last, byX)) std::sort(first, last, byX);
+    }
+}
+
+bool DisplayList::Build(DisplayListSink& recording) {
+    m_color = recording.Color();
+    m_runs = std::vector<Run>();
+    m_coverage = std::vector<CoverageRun>();
+    m_alpha = std::vector<std::uint8_t>();
+
+    std::vector<RecordedSpan>& spans = recording.Spans();
+    std::vector<RecordedCoverage>& coverage = recording.Coverage();
+    if (spans.empty() && coverage.empty()) return true;
+    int left = spans.empty() ? coverage[0].x : spans[0].x1, right = left;
+    int top = spans.empty() ? coverage[0].y : spans[0].y, bottom = top;
+    for (const RecordedSpan& span : spans) {
+        left = std::min(left, span.x1);
+        right = std::max(right, span.x2);
+        top = std::min(top, span.y);
+        bottom = std::max(bottom, span.y);
+    }
+    for (const RecordedCoverage& pixel : coverage) {
+        left = std::min(left, pixel.x);
+        right = std::max(right, pixel.x);
+        top = std::min(top, pixel.y);
+        bottom = std::max(bottom, pixel.y);
+    }
+    if ((std::int64_t)right - left > 0xFFFF || (std::int64_t)bottom - top > 0xFFFF) return false;
+    m_left = left;
+    m_top = top;
+
+    // Outline algorithms plot in octant or segment order and fills may go
+    // column by column; sorted by row the runs merge and replay walks
+    // memory forward
+    // Compiled into scratch first so each array is allocated once, at size
+    thread_local std::vector<RecordedSpan> spanScratch;
+    thread_local std::vector<Run> runs;
+    SortByRow(spans, spanScratch, [](const RecordedSpan& span) { return span.x1; });
+    runs.clear();
+    for (const RecordedSpan& span : spans) {
+        const std::uint16_t row = (std::uint16_t)(span.y - top);
+        const std::uint16_t x1 = (std::uint16_t)(span.x1 - left), x2 = (std::uint16_t)(span.x2 - left);
+        if (!runs.empty() && runs.back().row == row && x1 <= runs.back().x2 + 1) {
+            runs.back().x2 = std::max(runs.back().x2, x2);
+        } else {
+            runs.push_back({ row, x1, x2 });
+        }
+    }
+    m_runs.assign(runs.begin(), runs.end());
+
+    thread_local std::vector<RecordedCoverage> coverageScratch;
+    thread_local std::vector<CoverageRun> coverageRuns;
+    SortByRow(coverage, coverageScratch, [](const RecordedCoverage& pixel) { return pixel.x; });
+    coverageRuns.clear();
+    for (const RecordedCoverage& pixel : coverage) {
+        const std::uint16_t row = (std::uint16_t)(pixel.y - top), x = (std::uint16_t)(pixel.x - left);
+        if (!coverageRuns.empty() && coverageRuns.back().row == row && coverageRuns.back().x2 + 1 == x) {
+            coverageRuns.back().x2++;
+        } else {
+            coverageRuns.push_back({ row, x, x, 0 });
+        }
+    }
+    // Alpha offsets: the pixels of the runs before
+    std::uint32_t offset = 0;
+    for (CoverageRun& run : coverageRuns) {
+        run.alpha = offset;
+        offset += run.x2 - run.x1 + 1;
+    }
+    m_coverage.assign(coverageRuns.begin(), coverageRuns.end());
+    m_alpha.resize(coverage.size());
+    for (std::size_t k = 0; k < coverage.size(); k++) m_alpha[k] = (std::uint8_t)coverage[k].alpha;
+    return true;
+}
+
+template <typename Sink>
+void DisplayList::Replay(Sink& sink) const {
+    auto runs = m_runs.begin(), runsEnd = m_runs.end();
+    auto coverage = m_coverage.begin(), coverageEnd = m_coverage.end();
+    if constexpr (SinkHasClip<Sink>::value) {
+        const PixelRect& clip = sink.Clip();
+        if (clip.bottom < m_top || clip.top - m_top > 0xFFFF) return;
+        const int first = std::max(clip.top - m_top, 0), end = std::min(clip.bottom - m_top, 0xFFFF) + 1;
+        auto above = [](const auto& run, int row) { return run.row < row; };
+        runs = std::lower_bound(runs, runsEnd, first, above);
+        runsEnd = std::lower_bound(runs, runsEnd, end, above);
+        coverage = std::lower_bound(coverage, coverageEnd, first, above);
+        coverageEnd = std::lower_bound(coverage, coverageEnd, end, above);
+    }
+
+    for (; runs != runsEnd; ++runs) {
+        const int y = m_top + runs->row;
+        if (runs->x1 == runs->x2) {
+            sink.Plot(m_left + runs->x1, y, m_color);
+        } else {
+            sink.Span(m_left + runs->x1, m_left + runs->x2, y, m_color);
+        }
+    }
+    for (; coverage != coverageEnd; ++coverage) {
+        const int y = m_top + coverage->row;
+        const std::uint8_t* alpha = m_alpha.data() + coverage->alpha;
+        for (int x = m_left + coverage->x1; x <= m_left + coverage->x2; x++, alpha++) {
+            COLORREF under = sink.Read(x, y);
+            if (under != CLR_INVALID) sink.Plot(x, y, BlendColor(under, m_color, *alpha));
+        }
+    }
+}
+
+std::size_t DisplayList::Bytes() const {
+    return sizeof(DisplayList) + m_runs.capacity() * sizeof(Run) +
+           m_coverage.capacity() * sizeof(CoverageRun) + m_alpha.capacity();
+}
+
+std::size_t DisplayList::Pixels() const {
+    std::size_t pixels = m_alpha.size();
+    for (const Run& run : m_runs) pixels += (std::size_t)(run.x2 - run.x1 + 1);
+    return pixels;
+}
+
+bool RecordDisplayList(const ShapeView& shape, const PixelRect& clip, DisplayList& list) {
+    // Reused per thread so recording does not grow fresh buffers each time
+    thread_local DisplayListSink recording;
+    recording.Reset(clip, shape.color);
+    RenderShape(recording, shape);
+    return !recording.Mixed() && list.Build(recording);
+}
+
+// ========================================
+// CACHE
+// ========================================
+
+// FNV-1a over everything RenderShape reads from the shape
+static std::uint64_t ShapeKey(const ShapeView& shape) {
+    std::uint64_t hash = 1469598103934665603ull;
+    auto add = [&hash](std::uint64_t value) {
+        for (int i = 0; i < 8; i++, value >>= 8) {
+            hash = (hash ^ (value & 0xFF)) * 1099511628211ull;
+        }
+    };
+    add((std::uint64_t)shape.mode);
+    add((std::uint64_t)shape.color);
+    add((std::uint64_t)shape.fillMode);
+    add((std::uint64_t)(std::uint32_t)shape.thickness);
+    for (const Point& p : shape.points) add((std::uint64_t)(std::uint32_t)p.x << 32 | (std::uint32_t)p.y);
+    for (const FillSpan& span : shape.spans) {
+        add((std::uint64_t)(std::uint32_t)span.y << 32 | (std::uint32_t)span.x1);
+        add((std::uint64_t)(std::uint32_t)span.x2);
+    }
+    return hash;
+}
+
+DisplayListCache::DisplayListCache(std::size_t budget) {
+    m_stats.budget = budget;
+}
+
+void DisplayListCache::Link(std::uint32_t i) {
+    Entry& entry = m_entries[i];
+    entry.prev = NONE;
+    entry.next = m_head;
+    if (m_head != NONE) m_entries[m_head].prev = i;
+    m_head = i;
+    if (m_tail == NONE) m_tail = i;
+}
+
+void DisplayListCache::Unlink(std::uint32_t i) {
+    Entry& entry = m_entries[i];
+    if (entry.prev != NONE) m_entries[entry.prev].next = entry.next; else m_head = entry.next;
+    if (entry.next != NONE) m_entries[entry.next].prev = entry.prev; else m_tail = entry.prev;
+    entry.prev = entry.next = NONE;
+}
+
+void DisplayListCache::Drop(std::uint32_t i) {
+    Entry& entry = m_entries[i];
+    Unlink(i);
+    m_stats.bytes -= entry.list->Bytes();
+    m_stats.lists--;
+    entry.list.reset();
+    entry.state = EMPTY;
+}
+
+bool DisplayListCache::MakeRoom(std::size_t bytes) {
+    // Lists drawn this frame are all ahead of the others in LRU order
+    while (m_stats.bytes + bytes > m_stats.budget && m_tail != NONE && m_entries[m_tail].frame != m_frame) {
+        Drop(m_tail);
+        m_stats.evictions++;
+    }
+    return m_stats.bytes + bytes <= m_stats.budget;
+}
+
+void DisplayListCache::SetBudget(std::size_t bytes) {
+    m_stats.budget = bytes;
+    while (m_stats.bytes > bytes && m_tail != NONE) {
+        Drop(m_tail);
+        m_stats.evictions++;
+    }
+    // Shapes turned away for lack of room get another chance
+    for (Entry& entry : m_entries) {
+        if (entry.state == DIRECT) entry.state = EMPTY;
+    }
+}
+
+void DisplayListCache::Clear() {
+    m_entries.clear();
+    m_head = m_tail = NONE;
+    m_stats.lists = 0;
+    m_stats.bytes = 0;
+}
+
+void DisplayListCache::ResetCounters() {
+    m_stats.hits = m_stats.misses = m_stats.direct = m_stats.evictions = 0;
+}
+
+void DisplayListCache::BeginFrame(std::size_t shapes, int width, int height) {
+    if (width != m_width || height != m_height) {
+        Clear();
+        m_width = width;
+        m_height = height;
+    }
+    while (m_entries.size() > shapes) {
+        if (m_entries.back().state == HELD) Drop((std::uint32_t)(m_entries.size() - 1));
+        m_entries.pop_back();
+    }
+    m_entries.resize(shapes);
+    m_frame++;
+}
+
+const DisplayList* DisplayListCache::Find(std::size_t i, const ShapeView& shape, bool& record) {
+    record = false;
+    if (i >= m_entries.size()) m_entries.resize(i + 1);
+    Entry& entry = m_entries[i];
+    const std::uint64_t key = ShapeKey(shape);
+    if (entry.state != EMPTY && entry.key == key) {
+        if (entry.state == DIRECT) {
+            m_stats.direct++;
+            return nullptr;
+        }
+        entry.frame = m_frame;
+        Unlink((std::uint32_t)i);
+        Link((std::uint32_t)i);
+        m_stats.hits++;
+        return entry.list.get();
+    }
+
+    // New, evicted or changed since its list was recorded
+    if (entry.state == HELD) Drop((std::uint32_t)i);
+    entry.key = key;
+    PixelRect bounds;
+    if (shape.mode == DrawingMode::FLOOD_FILL || !GetShapeBounds(shape, bounds) || m_width <= 0 || m_height <= 0) {
+        entry.state = DIRECT;
+        m_stats.direct++;
+        return nullptr;
+    }
+    entry.state = EMPTY;
+    record = true;
+    m_stats.misses++;
+    return nullptr;
+}
+
+const DisplayList* DisplayListCache::Store(std::size_t i, DisplayList& list) {
+    Entry& entry = m_entries[i];
+    if (!MakeRoom(list.Bytes())) {
+        entry.state = DIRECT;
+        return nullptr;
+    }
+    entry.list.reset(new DisplayList(std::move(list)));
+    entry.state = HELD;
+    entry.frame = m_frame;
+    Link((std::uint32_t)i);
+    m_stats.lists++;
+    m_stats.bytes += entry.list->Bytes();
+    return entry.list.get();
+}
+
+void DisplayListCache::Reject(std::size_t i) {
+    m_entries[i].state = DIRECT;
+}
+
+template <typename Sink>
+void DisplayListCache::Render(Sink& sink, const ShapeView& shape, std::size_t i) {
+    bool record;
+    const DisplayList* list = Find(i, shape, record);
+    DisplayList recorded;
+    if (record) {
+        if (RecordDisplayList(shape, Canvas(), recorded)) {
+            // Drawn from the recording this time even when it isn't kept
+            list = Store(i, recorded);
+            if (!list) list = &recorded;
+        } else {
+            Reject(i);
+        }
+    }
+    if (list) {
+        list->Replay(sink);
+    } else {
+        RenderShape(sink, shape);
+    }
+}
+
+// Coverage is blended with what the sink holds, so only readable sinks
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void DisplayList::Replay<Sink>(Sink&) const; \
+    template void DisplayListCache::Render<Sink>(Sink&, const ShapeView&, std::size_t);
+FOR_EACH_READABLE_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
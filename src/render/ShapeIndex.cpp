@@ -0,0 +1,215 @@
+#include "../../include/ShapeIndex.h"
+#include "../../include/ShapeRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+ShapeIndex::ShapeIndex(int cellSize) : m_cellSize(std::max(cellSize, 8)) {}
+
+bool ShapeIndex::CellRange(const PixelRect& rect, int& cx1, int& cy1, int& cx2, int& cy2) const {
+    if (rect.IsEmpty() || rect.right < 0 || rect.bottom < 0 || rect.left >= m_width || rect.top >= m_height) {
+        return false;
+    }
+    cx1 = std::max(rect.left, 0) / m_cellSize;
+    cy1 = std::max(rect.top, 0) / m_cellSize;
+    cx2 = std::min(rect.right, m_width - 1) / m_cellSize;
+    cy2 = std::min(rect.bottom, m_height - 1) / m_cellSize;
+    return true;
+}
+
+// Shapes are inserted in increasing order except by Update, so appending
+// is the common case
+void ShapeIndex::Insert(std::uint32_t i) {
+    int cx1, cy1, cx2, cy2;
+    if (!CellRange(m_bounds[i], cx1, cy1, cx2, cy2)) return;
+    for (int cy = cy1; cy <= cy2; cy++) {
+        for (int cx = cx1; cx <= cx2; cx++) {
+            std::vector<std::uint32_t>& cell = m_cells[(std::size_t)cy * m_cellsX + cx];
+            if (cell.empty() || cell.back() < i) {
+                cell.push_back(i);
+            } else {
+                cell.insert(std::lower_bound(cell.begin(), cell.end(), i), i);
+            }
+        }
+    }
+}
+
+void ShapeIndex::Remove(std::uint32_t i) {
+    int cx1, cy1, cx2, cy2;
+    if (!CellRange(m_bounds[i], cx1, cy1, cx2, cy2)) return;
+    for (int cy = cy1; cy <= cy2; cy++) {
+        for (int cx = cx1; cx <= cx2; cx++) {
+            std::vector<std::uint32_t>& cell = m_cells[(std::size_t)cy * m_cellsX + cx];
+            auto it = std::lower_bound(cell.begin(), cell.end(), i);
+            if (it != cell.end() && *it == i) cell.erase(it);
+        }
+    }
+}
+
+void ShapeIndex::Build(const Scene& scene, int width, int height) {
+    m_width = std::max(width, 0);
+    m_height = std::max(height, 0);
+    m_cellsX = (m_width + m_cellSize - 1) / m_cellSize;
+    m_cellsY = (m_height + m_cellSize - 1) / m_cellSize;
+    m_cells.assign((std::size_t)m_cellsX * m_cellsY, std::vector<std::uint32_t>());
+    m_bounds.clear();
+    m_bounded.clear();
+    m_stamps.clear();
+    m_unbounded = 0;
+    m_bounds.reserve(scene.Size());
+    m_bounded.reserve(scene.Size());
+    while (Count() < scene.Size()) Add(scene);
+}
+
+void ShapeIndex::Clear() {
+    for (auto& cell : m_cells) cell.clear();
+    m_bounds.clear();
+    m_bounded.clear();
+    m_stamps.clear();
+    m_unbounded = 0;
+}
+
+void ShapeIndex::Add(const Scene& scene) {
+    const std::size_t i = Count();
+    m_bounds.push_back(scene.Bounds(i));
+    m_bounded.push_back(scene.IsBounded(i));
+    m_stamps.push_back(0);
+    if (!scene.IsBounded(i)) m_unbounded++;
+    Insert((std::uint32_t)i);
+}
+
+void ShapeIndex::Update(const Scene& scene, std::size_t i) {
+    Remove((std::uint32_t)i);
+    if (!m_bounded[i]) m_unbounded--;
+
+    m_bounds[i] = scene.Bounds(i);
+    m_bounded[i] = scene.IsBounded(i);
+    if (!m_bounded[i]) m_unbounded++;
+    Insert((std::uint32_t)i);
+}
+
+void ShapeIndex::Query(const PixelRect& rect, std::vector<std::uint32_t>& shapes) {
+    shapes.clear();
+    int cx1, cy1, cx2, cy2;
+    if (!CellRange(rect, cx1, cy1, cx2, cy2)) return;
+
+    // A new stamp per query; on wrap-around the old stamps are reset
+    if (++m_stamp == 0) {
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_stamp = 1;
+    }
+    for (int cy = cy1; cy <= cy2; cy++) {
+        for (int cx = cx1; cx <= cx2; cx++) {
+            for (std::uint32_t i : m_cells[(std::size_t)cy * m_cellsX + cx]) {
+                if (m_stamps[i] == m_stamp) continue;
+                m_stamps[i] = m_stamp;
+                const PixelRect& b = m_bounds[i];
+                if (b.right < rect.left || b.left > rect.right || b.bottom < rect.top || b.top > rect.bottom) continue;
+                shapes.push_back(i);
+            }
+        }
+    }
+    std::sort(shapes.begin(), shapes.end());
+}
+
+std::ptrdiff_t ShapeIndex::HitTest(const Scene& scene, int x, int y,
+                                   const std::function<bool(const ShapeView&)>& accept) const {
+    if ((unsigned)x >= (unsigned)m_width || (unsigned)y >= (unsigned)m_height) return -1;
+    for (std::uint32_t i : m_cells[(std::size_t)(y / m_cellSize) * m_cellsX + x / m_cellSize]) {
+        const PixelRect& b = m_bounds[i];
+        if (x < b.left || x > b.right || y < b.top || y > b.bottom) continue;
+        ShapeView shape = scene.View(i);
+        if (accept(shape) && ShapeContainsPoint(shape, x, y)) return (std::ptrdiff_t)i;
+    }
+    return -1;
+}
+
+// ========================================
+// HIT TESTS
+// ========================================
+
+// Non-zero winding number of the closed contour around (x, y); points on
+// an edge count as inside
+static bool ContourContains(const std::vector<BezierPoint>& contour, double x, double y) {
+    int winding = 0;
+    for (std::size_t i = 0, n = contour.size(); i < n; i++) {
+        const BezierPoint& a = contour[i];
+        const BezierPoint& b = contour[(i + 1) % n];
+        // > 0 when (x, y) is left of a -> b
+        double side = (b.x - a.x) * (y - a.y) - (x - a.x) * (b.y - a.y);
+        if (side == 0 && std::min(a.x, b.x) <= x && x <= std::max(a.x, b.x) &&
+            std::min(a.y, b.y) <= y && y <= std::max(a.y, b.y)) {
+            return true;
+        }
+        if (a.y <= y) {
+            if (b.y > y && side > 0) winding++;  // Upward crossing right of the point
+        } else if (b.y <= y && side < 0) {
+            winding--;                           // Downward crossing
+        }
+    }
+    return winding != 0;
+}
+
+bool ShapeContainsPoint(const ShapeView& shape, int x, int y) {
+    if (shape.points.size() < 2 || shape.mode == DrawingMode::FLOOD_FILL) return false;
+    const ShapeGeometry g = shape.geometry ? *shape.geometry : GetShapeGeometry(shape);
+    const std::int64_t dx = (std::int64_t)x - g.center.x, dy = (std::int64_t)y - g.center.y;
+    const std::int64_t rx = g.rx, ry = g.ry;
+
+    switch (shape.mode) {
+        case DrawingMode::CIRCLE_DIRECT:
+        case DrawingMode::CIRCLE_POLAR:
+        case DrawingMode::CIRCLE_ITERATIVE_POLAR:
+        case DrawingMode::CIRCLE_MIDPOINT:
+        case DrawingMode::CIRCLE_MODIFIED_MIDPOINT:
+            // The radius the circle is drawn with
+            return dx * dx + dy * dy <= rx * rx;
+
+        case DrawingMode::ELLIPSE_DIRECT:
+        case DrawingMode::ELLIPSE_POLAR:
+        case DrawingMode::ELLIPSE_MIDPOINT:
+        {
+            // (dx / rx)^2 + (dy / ry)^2 <= 1 without dividing
+            double rx2 = (double)(rx * rx), ry2 = (double)(ry * ry);
+            if (rx2 == 0 || ry2 == 0) return false;
+            return (double)(dx * dx) * ry2 + (double)(dy * dy) * rx2 <= rx2 * ry2;
+        }
+
+        case DrawingMode::SQUARE:
+        case DrawingMode::RECTANGLE:
+            return std::abs(dx) <= rx && std::abs(dy) <= ry;
+
+        default:
+        {
+            // Reused per thread so repeated hit tests do not allocate
+            thread_local std::vector<BezierPoint> contour;
+            return GetFillContour(shape, contour) && ContourContains(contour, x, y);
+        }
+    }
+}
+
+bool RedrawRegion(Framebuffer& framebuffer, const Scene& scene, ShapeIndex& index,
+                  const PixelRect& region, COLORREF background, DisplayListCache* displayLists) {
+    if (index.UnboundedCount() > 0) return false;
+
+    PixelRect clip = { std::max(region.left, 0), std::max(region.top, 0),
+                       std::min(region.right, framebuffer.Width() - 1), std::min(region.bottom, framebuffer.Height() - 1) };
+    if (clip.IsEmpty()) return true;
+
+    // Every pixel of the region sees the shapes that touch it in drawing
+    // order, the same as in a full rebuild
+    thread_local std::vector<std::uint32_t> hits;
+    index.Query(clip, hits);
+    BgraSink sink(framebuffer, clip, DirtyTracking::OFF);
+    for (int y = clip.top; y <= clip.bottom; y++) {
+        sink.Span(clip.left, clip.right, y, background);
+    }
+    if (displayLists) {
+        displayLists->BeginFrame(scene.Size(), framebuffer.Width(), framebuffer.Height());
+        for (std::uint32_t i : hits) displayLists->Render(sink, scene.View(i), i);
+    } else {
+        for (std::uint32_t i : hits) RenderShape(sink, scene.View(i));
+    }
+    framebuffer.MarkDirty(clip.left, clip.top, clip.right, clip.bottom);
+    return true;
+}
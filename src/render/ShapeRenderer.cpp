@@ -0,0 +1,454 @@
+#include "../../include/ShapeRenderer.h"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <type_traits>
+#include "../../include/LineAlgorithms.h"
+#include "../../include/CircleAlgorithms.h"
+#include "../../include/EllipseAlgorithms.h"
+#include "../../include/CircleFillAlgorithms.h"
+#include "../../include/PolygonFillAlgorithms.h"
+#include "../../include/PolygonAlgorithms.h"
+#include "../../include/Hermite.h"
+#include "../../include/Bezier.h"
+#include "../../include/CardinalSpline.h"
+#include "../../include/CurveTessellator.h"
+#include "../../include/FloodFill.h"
+#include "../../include/CoverageRasterizer.h"
+#include "../../include/FrameArena.h"
+
+// Flood fills read the target back, so they only run on readable sinks.
+// Recording and counting sinks skip them. Framebuffer memory gets the
+// scanline span fill.
+template <typename Sink>
+static void ApplyFloodFill(Sink& sink, const ShapeView& shape) {
+    if constexpr (std::is_same<Sink, BgraSink>::value) {
+        // Both modes fill the same 4-connected region; on pixel memory the
+        // span fill does it without a per-pixel stack
+        if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON ||
+            shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON ||
+            shape.fillMode == FillMode::FLOOD_FILL_PARALLEL_POLYGON) {
+            COLORREF bgColor = sink.Read(shape.points[0].x, shape.points[0].y);
+            if (bgColor != shape.color) {
+                FloodFillScanline(sink, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
+            }
+        }
+    } else if constexpr (SinkCanRead<Sink>::value) {
+        if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
+            COLORREF bgColor = sink.Read(shape.points[0].x, shape.points[0].y);
+            FloodFillRecursive(sink, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
+        } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
+            COLORREF bgColor = sink.Read(shape.points[0].x, shape.points[0].y);
+            FloodFillNonRecursive(sink, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
+        }
+    }
+}
+
+// The shape's points converted to T, in 'arena'
+template <typename T>
+static T* ConvertPoints(FrameArena& arena, const ArrayView<Point>& points) {
+    T* converted = arena.Allocate<T>(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) converted[i] = T(points[i].x, points[i].y);
+    return converted;
+}
+
+bool GetFillContour(const ShapeView& shape, std::vector<BezierPoint>& contour) {
+    contour.clear();
+    const ArrayView<Point>& p = shape.points;
+    if (p.size() < 2) return false;
+
+    switch (shape.mode) {
+        case DrawingMode::POLYGON:
+            for (const Point& point : p) contour.push_back(BezierPoint(point.x, point.y));
+            break;
+
+        case DrawingMode::CURVE_BEZIER:
+        {
+            ArenaScope scope;
+            const BezierPoint* control = ConvertPoints<BezierPoint>(scope.Arena(), p);
+            contour.push_back(control[0]);
+            FlattenBezier(control, (int)p.size(), COVERAGE_CURVE_TOLERANCE, contour);
+            break;
+        }
+
+        case DrawingMode::CURVE_CARDINAL:
+        {
+            ArenaScope scope;
+            const HermitePoint* knots = ConvertPoints<HermitePoint>(scope.Arena(), p);
+            contour.push_back(BezierPoint(p[0].x, p[0].y));
+            FlattenCardinalSpline(knots, (int)p.size(), 0.5, COVERAGE_CURVE_TOLERANCE, contour);
+            break;
+        }
+
+        case DrawingMode::CURVE_HERMITE:
+            // Segments (P0, T0, P1, T1) chained into one contour
+            for (size_t i = 0; i + 3 < p.size(); i += 4) {
+                BezierPoint bezier[4];
+                HermiteToBezier(HermitePoint(p[i].x, p[i].y),
+                                HermitePoint(p[i + 1].x - p[i].x, p[i + 1].y - p[i].y),
+                                HermitePoint(p[i + 2].x, p[i + 2].y),
+                                HermitePoint(p[i + 3].x - p[i + 2].x, p[i + 3].y - p[i + 2].y), bezier);
+                contour.push_back(bezier[0]);
+                FlattenBezier(bezier, 4, COVERAGE_CURVE_TOLERANCE, contour);
+            }
+            break;
+
+        default:
+            return false;
+    }
+    return contour.size() >= 3;
+}
+
+ShapeGeometry GetShapeGeometry(const ShapeView& shape) {
+    ShapeGeometry geometry;
+    if (shape.points.size() < 2) return geometry;
+    const Point& p0 = shape.points[0];
+    const Point& p1 = shape.points[1];
+    const double dx = p1.x - p0.x, dy = p1.y - p0.y;
+
+    switch (shape.mode) {
+        case DrawingMode::CIRCLE_DIRECT:
+        case DrawingMode::CIRCLE_POLAR:
+        case DrawingMode::CIRCLE_ITERATIVE_POLAR:
+        case DrawingMode::CIRCLE_MIDPOINT:
+        case DrawingMode::CIRCLE_MODIFIED_MIDPOINT:
+        case DrawingMode::SQUARE:
+            geometry.center = p0;
+            geometry.rx = geometry.ry = (int)std::sqrt(dx * dx + dy * dy);
+            break;
+
+        case DrawingMode::ELLIPSE_DIRECT:
+        case DrawingMode::ELLIPSE_POLAR:
+        case DrawingMode::ELLIPSE_MIDPOINT:
+        case DrawingMode::RECTANGLE:
+            geometry.center = p0;
+            geometry.rx = std::abs(p1.x - p0.x);
+            geometry.ry = std::abs(p1.y - p0.y);
+            break;
+
+        default:
+            break;
+    }
+    return geometry;
+}
+
+// The filled coverage already contains the boundary, so the aliased
+// outline is not drawn. Returns false for shapes without an interior.
+template <typename Sink>
+static bool RenderAntialiased(Sink& sink, const ShapeView& shape, const ShapeGeometry& g) {
+    const FillRule rule = shape.fillMode == FillMode::ANTIALIASED_NON_ZERO ? FillRule::NON_ZERO : FillRule::EVEN_ODD;
+
+    // Reused per thread so steady-state rendering does not allocate
+    thread_local std::vector<BezierPoint> polyline;
+
+    switch (shape.mode) {
+        case DrawingMode::CIRCLE_DIRECT:
+        case DrawingMode::CIRCLE_POLAR:
+        case DrawingMode::CIRCLE_ITERATIVE_POLAR:
+        case DrawingMode::CIRCLE_MIDPOINT:
+        case DrawingMode::CIRCLE_MODIFIED_MIDPOINT:
+        {
+            // Out to the edge of the outline's pixels
+            FillEllipseAA(sink, g.center.x, g.center.y, g.rx + 0.5, g.rx + 0.5, shape.color);
+            return true;
+        }
+
+        case DrawingMode::ELLIPSE_DIRECT:
+        case DrawingMode::ELLIPSE_POLAR:
+        case DrawingMode::ELLIPSE_MIDPOINT:
+            FillEllipseAA(sink, g.center.x, g.center.y, g.rx + 0.5, g.ry + 0.5, shape.color);
+            return true;
+
+        case DrawingMode::POLYGON:
+        {
+            if (shape.points.size() < 3) return false;
+            ArenaScope scope;
+            const PolygonPoint* polygon = ConvertPoints<PolygonPoint>(scope.Arena(), shape.points);
+            FillPolygonAA(sink, polygon, (int)shape.points.size(), shape.color, rule);
+            return true;
+        }
+
+        default:
+            // Curves: the region between the curve and its closing chord
+            if (!GetFillContour(shape, polyline)) return false;
+            FillPolylineAA(sink, polyline.data(), (int)polyline.size(), shape.color, rule);
+            return true;
+    }
+}
+
+// Bounding box of points in double precision, widened when converted to
+// pixels so rounding in the rasterizers (and anti-aliased edges) stays inside
+struct BoundsBuilder {
+    double minX = 1e300, minY = 1e300, maxX = -1e300, maxY = -1e300;
+
+    void Add(double x, double y) {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    void AddBox(double cx, double cy, double rx, double ry) {
+        Add(cx - rx, cy - ry);
+        Add(cx + rx, cy + ry);
+    }
+
+    PixelRect ToRect() const {
+        const double margin = 2, limit = 1e9;
+        if (minX > maxX) return { 0, 0, -1, -1 };
+        return { (int)std::max(std::floor(minX) - margin, -limit), (int)std::max(std::floor(minY) - margin, -limit),
+                 (int)std::min(std::ceil(maxX) + margin, limit), (int)std::min(std::ceil(maxY) + margin, limit) };
+    }
+};
+
+bool GetShapeBounds(const ShapeView& shape, PixelRect& bounds) {
+    BoundsBuilder box;
+    const ArrayView<Point>& p = shape.points;
+
+    if (shape.mode == DrawingMode::FLOOD_FILL) {
+        for (const FillSpan& span : shape.spans) {
+            box.Add(span.x1, span.y);
+            box.Add(span.x2, span.y);
+        }
+        bounds = box.ToRect();
+        return true;
+    }
+    if (p.size() < 2) {
+        bounds = box.ToRect();
+        return true;
+    }
+
+    switch (shape.mode) {
+        case DrawingMode::CIRCLE_DIRECT:
+        case DrawingMode::CIRCLE_POLAR:
+        case DrawingMode::CIRCLE_ITERATIVE_POLAR:
+        case DrawingMode::CIRCLE_MIDPOINT:
+        case DrawingMode::CIRCLE_MODIFIED_MIDPOINT:
+        {
+            const ShapeGeometry g = shape.geometry ? *shape.geometry : GetShapeGeometry(shape);
+            box.AddBox(g.center.x, g.center.y, g.rx, g.ry);
+            if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON ||
+                shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON ||
+                shape.fillMode == FillMode::FLOOD_FILL_PARALLEL_POLYGON) {
+                bounds = box.ToRect();
+                return false;
+            }
+            break;
+        }
+
+        case DrawingMode::ELLIPSE_DIRECT:
+        case DrawingMode::ELLIPSE_POLAR:
+        case DrawingMode::ELLIPSE_MIDPOINT:
+        case DrawingMode::SQUARE:
+        case DrawingMode::RECTANGLE:
+        {
+            const ShapeGeometry g = shape.geometry ? *shape.geometry : GetShapeGeometry(shape);
+            box.AddBox(g.center.x, g.center.y, g.rx, g.ry);
+            break;
+        }
+
+        case DrawingMode::CURVE_CARDINAL:
+        {
+            // Each segment lies in the hull of its Bezier control points
+            const int n = (int)p.size();
+            auto tangent = [&](int i, double& tx, double& ty) {
+                int prev = std::max(i - 1, 0), next = std::min(i + 1, n - 1);
+                tx = 0.25 * (p[next].x - p[prev].x);
+                ty = 0.25 * (p[next].y - p[prev].y);
+            };
+            for (int i = 0; i < n; i++) {
+                double tx, ty;
+                tangent(i, tx, ty);
+                box.Add(p[i].x, p[i].y);
+                box.Add(p[i].x + tx / 3.0, p[i].y + ty / 3.0);
+                box.Add(p[i].x - tx / 3.0, p[i].y - ty / 3.0);
+            }
+            break;
+        }
+
+        case DrawingMode::CURVE_HERMITE:
+            for (size_t i = 0; i + 3 < p.size(); i += 4) {
+                BezierPoint bezier[4];
+                HermiteToBezier(HermitePoint(p[i].x, p[i].y),
+                                HermitePoint(p[i + 1].x - p[i].x, p[i + 1].y - p[i].y),
+                                HermitePoint(p[i + 2].x, p[i + 2].y),
+                                HermitePoint(p[i + 3].x - p[i + 2].x, p[i + 3].y - p[i + 2].y), bezier);
+                for (const BezierPoint& b : bezier) box.Add(b.x, b.y);
+            }
+            break;
+
+        default:
+            // Lines, polygons and Bezier curves stay within their points
+            for (const Point& point : p) box.Add(point.x, point.y);
+            break;
+    }
+    bounds = box.ToRect();
+    return true;
+}
+
+// ========================================
+// DISPATCH
+// ========================================
+//
+// One drawer per drawing mode, looked up by mode in a table built once per
+// sink type. Circles, ellipses, squares and rectangles draw from the
+// precomputed geometry and never touch the points.
+
+template <typename Sink>
+using ShapeDrawer = void (*)(Sink&, const ShapeView&, const ShapeGeometry&);
+
+template <typename Sink>
+using LineAlgorithm = void (*)(Sink&, int, int, int, int, COLORREF);
+
+template <typename Sink>
+using CircleAlgorithm = void (*)(Sink&, int, int, int, COLORREF);
+
+template <typename Sink>
+using EllipseAlgorithm = void (*)(Sink&, int, int, int, int, COLORREF);
+
+template <typename Sink, LineAlgorithm<Sink> Draw>
+static void DrawLineShape(Sink& sink, const ShapeView& shape, const ShapeGeometry&) {
+    Draw(sink, shape.points[0].x, shape.points[0].y, shape.points[1].x, shape.points[1].y, shape.color);
+}
+
+template <typename Sink, CircleAlgorithm<Sink> Draw>
+static void DrawCircleShape(Sink& sink, const ShapeView& shape, const ShapeGeometry& g) {
+    Draw(sink, g.center.x, g.center.y, g.rx, shape.color);
+
+    // Apply fill mode if set
+    if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
+        FillCircleWithLines(sink, g.center.x, g.center.y, g.rx, shape.color);
+    } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
+        FillQuarterCircle(sink, g.center.x, g.center.y, g.rx, shape.color);
+    } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
+        FillCircleWithCircles(sink, g.center.x, g.center.y, g.rx, shape.color);
+    } else {
+        ApplyFloodFill(sink, shape);
+    }
+}
+
+template <typename Sink, EllipseAlgorithm<Sink> Draw>
+static void DrawEllipseShape(Sink& sink, const ShapeView& shape, const ShapeGeometry& g) {
+    Draw(sink, g.center.x, g.center.y, g.rx, g.ry, shape.color);
+}
+
+template <typename Sink>
+static void DrawSquareShape(Sink& sink, const ShapeView& shape, const ShapeGeometry& g) {
+    DrawSquare(sink, g.center.x, g.center.y, g.rx, shape.color);
+    if (shape.fillMode == FillMode::SQUARE_FILL_HERMITE_VERTICAL) {
+        FillSquareWithVerticalHermite(sink, g.center.x, g.center.y, g.rx, shape.color);
+    }
+}
+
+template <typename Sink>
+static void DrawRectangleShape(Sink& sink, const ShapeView& shape, const ShapeGeometry& g) {
+    // Both take the center and a corner
+    DrawRectangle(sink, g.center.x, g.center.y, g.center.x + g.rx, g.center.y + g.ry, shape.color);
+    if (shape.fillMode == FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL) {
+        FillRectangleWithHorizontalBezier(sink, g.center.x, g.center.y, g.center.x + g.rx, g.center.y + g.ry,
+                                          shape.color);
+    }
+}
+
+template <typename Sink>
+static void DrawPolygonShape(Sink& sink, const ShapeView& shape, const ShapeGeometry&) {
+    if (shape.points.size() < 3) return;
+    DrawPolygon(sink, shape.points.data(), (int)shape.points.size(), shape.color);
+
+    if (shape.fillMode != FillMode::POLYGON_CONVEX_FILL && shape.fillMode != FillMode::POLYGON_NONCONVEX_FILL) {
+        return;
+    }
+    ArenaScope scope;
+    PolygonPoint* polygon = ConvertPoints<PolygonPoint>(scope.Arena(), shape.points);
+
+    // Either menu choice gets the cheapest filler that is correct for this
+    // polygon
+    FillPolygon(sink, polygon, (int)shape.points.size(), shape.color);
+}
+
+template <typename Sink>
+static void DrawCardinalShape(Sink& sink, const ShapeView& shape, const ShapeGeometry&) {
+    ArenaScope scope;
+    const HermitePoint* knots = ConvertPoints<HermitePoint>(scope.Arena(), shape.points);
+
+    // Default tension (0.5)
+    DrawCardinalSplineAdaptive(sink, knots, (int)shape.points.size(), 0.5, shape.color);
+}
+
+template <typename Sink>
+static void DrawBezierShape(Sink& sink, const ShapeView& shape, const ShapeGeometry&) {
+    ArenaScope scope;
+    const BezierPoint* control = ConvertPoints<BezierPoint>(scope.Arena(), shape.points);
+    DrawBezierCurveAdaptive(sink, control, (int)shape.points.size(), shape.color);
+}
+
+template <typename Sink>
+static void DrawHermiteShape(Sink& sink, const ShapeView& shape, const ShapeGeometry&) {
+    // Curves for complete point quadruples: (P0, T0, P1, T1)
+    const ArrayView<Point>& p = shape.points;
+    for (size_t i = 0; i + 3 < p.size(); i += 4) {
+        DrawHermiteCurveAdaptive(sink, HermitePoint(p[i].x, p[i].y),
+                                 HermitePoint(p[i + 1].x - p[i].x, p[i + 1].y - p[i].y),
+                                 HermitePoint(p[i + 2].x, p[i + 2].y),
+                                 HermitePoint(p[i + 3].x - p[i + 2].x, p[i + 3].y - p[i + 2].y), shape.color);
+    }
+}
+
+// Drawer for 'mode', or nullptr for modes without one
+template <typename Sink>
+static ShapeDrawer<Sink> FindDrawer(DrawingMode mode) {
+    // In DrawingMode order
+    static const ShapeDrawer<Sink> drawers[] = {
+        DrawLineShape<Sink, DrawLineDDA<Sink>>,
+        DrawLineShape<Sink, DrawLineBresenham<Sink>>,
+        DrawLineShape<Sink, DrawLineParametric<Sink>>,
+        DrawCircleShape<Sink, DrawDirectCircle<Sink>>,
+        DrawCircleShape<Sink, DrawPolarCircle<Sink>>,
+        DrawCircleShape<Sink, DrawIterativePolarCircle<Sink>>,
+        DrawCircleShape<Sink, DrawCircleBresenham<Sink>>,
+        DrawCircleShape<Sink, DrawCircleDDA1<Sink>>,
+        DrawEllipseShape<Sink, DrawDirectEllipse<Sink>>,
+        DrawEllipseShape<Sink, DrawPolarEllipse<Sink>>,
+        DrawEllipseShape<Sink, DrawEllipseBresenham<Sink>>,
+        DrawPolygonShape<Sink>,
+        DrawSquareShape<Sink>,
+        DrawRectangleShape<Sink>,
+        DrawCardinalShape<Sink>,
+        DrawBezierShape<Sink>,
+        DrawHermiteShape<Sink>,
+    };
+    static_assert(sizeof(drawers) / sizeof(drawers[0]) == (size_t)DrawingMode::NONE,
+                  "one drawer per drawing mode before NONE");
+    return (size_t)mode < (size_t)DrawingMode::NONE ? drawers[(size_t)mode] : nullptr;
+}
+
+// Draw a stored shape using its respective algorithm
+template <typename Sink>
+void RenderShape(Sink& sink, const ShapeView& shape) {
+    // Recorded flood fills replay their spans; nothing is read back
+    if (shape.mode == DrawingMode::FLOOD_FILL) {
+        for (const FillSpan& span : shape.spans) {
+            sink.Span(span.x1, span.x2, span.y, shape.color);
+        }
+        return;
+    }
+
+    if (shape.points.size() < 2) return;
+    const ShapeGeometry geometry = shape.geometry ? *shape.geometry : GetShapeGeometry(shape);
+    if (IsAntialiasedFill(shape.fillMode) && RenderAntialiased(sink, shape, geometry)) return;
+
+    ShapeDrawer<Sink> draw = FindDrawer<Sink>(shape.mode);
+    if (draw) draw(sink, shape, geometry);
+}
+
+#define INSTANTIATE_FOR_SINK(Sink) \
+    template void RenderShape<Sink>(Sink&, const ShapeView&);
+FOR_EACH_PIXEL_SINK(INSTANTIATE_FOR_SINK)
+#undef INSTANTIATE_FOR_SINK
+
+#ifdef GFX_WITH_GDI
+void RenderShape(HDC hdc, const ShapeView& shape) {
+    GdiSink sink(hdc);
+    RenderShape(sink, shape);
+}
+#endif
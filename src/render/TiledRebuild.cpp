@@ -0,0 +1,243 @@
+#include "../../include/TiledRebuild.h"
+#include "../../include/FrameArena.h"
+#include "../../include/ShapeRenderer.h"
+#include <algorithm>
+#include <atomic>
+
+TiledRebuilder::TiledRebuilder(int threads, int tileSize)
+    : m_threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency()))
+    , m_tileSize(std::max(tileSize, 16)) {
+    for (int i = 1; i < m_threads; i++) {
+        m_workers.emplace_back(&TiledRebuilder::WorkerLoop, this, i);
+    }
+}
+
+TiledRebuilder::~TiledRebuilder() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) worker.join();
+}
+
+void TiledRebuilder::RunOnAll(const std::function<void(int)>& job) {
+    if (m_workers.empty()) {
+        job(0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_pending = (int)m_workers.size();
+        m_generation++;
+    }
+    m_wake.notify_all();
+    job(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [&]() { return m_pending == 0; });
+    m_job = nullptr;
+}
+
+void TiledRebuilder::WorkerLoop(int index) {
+    FrameArena& arena = ThreadArena();
+    std::uint64_t seen = 0, arenaRender = 0;
+    for (;;) {
+        const std::function<void(int)>* job;
+        bool newRender;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&]() { return m_stopping || m_generation != seen; });
+            if (m_stopping) return;
+            seen = m_generation;
+            job = m_job;
+            newRender = arenaRender != m_render;
+            arenaRender = m_render;
+        }
+        if (newRender) arena.Reset();
+        (*job)(index);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.arenaPeak = std::max(m_stats.arenaPeak, arena.Stats().peak);
+            if (--m_pending == 0) m_done.notify_one();
+        }
+    }
+}
+
+// Whether shape i lies entirely off a width x height canvas
+static bool OffCanvas(const Scene& scene, std::size_t i, int width, int height) {
+    const PixelRect& r = scene.Bounds(i);
+    return scene.IsBounded(i) && (r.IsEmpty() || r.right < 0 || r.bottom < 0 || r.left >= width || r.top >= height);
+}
+
+// Look every drawn shape up in the cache and record the missing lists in
+// parallel; the cache itself is only touched from this thread
+void TiledRebuilder::PrepareDisplayLists(const Framebuffer& framebuffer, const Scene& scene, DisplayListCache& cache) {
+    const std::size_t count = scene.Size();
+    const int width = framebuffer.Width(), height = framebuffer.Height();
+    cache.BeginFrame(count, width, height);
+    m_lists.assign(count, nullptr);
+    m_toRecord.clear();
+    for (std::size_t i = 0; i < count; i++) {
+        if (OffCanvas(scene, i, width, height)) continue;
+        bool record;
+        m_lists[i] = cache.Find(i, scene.View(i), record);
+        if (record) m_toRecord.push_back((std::uint32_t)i);
+    }
+
+    m_recorded.clear();
+    m_recorded.resize(m_toRecord.size());
+    m_recordedOk.assign(m_toRecord.size(), 0);
+    const PixelRect canvas = cache.Canvas();
+    std::atomic<std::size_t> next(0);
+    auto record = [&](int) {
+        for (std::size_t k = next.fetch_add(1); k < m_toRecord.size(); k = next.fetch_add(1)) {
+            m_recordedOk[k] = RecordDisplayList(scene.View(m_toRecord[k]), canvas, m_recorded[k]);
+        }
+    };
+    RunOnAll(std::ref(record));
+
+    for (std::size_t k = 0; k < m_toRecord.size(); k++) {
+        std::uint32_t i = m_toRecord[k];
+        if (!m_recordedOk[k]) {
+            cache.Reject(i);
+            continue;
+        }
+        m_lists[i] = cache.Store(i, m_recorded[k]);
+        if (!m_lists[i]) m_lists[i] = &m_recorded[k];
+    }
+    m_stats.recorded = m_toRecord.size();
+}
+
+void TiledRebuilder::DrawShape(BgraSink& sink, const Scene& scene, std::size_t i) const {
+    if (!m_lists.empty() && m_lists[i]) {
+        m_lists[i]->Replay(sink);
+    } else {
+        RenderShape(sink, scene.View(i));
+    }
+}
+
+// Bin shapes [begin, end), all with bounds, and render the tiles in parallel
+void TiledRebuilder::RenderBatch(Framebuffer& framebuffer, const Scene& scene, std::size_t begin, std::size_t end) {
+    const int width = framebuffer.Width(), height = framebuffer.Height();
+    const int tilesX = (width + m_tileSize - 1) / m_tileSize;
+    const int tilesY = (height + m_tileSize - 1) / m_tileSize;
+    const int tileCount = tilesX * tilesY;
+
+    // Tile range of shape i, or false if it misses the framebuffer
+    auto tileRange = [&](std::size_t i, int& tx1, int& ty1, int& tx2, int& ty2) {
+        const PixelRect& r = scene.Bounds(i);
+        if (r.IsEmpty() || r.right < 0 || r.bottom < 0 || r.left >= width || r.top >= height) return false;
+        tx1 = std::max(r.left, 0) / m_tileSize;
+        ty1 = std::max(r.top, 0) / m_tileSize;
+        tx2 = std::min(r.right, width - 1) / m_tileSize;
+        ty2 = std::min(r.bottom, height - 1) / m_tileSize;
+        return true;
+    };
+
+    // Count, prefix sum, then fill in shape order so each tile's list keeps
+    // the drawing order
+    m_tileStart.assign(tileCount + 1, 0);
+    for (std::size_t i = begin; i < end; i++) {
+        int tx1, ty1, tx2, ty2;
+        if (!tileRange(i, tx1, ty1, tx2, ty2)) {
+            m_stats.culled++;
+            continue;
+        }
+        for (int ty = ty1; ty <= ty2; ty++) {
+            for (int tx = tx1; tx <= tx2; tx++) m_tileStart[ty * tilesX + tx + 1]++;
+        }
+    }
+    for (int t = 0; t < tileCount; t++) m_tileStart[t + 1] += m_tileStart[t];
+    m_tileShapes.resize(m_tileStart[tileCount]);
+    m_tileCursor.assign(m_tileStart.begin(), m_tileStart.end() - 1);
+    for (std::size_t i = begin; i < end; i++) {
+        int tx1, ty1, tx2, ty2;
+        if (!tileRange(i, tx1, ty1, tx2, ty2)) continue;
+        for (int ty = ty1; ty <= ty2; ty++) {
+            for (int tx = tx1; tx <= tx2; tx++) m_tileShapes[m_tileCursor[ty * tilesX + tx]++] = (std::uint32_t)i;
+        }
+    }
+    m_stats.binned += m_tileShapes.size();
+    m_stats.batches++;
+
+    // Tiles are claimed one at a time, so a crowded tile doesn't hold up
+    // the threads that finish theirs
+    std::atomic<int> nextTile(0);
+    auto renderTiles = [&](int) {
+        for (int t = nextTile.fetch_add(1); t < tileCount; t = nextTile.fetch_add(1)) {
+            if (m_tileStart[t] == m_tileStart[t + 1]) continue;
+            int left = (t % tilesX) * m_tileSize, top = (t / tilesX) * m_tileSize;
+            PixelRect tile = { left, top, std::min(left + m_tileSize, width) - 1, std::min(top + m_tileSize, height) - 1 };
+            BgraSink sink(framebuffer, tile, DirtyTracking::OFF);
+            for (std::uint32_t k = m_tileStart[t]; k < m_tileStart[t + 1]; k++) {
+                DrawShape(sink, scene, m_tileShapes[k]);
+            }
+        }
+    };
+    RunOnAll(std::ref(renderTiles));
+}
+
+void TiledRebuilder::Render(Framebuffer& framebuffer, const Scene& scene, DisplayListCache* displayLists) {
+    m_stats = TiledRebuildStats();
+    m_stats.shapes = scene.Size();
+    m_lists.clear();
+    if (!framebuffer.IsValid()) return;
+
+    // Workers reset theirs when they pick up their first job
+    const std::uint64_t arenaAllocations = FrameArena::TotalHeapAllocations();
+    FrameArena& arena = ThreadArena();
+    arena.Reset();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_render++;
+    }
+    RenderShapes(framebuffer, scene, displayLists);
+    m_stats.arenaPeak = std::max(m_stats.arenaPeak, arena.Stats().peak);
+    m_stats.arenaAllocations = FrameArena::TotalHeapAllocations() - arenaAllocations;
+}
+
+void TiledRebuilder::RenderShapes(Framebuffer& framebuffer, const Scene& scene, DisplayListCache* displayLists) {
+    const int width = framebuffer.Width(), height = framebuffer.Height();
+    m_stats.tiles = ((width + m_tileSize - 1) / m_tileSize) * ((height + m_tileSize - 1) / m_tileSize);
+
+    BgraSink full(framebuffer, DirtyTracking::OFF);
+    if (m_threads == 1) {
+        std::uint64_t misses = 0;
+        if (displayLists) {
+            displayLists->BeginFrame(scene.Size(), width, height);
+            misses = displayLists->Stats().misses;
+        }
+        for (std::size_t i = 0; i < scene.Size(); i++) {
+            if (OffCanvas(scene, i, width, height)) {
+                m_stats.culled++;
+                continue;
+            }
+            if (displayLists) {
+                displayLists->Render(full, scene.View(i), i);
+            } else {
+                RenderShape(full, scene.View(i));
+            }
+            m_stats.serialShapes++;
+        }
+        if (displayLists) m_stats.recorded = displayLists->Stats().misses - misses;
+        return;
+    }
+
+    if (displayLists) PrepareDisplayLists(framebuffer, scene, *displayLists);
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i <= scene.Size(); i++) {
+        if (i < scene.Size() && scene.IsBounded(i)) continue;
+        if (i > begin) RenderBatch(framebuffer, scene, begin, i);
+        if (i < scene.Size()) {
+            DrawShape(full, scene, i);
+            m_stats.serialShapes++;
+        }
+        begin = i + 1;
+    }
+
+    // Recordings the cache turned away were only for this render
+    m_recorded.clear();
+    m_lists.clear();
+}
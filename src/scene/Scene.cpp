@@ -0,0 +1,153 @@
+#include "../../include/Scene.h"
+#include "../../include/ShapeRenderer.h"
+
+ShapeView Scene::View(std::size_t i) const {
+    ShapeView shape;
+    shape.mode = (DrawingMode)m_modes[i];
+    shape.color = m_colors[i];
+    shape.fillMode = (FillMode)m_fillModes[i];
+    shape.thickness = m_thickness[i];
+    shape.points = ArrayView<Point>(m_points.data() + m_pointStart[i], m_pointStart[i + 1] - m_pointStart[i]);
+    shape.spans = ArrayView<FillSpan>(m_spans.data() + m_spanStart[i], m_spanStart[i + 1] - m_spanStart[i]);
+    shape.geometry = &m_geometry[i];
+    return shape;
+}
+
+void Scene::Clear() {
+    m_modes.clear();
+    m_fillModes.clear();
+    m_bounded.clear();
+    m_colors.clear();
+    m_thickness.clear();
+    m_bounds.clear();
+    m_geometry.clear();
+    m_pointStart.assign(1, 0);
+    m_spanStart.assign(1, 0);
+    m_points.clear();
+    m_spans.clear();
+    m_backing.reset();
+}
+
+void Scene::Reserve(std::size_t shapes, std::size_t points, std::size_t spans) {
+    shapes += Size();
+    m_modes.reserve(shapes);
+    m_fillModes.reserve(shapes);
+    m_bounded.reserve(shapes);
+    m_colors.reserve(shapes);
+    m_thickness.reserve(shapes);
+    m_bounds.reserve(shapes);
+    m_geometry.reserve(shapes);
+    m_pointStart.reserve(shapes + 1);
+    m_spanStart.reserve(shapes + 1);
+    m_points.reserve(m_points.size() + points);
+    m_spans.reserve(m_spans.size() + spans);
+}
+
+std::size_t Scene::Add(const ShapeView& shape) {
+    const std::size_t i = Size();
+    m_modes.push_back((std::uint8_t)shape.mode);
+    m_fillModes.push_back((std::uint8_t)shape.fillMode);
+    m_colors.push_back(shape.color);
+    m_thickness.push_back(shape.thickness);
+
+    m_points.append(shape.points.begin(), shape.points.end());
+    m_pointStart.push_back((std::uint32_t)m_points.size());
+    m_spans.append(shape.spans.begin(), shape.spans.end());
+    m_spanStart.push_back((std::uint32_t)m_spans.size());
+
+    m_geometry.push_back(GetShapeGeometry(shape));
+    PixelRect bounds;
+    m_bounded.push_back(GetShapeBounds(View(i), bounds));
+    m_bounds.push_back(bounds);
+    return i;
+}
+
+// Append shapes [first, last) of 'other' to one of its arenas, moving their
+// start offsets to where the entries land in 'arena'
+template <typename T>
+static void AppendRuns(SceneColumn<std::uint32_t>& starts, SceneColumn<T>& arena,
+                       const SceneColumn<std::uint32_t>& otherStarts, const SceneColumn<T>& otherArena,
+                       std::size_t first, std::size_t last) {
+    const std::uint32_t from = otherStarts[first];
+    const std::uint32_t base = (std::uint32_t)arena.size();
+    arena.append(otherArena.begin() + from, otherArena.begin() + otherStarts[last]);
+    for (std::size_t i = first; i < last; i++) starts.push_back(base + (otherStarts[i + 1] - from));
+}
+
+void Scene::Append(const Scene& other, std::size_t first, std::size_t last) {
+    m_modes.append(other.m_modes.begin() + first, other.m_modes.begin() + last);
+    m_fillModes.append(other.m_fillModes.begin() + first, other.m_fillModes.begin() + last);
+    m_bounded.append(other.m_bounded.begin() + first, other.m_bounded.begin() + last);
+    m_colors.append(other.m_colors.begin() + first, other.m_colors.begin() + last);
+    m_thickness.append(other.m_thickness.begin() + first, other.m_thickness.begin() + last);
+    m_bounds.append(other.m_bounds.begin() + first, other.m_bounds.begin() + last);
+    m_geometry.append(other.m_geometry.begin() + first, other.m_geometry.begin() + last);
+    AppendRuns(m_pointStart, m_points, other.m_pointStart, other.m_points, first, last);
+    AppendRuns(m_spanStart, m_spans, other.m_spanStart, other.m_spans, first, last);
+}
+
+void Scene::SetFill(std::size_t i, FillMode fillMode, COLORREF color) {
+    m_fillModes.Mutable(i) = (std::uint8_t)fillMode;
+    m_colors.Mutable(i) = color;
+    PixelRect bounds;
+    m_bounded.Mutable(i) = GetShapeBounds(View(i), bounds);
+    m_bounds.Mutable(i) = bounds;
+}
+
+std::size_t Scene::MemoryBytes() const {
+    return m_modes.capacity() + m_fillModes.capacity() + m_bounded.capacity() +
+           m_colors.capacity() * sizeof(COLORREF) + m_thickness.capacity() * sizeof(std::int32_t) +
+           m_bounds.capacity() * sizeof(PixelRect) + m_geometry.capacity() * sizeof(ShapeGeometry) +
+           (m_pointStart.capacity() + m_spanStart.capacity()) * sizeof(std::uint32_t) +
+           m_points.capacity() * sizeof(Point) + m_spans.capacity() * sizeof(FillSpan);
+}
+
+SceneColumns Scene::Columns() const {
+    SceneColumns columns;
+    columns.shapeCount = Size();
+    columns.pointCount = m_points.size();
+    columns.spanCount = m_spans.size();
+    columns.modes = m_modes.data();
+    columns.fillModes = m_fillModes.data();
+    columns.bounded = m_bounded.data();
+    columns.colors = m_colors.data();
+    columns.thickness = m_thickness.data();
+    columns.bounds = m_bounds.data();
+    columns.geometry = m_geometry.data();
+    columns.pointStart = m_pointStart.data();
+    columns.spanStart = m_spanStart.data();
+    columns.points = m_points.data();
+    columns.spans = m_spans.data();
+    return columns;
+}
+
+void Scene::Adopt(const SceneColumns& columns, std::shared_ptr<const void> backing) {
+    const std::size_t n = columns.shapeCount;
+    m_modes.Borrow(columns.modes, n);
+    m_fillModes.Borrow(columns.fillModes, n);
+    m_bounded.Borrow(columns.bounded, n);
+    m_colors.Borrow(columns.colors, n);
+    m_thickness.Borrow(columns.thickness, n);
+    m_bounds.Borrow(columns.bounds, n);
+    m_geometry.Borrow(columns.geometry, n);
+    m_pointStart.Borrow(columns.pointStart, n + 1);
+    m_spanStart.Borrow(columns.spanStart, n + 1);
+    m_points.Borrow(columns.points, columns.pointCount);
+    m_spans.Borrow(columns.spans, columns.spanCount);
+    m_backing = std::move(backing);
+}
+
+void Scene::Detach() {
+    m_modes.Own();
+    m_fillModes.Own();
+    m_bounded.Own();
+    m_colors.Own();
+    m_thickness.Own();
+    m_bounds.Own();
+    m_geometry.Own();
+    m_pointStart.Own();
+    m_spanStart.Own();
+    m_points.Own();
+    m_spans.Own();
+    m_backing.reset();
+}
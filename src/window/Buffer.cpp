@@ -1,4 +1,6 @@
 #include "../../include/Window.h"
+#include <algorithm>
+#include <cstdio>
 
 // Create offscreen buffer for double buffering
 void GraphicsWindow::CreateOffscreenBuffer(int width, int height) {
@@ -7,10 +9,13 @@ void GraphicsWindow::CreateOffscreenBuffer(int width, int height) {
     m_canvasWidth = width;
     m_canvasHeight = height;
     
+    if (!m_framebuffer.Create(width, height)) {
+        return;
+    }
+    
     HDC hdc = GetDC(m_hwnd);
     m_offscreenDC = CreateCompatibleDC(hdc);
-    m_offscreenBitmap = CreateCompatibleBitmap(hdc, width, height);
-    m_oldBitmap = (HBITMAP)SelectObject(m_offscreenDC, m_offscreenBitmap);
+    m_oldBitmap = (HBITMAP)SelectObject(m_offscreenDC, (HBITMAP)m_framebuffer.NativeBitmap());
     ReleaseDC(m_hwnd, hdc);
     
     ClearOffscreenBuffer();
@@ -26,16 +31,66 @@ void GraphicsWindow::CleanupOffscreenBuffer() {
         DeleteDC(m_offscreenDC);
         m_offscreenDC = nullptr;
     }
-    if (m_offscreenBitmap) {
-        DeleteObject(m_offscreenBitmap);
-        m_offscreenBitmap = nullptr;
-    }
+    m_framebuffer.Release();
 }
 
 // Clear offscreen buffer with background color
 void GraphicsWindow::ClearOffscreenBuffer() {
-    if (m_offscreenDC) {
-        RECT rect = {0, 0, m_canvasWidth, m_canvasHeight};
-        FillRect(m_offscreenDC, &rect, m_backgroundBrush);
+    m_framebuffer.Clear(m_backgroundColor);
+}
+
+// Height of the instruction and status lines WM_PAINT draws over the canvas
+static const int STATUS_TEXT_HEIGHT = 90;
+
+// Invalidate the tiles drawn into since the last call. Adjacent dirty tiles
+// arrive coalesced into rectangles; the canvas covers the whole client
+// area, so nothing needs erasing first.
+void GraphicsWindow::PresentDirtyTiles() {
+    m_framebuffer.TakeDirtyRects(m_dirtyRects);
+    for (const Framebuffer::DirtyRect& dirty : m_dirtyRects) {
+        RECT rect = { dirty.x, dirty.y, dirty.x + dirty.width, dirty.y + dirty.height };
+        InvalidateRect(m_hwnd, &rect, FALSE);
+    }
+}
+
+// Mode and color changes only change the text over the canvas
+void GraphicsWindow::InvalidateStatusText() {
+    RECT rect = { 0, 0, m_canvasWidth, STATUS_TEXT_HEIGHT };
+    InvalidateRect(m_hwnd, &rect, FALSE);
+}
+
+// Copy the parts of the offscreen buffer in 'region' to the window, one
+// BitBlt per rectangle of the region rather than its bounding box
+void GraphicsWindow::BlitUpdateRegion(HDC hdc, HRGN region) {
+    m_lastPaintRects = 0;
+    m_lastPaintBytes = 0;
+    if (!m_offscreenDC) return;
+
+    DWORD size = GetRegionData(region, 0, NULL);
+    if (size == 0) return;
+    m_regionData.resize(size);
+    RGNDATA* data = (RGNDATA*)m_regionData.data();
+    if (GetRegionData(region, size, data) == 0) return;
+
+    const RECT* rects = (const RECT*)data->Buffer;
+    for (DWORD i = 0; i < data->rdh.nCount; i++) {
+        RECT rect = rects[i];
+        rect.right = std::min((int)rect.right, m_canvasWidth);
+        rect.bottom = std::min((int)rect.bottom, m_canvasHeight);
+        if (rect.left >= rect.right || rect.top >= rect.bottom) continue;
+
+        int width = rect.right - rect.left;
+        int height = rect.bottom - rect.top;
+        BitBlt(hdc, rect.left, rect.top, width, height, m_offscreenDC, rect.left, rect.top, SRCCOPY);
+        m_lastPaintRects++;
+        m_lastPaintBytes += (std::size_t)width * height * sizeof(std::uint32_t);
     }
+
+#ifdef GFX_PAINT_STATS
+    char message[96];
+    snprintf(message, sizeof(message), "WM_PAINT: %d rects, %zu bytes blitted (full canvas %zu)\n",
+             m_lastPaintRects, m_lastPaintBytes,
+             (std::size_t)m_canvasWidth * m_canvasHeight * sizeof(std::uint32_t));
+    OutputDebugStringA(message);
+#endif
 }
@@ -1,247 +1,14 @@
 #include "../../include/Window.h"
+#include <cstdio>
 
 // Redraw all shapes using implemented algorithms
 void GraphicsWindow::RedrawAll() {
     HDC hdc = GetDC(m_hwnd);
 
-    // Draw all saved shapes using their respective algorithms
-    for (const auto& shape : m_shapes) {
-        if (shape.points.size() >= 2) {
-            switch (shape.mode) {
-                case DrawingMode::LINE_DDA:
-                    DrawLineDDA(hdc, shape.points[0].x, shape.points[0].y,
-                               shape.points[1].x, shape.points[1].y, shape.color);
-                    break;
-                    
-                case DrawingMode::LINE_BRESENHAM:
-                    DrawLineBresenham(hdc, shape.points[0].x, shape.points[0].y,
-                                     shape.points[1].x, shape.points[1].y, shape.color);
-                    break;
-                    
-                case DrawingMode::LINE_PARAMETRIC:
-                    DrawLineParametric(hdc, shape.points[0].x, shape.points[0].y,
-                                      shape.points[1].x, shape.points[1].y, shape.color);
-                    break;
-                    
-                case DrawingMode::CIRCLE_DIRECT:
-                {
-                    int radius = (int)sqrt(
-                        pow(shape.points[1].x - shape.points[0].x, 2) +
-                        pow(shape.points[1].y - shape.points[0].y, 2)
-                    );
-                    DrawDirectCircle(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    
-                    // Apply fill mode if set
-                    if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                        FillCircleWithLines(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                        FillQuarterCircle(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                        FillCircleWithCircles(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillNonRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    }
-                }
-                    break;
-                    
-                case DrawingMode::CIRCLE_POLAR:
-                {
-                    int radius = (int)sqrt(
-                        pow(shape.points[1].x - shape.points[0].x, 2) +
-                        pow(shape.points[1].y - shape.points[0].y, 2)
-                    );
-                    DrawPolarCircle(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    
-                    // Apply fill mode if set
-                    if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                        FillCircleWithLines(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                        FillQuarterCircle(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                        FillCircleWithCircles(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillNonRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    }
-                }
-                    break;
-                    
-                case DrawingMode::CIRCLE_ITERATIVE_POLAR:
-                {
-                    int radius = (int)sqrt(
-                        pow(shape.points[1].x - shape.points[0].x, 2) +
-                        pow(shape.points[1].y - shape.points[0].y, 2)
-                    );
-                    DrawIterativePolarCircle(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    
-                    // Apply fill mode if set
-                    if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                        FillCircleWithLines(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                        FillQuarterCircle(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                        FillCircleWithCircles(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillNonRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    }
-                }
-                    break;
-                    
-                case DrawingMode::CIRCLE_MIDPOINT:
-                {
-                    int radius = (int)sqrt(
-                        pow(shape.points[1].x - shape.points[0].x, 2) +
-                        pow(shape.points[1].y - shape.points[0].y, 2)
-                    );
-                    std::cout << radius << '\n';
-                    DrawCircleBresenham(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    
-                    // Apply fill mode if set
-                    if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                        FillCircleWithLines(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                        FillQuarterCircle(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                        FillCircleWithCircles(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillNonRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    }
-                }
-                    break;
-                    
-                case DrawingMode::CIRCLE_MODIFIED_MIDPOINT:
-                {
-                    int radius = (int)sqrt(
-                        pow(shape.points[1].x - shape.points[0].x, 2) +
-                        pow(shape.points[1].y - shape.points[0].y, 2)
-                    );
-                    DrawCircleDDA1(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    
-                    // Apply fill mode if set
-                    if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                        FillCircleWithLines(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                        FillQuarterCircle(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                        FillCircleWithCircles(hdc, shape.points[0].x, shape.points[0].y, radius, shape.color);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                        COLORREF bgColor = GetPixel(hdc, shape.points[0].x, shape.points[0].y);
-                        FloodFillNonRecursive(hdc, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-                    }
-                }
-                    break;
-                    
-                case DrawingMode::ELLIPSE_DIRECT:
-                {
-                    int radiusX = abs(shape.points[1].x - shape.points[0].x);
-                    int radiusY = abs(shape.points[1].y - shape.points[0].y);
-                    DrawDirectEllipse(hdc, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
-                }
-                    break;
-                    
-                case DrawingMode::ELLIPSE_POLAR:
-                {
-                    int radiusX = abs(shape.points[1].x - shape.points[0].x);
-                    int radiusY = abs(shape.points[1].y - shape.points[0].y);
-                    DrawPolarEllipse(hdc, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
-                }
-                    break;
-                    
-                case DrawingMode::ELLIPSE_MIDPOINT:
-                {
-                    int radiusX = abs(shape.points[1].x - shape.points[0].x);
-                    int radiusY = abs(shape.points[1].y - shape.points[0].y);
-                    DrawEllipseBresenham(hdc, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
-                }
-                    break;
-
-                case DrawingMode::SQUARE:
-                {
-                    if (shape.points.size() >= 2) {
-                        // Calculate half-size (distance from center to edge)
-                        int centerX = shape.points[0].x;
-                        int centerY = shape.points[0].y;
-                        int halfSize = (int)sqrt(
-                            pow(shape.points[1].x - centerX, 2) +
-                            pow(shape.points[1].y - centerY, 2)
-                        );
-                        
-                        // Draw square using our DrawSquare function
-                        DrawSquare(hdc, centerX, centerY, halfSize, shape.color);
-                          // Apply Hermite fill if set
-                        if (shape.fillMode == FillMode::SQUARE_FILL_HERMITE_VERTICAL) {
-                            FillSquareWithVerticalHermite(hdc, centerX, centerY, halfSize, shape.color);
-                        }
-                    }
-                }
-                    break;
-                
-                case DrawingMode::RECTANGLE:
-                {
-                    if (shape.points.size() >= 2) {
-                        // Draw rectangle using our DrawRectangle function
-                        DrawRectangle(hdc, shape.points[0].x, shape.points[0].y,
-                                    shape.points[1].x, shape.points[1].y, shape.color);
-                    }
-                }
-                    break;
-                
-                case DrawingMode::POLYGON:
-                {
-                    if (shape.points.size() >= 3) {
-                        // Draw polygon outline
-                        for (size_t i = 0; i < shape.points.size() - 1; i++) {
-                            DrawLineBresenham(hdc, shape.points[i].x, shape.points[i].y,
-                                             shape.points[i + 1].x, shape.points[i + 1].y, shape.color);
-                        }
-                        // Close the polygon
-                        DrawLineBresenham(hdc, shape.points.back().x, shape.points.back().y,
-                                         shape.points[0].x, shape.points[0].y, shape.color);
-                        
-                        // Apply polygon fill if set
-                        if (shape.fillMode == FillMode::POLYGON_CONVEX_FILL || 
-                            shape.fillMode == FillMode::POLYGON_NONCONVEX_FILL) {
-                            
-                            PolygonPoint* pointsArray = new PolygonPoint[shape.points.size()];
-                            for (size_t i = 0; i < shape.points.size(); i++) {
-                                pointsArray[i] = PolygonPoint(shape.points[i].x, shape.points[i].y);
-                            }
-                            
-                            if (shape.fillMode == FillMode::POLYGON_CONVEX_FILL) {
-                                ConvexFill(hdc, pointsArray, shape.points.size(), shape.color);
-                            } else {
-                                NonConvexFill(hdc, pointsArray, shape.points.size(), shape.color);
-                            }
-                            
-                            delete[] pointsArray;
-                        }
-                    }
-                }
-                    break;
-                
-                default:
-                    // TODO: Implement other shape algorithms
-                    break;
-            }
-        }
+    // Draw all saved shapes using their respective algorithms, the same
+    // dispatch the offscreen buffer uses
+    for (std::size_t i = 0; i < m_scene.Size(); i++) {
+        RenderShape(hdc, m_scene.View(i));
     }
 
     // Draw current shape being created (basic preview for now)
@@ -404,8 +171,8 @@ void GraphicsWindow::RedrawAll() {
                         hermitePoints[i] = HermitePoint(m_currentPoints[i].x, m_currentPoints[i].y);
                     }
                     
-                    // Draw Cardinal Spline preview with default tension (0.5) and 50 points per segment
-                    DrawCardinalSpline(hdc, hermitePoints, m_currentPoints.size(), 0.5, 50, m_currentColor);
+                    // Draw Cardinal Spline preview with default tension (0.5)
+                    DrawCardinalSplineAdaptive(hdc, hermitePoints, m_currentPoints.size(), 0.5, m_currentColor);
                     
                     delete[] hermitePoints;
                 }
@@ -449,17 +216,8 @@ void GraphicsWindow::RedrawAll() {
                         bezierPoints[i] = BezierPoint(m_currentPoints[i].x, m_currentPoints[i].y);
                     }
                     
-                    // Calculate adaptive step count based on curve length
-                    double totalDistance = 0;
-                    for (size_t i = 0; i < m_currentPoints.size() - 1; i++) {
-                        double dx = m_currentPoints[i + 1].x - m_currentPoints[i].x;
-                        double dy = m_currentPoints[i + 1].y - m_currentPoints[i].y;
-                        totalDistance += sqrt(dx * dx + dy * dy);
-                    }
-                    int steps = std::max(50, std::min(1000, (int)(totalDistance * 1.5) + 20));
-                    
                     // Draw Bezier Curve preview
-                    DrawBezierCurve(hdc, bezierPoints, m_currentPoints.size(), steps, m_currentColor);
+                    DrawBezierCurveAdaptive(hdc, bezierPoints, m_currentPoints.size(), m_currentColor);
                     
                     delete[] bezierPoints;
                 }
@@ -507,13 +265,7 @@ void GraphicsWindow::RedrawAll() {
                         HermitePoint T1(m_currentPoints[i + 3].x - m_currentPoints[i + 2].x, 
                                       m_currentPoints[i + 3].y - m_currentPoints[i + 2].y);
                         
-                        // Calculate adaptive point count
-                        double dx = P1.x - P0.x;
-                        double dy = P1.y - P0.y;
-                        double distance = sqrt(dx * dx + dy * dy);
-                        int points = std::max(50, std::min(1000, (int)(distance * 2) + 10));
-                        
-                        DrawHermiteCurve(hdc, P0, T0, P1, T1, points, m_currentColor);
+                        DrawHermiteCurveAdaptive(hdc, P0, T0, P1, T1, m_currentColor);
                     }
                 }
 
@@ -565,320 +317,75 @@ void GraphicsWindow::RedrawAll() {
 
 // Draw shape to buffer
 void GraphicsWindow::DrawShapeToBuffer(const Shape& shape) {
-    if (!m_offscreenDC || shape.points.size() < 2) return;
-
-    // Draw shape using its respective algorithm to offscreen buffer
-    switch (shape.mode) {
-        case DrawingMode::LINE_DDA:
-            DrawLineDDA(m_offscreenDC, shape.points[0].x, shape.points[0].y,
-                       shape.points[1].x, shape.points[1].y, shape.color);
-            break;
-            
-        case DrawingMode::LINE_BRESENHAM:
-            DrawLineBresenham(m_offscreenDC, shape.points[0].x, shape.points[0].y,
-                             shape.points[1].x, shape.points[1].y, shape.color);
-            break;
-            
-        case DrawingMode::LINE_PARAMETRIC:
-            DrawLineParametric(m_offscreenDC, shape.points[0].x, shape.points[0].y,
-                              shape.points[1].x, shape.points[1].y, shape.color);
-            break;
-            
-        case DrawingMode::CIRCLE_DIRECT:
-        {
-            int radius = (int)sqrt(
-                pow(shape.points[1].x - shape.points[0].x, 2) +
-                pow(shape.points[1].y - shape.points[0].y, 2)
-            );
-            DrawDirectCircle(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            
-            // Apply fill mode if set
-            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                FillCircleWithLines(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                FillQuarterCircle(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                FillCircleWithCircles(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillNonRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            }
-        }
-            break;
-            
-        case DrawingMode::CIRCLE_POLAR:
-        {
-            int radius = (int)sqrt(
-                pow(shape.points[1].x - shape.points[0].x, 2) +
-                pow(shape.points[1].y - shape.points[0].y, 2)
-            );
-            DrawPolarCircle(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            
-            // Apply fill mode if set
-            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                FillCircleWithLines(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                FillQuarterCircle(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                FillCircleWithCircles(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillNonRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            }
-        }
-            break;
-            
-        case DrawingMode::CIRCLE_ITERATIVE_POLAR:
-        {
-            int radius = (int)sqrt(
-                pow(shape.points[1].x - shape.points[0].x, 2) +
-                pow(shape.points[1].y - shape.points[0].y, 2)
-            );
-            DrawIterativePolarCircle(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            
-            // Apply fill mode if set
-            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                FillCircleWithLines(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                FillQuarterCircle(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                FillCircleWithCircles(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillNonRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            }
-        }
-            break;
-            
-        case DrawingMode::CIRCLE_MIDPOINT:
-        {
-            int radius = (int)sqrt(
-                pow(shape.points[1].x - shape.points[0].x, 2) +
-                pow(shape.points[1].y - shape.points[0].y, 2)
-            );
-            DrawCircleBresenham(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            
-            // Apply fill mode if set
-            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                FillCircleWithLines(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                FillQuarterCircle(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                FillCircleWithCircles(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillNonRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            }
-        }
-            break;
-            
-        case DrawingMode::CIRCLE_MODIFIED_MIDPOINT:
-        {
-            int radius = (int)sqrt(
-                pow(shape.points[1].x - shape.points[0].x, 2) +
-                pow(shape.points[1].y - shape.points[0].y, 2)
-            );
-            DrawCircleDDA1(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            
-            // Apply fill mode if set
-            if (shape.fillMode == FillMode::CIRCLE_FILL_LINES) {
-                FillCircleWithLines(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_QUARTER) {
-                FillQuarterCircle(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::CIRCLE_FILL_CIRCLES) {
-                FillCircleWithCircles(m_offscreenDC, shape.points[0].x, shape.points[0].y, radius, shape.color);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            } else if (shape.fillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-                COLORREF bgColor = GetPixel(m_offscreenDC, shape.points[0].x, shape.points[0].y);
-                FloodFillNonRecursive(m_offscreenDC, shape.points[0].x, shape.points[0].y, shape.color, bgColor);
-            }
-        }
-            break;
-            
-        case DrawingMode::ELLIPSE_DIRECT:
-        {
-            int radiusX = abs(shape.points[1].x - shape.points[0].x);
-            int radiusY = abs(shape.points[1].y - shape.points[0].y);
-            DrawDirectEllipse(m_offscreenDC, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
-        }
-            break;
-            
-        case DrawingMode::ELLIPSE_POLAR:
-        {
-            int radiusX = abs(shape.points[1].x - shape.points[0].x);
-            int radiusY = abs(shape.points[1].y - shape.points[0].y);
-            DrawPolarEllipse(m_offscreenDC, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
-        }
-            break;
-            
-        case DrawingMode::ELLIPSE_MIDPOINT:
-        {
-            int radiusX = abs(shape.points[1].x - shape.points[0].x);
-            int radiusY = abs(shape.points[1].y - shape.points[0].y);
-            DrawEllipseBresenham(m_offscreenDC, shape.points[0].x, shape.points[0].y, radiusX, radiusY, shape.color);
-        }
-            break;
-
-        case DrawingMode::SQUARE:
-        {
-            if (shape.points.size() >= 2) {
-                // Calculate half-size (distance from center to edge)
-                int centerX = shape.points[0].x;
-                int centerY = shape.points[0].y;
-                int halfSize = (int)sqrt(
-                    pow(shape.points[1].x - centerX, 2) +
-                    pow(shape.points[1].y - centerY, 2)
-                );
-                
-                // Draw square using our DrawSquare function
-                DrawSquare(m_offscreenDC, centerX, centerY, halfSize, shape.color);
-                // Apply Hermite fill if set
-                if (shape.fillMode == FillMode::SQUARE_FILL_HERMITE_VERTICAL) {
-                    FillSquareWithVerticalHermite(m_offscreenDC, centerX, centerY, halfSize, shape.color);
-                }
-            }
-        }
-            break;
-
-        case DrawingMode::RECTANGLE:
-        {
-            if (shape.points.size() >= 2) {
-                // Draw rectangle using our DrawRectangle function
-                DrawRectangle(m_offscreenDC, shape.points[0].x, shape.points[0].y,
-                            shape.points[1].x, shape.points[1].y, shape.color);
-                // Apply Bezier fill if set
-                if (shape.fillMode == FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL) {
-                    FillRectangleWithHorizontalBezier(m_offscreenDC, shape.points[0].x, shape.points[0].y,
-                                                    shape.points[1].x, shape.points[1].y, shape.color);
-                }
-            }
-        }
-            break;
+    if (!m_framebuffer.IsValid()) return;
 
-        case DrawingMode::POLYGON:
-        {
-            if (shape.points.size() >= 3) {
+    // Rasterize straight into the framebuffer memory, marking the tiles
+    // written so only those are presented
+    BgraSink sink(m_framebuffer);
+    RenderShape(sink, shape);
+    m_framebuffer.MarkModified();
+}
 
-                // draw the polygon
-                DrawPolygon(m_offscreenDC, shape.points ,shape.color);
+// Append a shape to the scene and its index; drawing it is up to the caller
+void GraphicsWindow::AddShape(const Shape& shape) {
+    m_scene.Add(shape);
+    m_shapeIndex.Add(m_scene);
+}
 
-                // Apply polygon fill if set
-                if (shape.fillMode == FillMode::POLYGON_CONVEX_FILL || 
-                    shape.fillMode == FillMode::POLYGON_NONCONVEX_FILL) {
-                    
-                    PolygonPoint* pointsArray = new PolygonPoint[shape.points.size()];
-                    for (size_t i = 0; i < shape.points.size(); i++) {
-                        pointsArray[i] = PolygonPoint(shape.points[i].x, shape.points[i].y);
-                    }
-                    
-                    if (shape.fillMode == FillMode::POLYGON_CONVEX_FILL) {
-                        ConvexFill(m_offscreenDC, pointsArray, shape.points.size(), shape.color);
-                    } else {
-                        NonConvexFill(m_offscreenDC, pointsArray, shape.points.size(), shape.color);
-                    }
-                    
-                    delete[] pointsArray;
-                }
-            }
-        }
-            break;
-
-        case DrawingMode::CURVE_CARDINAL:
-        {
-            if (shape.points.size() >= 2) {
-                // Convert Point to HermitePoint
-                HermitePoint* hermitePoints = new HermitePoint[shape.points.size()];
-                for (size_t i = 0; i < shape.points.size(); i++) {
-                    hermitePoints[i] = HermitePoint(shape.points[i].x, shape.points[i].y);
-                }
-                
-                // Draw Cardinal Spline with default tension (0.5) and 50 points per segment
-                DrawCardinalSpline(m_offscreenDC, hermitePoints, shape.points.size(), 0.5, 50, shape.color);
-                
-                delete[] hermitePoints;
-            }
-        }
-            break;
-
-        case DrawingMode::CURVE_BEZIER:
-        {
-            if (shape.points.size() >= 2) {
-                // Convert Point to BezierPoint
-                BezierPoint* bezierPoints = new BezierPoint[shape.points.size()];
-                for (size_t i = 0; i < shape.points.size(); i++) {
-                    bezierPoints[i] = BezierPoint(shape.points[i].x, shape.points[i].y);
-                }
-                
-                // Calculate adaptive step count based on curve length
-                double totalDistance = 0;
-                for (size_t i = 0; i < shape.points.size() - 1; i++) {
-                    double dx = shape.points[i + 1].x - shape.points[i].x;
-                    double dy = shape.points[i + 1].y - shape.points[i].y;
-                    totalDistance += sqrt(dx * dx + dy * dy);
-                }
-                int steps = std::max(50, std::min(1000, (int)(totalDistance * 1.5) + 20));
-                
-                // Draw Bezier Curve
-                DrawBezierCurve(m_offscreenDC, bezierPoints, shape.points.size(), steps, shape.color);
-                
-                delete[] bezierPoints;
-            }
-        }
-            break;
-
-        case DrawingMode::CURVE_HERMITE:
-        {
-            if (shape.points.size() >= 4) {
-                // For Hermite curves, draw curves for complete point quadruples: (P0, T0, P1, T1)
-                for (size_t i = 0; i + 3 < shape.points.size(); i += 4) {
-                    HermitePoint P0(shape.points[i].x, shape.points[i].y);
-                    HermitePoint T0(shape.points[i + 1].x - shape.points[i].x, 
-                                  shape.points[i + 1].y - shape.points[i].y);
-                    HermitePoint P1(shape.points[i + 2].x, shape.points[i + 2].y);
-                    HermitePoint T1(shape.points[i + 3].x - shape.points[i + 2].x, 
-                                  shape.points[i + 3].y - shape.points[i + 2].y);
-                    
-                    // Calculate adaptive point count
-                    double dx = P1.x - P0.x;
-                    double dy = P1.y - P0.y;
-                    double distance = sqrt(dx * dx + dy * dy);
-                    int points = std::max(50, std::min(1000, (int)(distance * 2) + 10));
-                    
-                    DrawHermiteCurve(m_offscreenDC, P0, T0, P1, T1, points, shape.color);
-                }
-            }
+// Shape 'index' changed in place (e.g. got a fill): clear and redraw only
+// its old and new bounds instead of the whole scene
+void GraphicsWindow::RedrawChangedShape(std::size_t index) {
+    if (!m_framebuffer.IsValid()) return;
+
+    // A circle that was flood filled from the target may have filled
+    // anything around it
+    if (!m_shapeIndex.IsBounded(index)) {
+        RebuildOffscreenBuffer();
+        return;
+    }
+    PixelRect damage = m_shapeIndex.Bounds(index);
+    m_shapeIndex.Update(m_scene, index);
+    if (m_shapeIndex.IsBounded(index)) {
+        const PixelRect& bounds = m_shapeIndex.Bounds(index);
+        if (damage.IsEmpty()) {
+            damage = bounds;
+        } else if (!bounds.IsEmpty()) {
+            damage = { std::min(damage.left, bounds.left), std::min(damage.top, bounds.top),
+                       std::max(damage.right, bounds.right), std::max(damage.bottom, bounds.bottom) };
         }
-            break;
-            
-        default:
-            // TODO: Implement other shape algorithms
-            break;
     }
+
+    if (!RedrawRegion(m_framebuffer, m_scene, m_shapeIndex, damage, m_backgroundColor, &m_displayLists)) {
+        RebuildOffscreenBuffer();
+        return;
+    }
+    m_framebuffer.MarkModified();
 }
 
 // Rebuild offscreen buffer
 void GraphicsWindow::RebuildOffscreenBuffer() {
-    if (!m_offscreenDC) return;
+    if (!m_framebuffer.IsValid()) return;
     
-    // Clear buffer
+    // Clear buffer; this dirties every tile, so the redraw doesn't track them
     ClearOffscreenBuffer();
+    m_shapeIndex.Build(m_scene, m_framebuffer.Width(), m_framebuffer.Height());
     
-    // Redraw all shapes
-    for (const auto& shape : m_shapes) {
-        DrawShapeToBuffer(shape);
-    }
+    // Redraw all shapes, tiles in parallel; same pixels as drawing them in
+    // order. The scene supplies the bounds to cull shapes off the canvas,
+    // and shapes drawn before replay their display lists.
+    m_rebuilder.Render(m_framebuffer, m_scene, &m_displayLists);
+    m_framebuffer.MarkModified();
+
+    // Includes every shape a load in progress has taken so far
+    m_loadDrawn = m_scene.Size();
+
+#ifdef GFX_PAINT_STATS
+    const DisplayListStats& lists = m_displayLists.Stats();
+    char message[160];
+    snprintf(message, sizeof(message), "Rebuild: %zu display lists recorded; cache %zu lists, %zu / %zu bytes, "
+             "%llu hits, %llu misses, %llu evictions\n",
+             m_rebuilder.LastStats().recorded, lists.lists, lists.bytes, lists.budget,
+             (unsigned long long)lists.hits, (unsigned long long)lists.misses, (unsigned long long)lists.evictions);
+    OutputDebugStringA(message);
+#endif
 }
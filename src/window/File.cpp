@@ -1,4 +1,15 @@
 #include "../../include/Window.h"
+#include <cstdio>
+
+using LoadClock = std::chrono::steady_clock;
+
+// How long one WM_SCENE_LOAD may spend drawing before the window goes
+// back to its messages
+static const double LOAD_FRAME_MS = 16.0;
+
+static double MillisecondsSince(LoadClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(LoadClock::now() - start).count();
+}
 
 // Save to file
 void GraphicsWindow::SaveToFile() {
@@ -17,31 +28,19 @@ void GraphicsWindow::SaveToFile() {
     ofn.lpstrTitle = "Save Drawing As";
     ofn.Flags = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT;
 
+    if (m_loading) {
+        MessageBox(m_hwnd, "The drawing is still loading; wait for it to finish or press Esc to cancel.",
+                   "Save", MB_OK | MB_ICONINFORMATION);
+        return;
+    }
+
     if (GetSaveFileName(&ofn)) {
-        std::ofstream outFile(szFile, std::ios::binary);
-        if (!outFile) {
-            MessageBox(m_hwnd, "Failed to open file for writing.", "Error", MB_OK | MB_ICONERROR);
+        // A loaded scene may still be reading the file being replaced
+        m_scene.Detach();
+        if (!SaveSceneToFile(szFile, m_scene)) {
+            MessageBox(m_hwnd, "Failed to write file.", "Error", MB_OK | MB_ICONERROR);
             return;
         }
-
-        int shapeCnt = m_shapes.size();
-        outFile.write(reinterpret_cast<const char*>(&shapeCnt), sizeof(shapeCnt));
-
-        for(auto& shape:m_shapes) {
-            outFile.write(reinterpret_cast<const char*>(&shape.mode), sizeof(shape.mode));
-            outFile.write(reinterpret_cast<const char*>(&shape.color), sizeof(shape.color));
-            outFile.write(reinterpret_cast<const char*>(&shape.fillMode), sizeof(shape.fillMode));
-            outFile.write(reinterpret_cast<const char*>(&shape.thickness), sizeof(shape.thickness));
-
-            int pointCnt = shape.points.size();
-            outFile.write(reinterpret_cast<const char*>(&pointCnt), sizeof(pointCnt));
-
-            if (pointCnt > 0) {
-                outFile.write(reinterpret_cast<const char*>(shape.points.data()), pointCnt * sizeof(Point));
-            }
-        }
-        
-        outFile.close();
     }
 }
 
@@ -63,37 +62,115 @@ void GraphicsWindow::LoadFromFile() {
     ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST;
 
     if (GetOpenFileName(&ofn)) {
-        std::ifstream inFile(szFile, std::ios::binary);
-        if (!inFile) {
-            MessageBox(m_hwnd, "Failed to open file for reading.", "Error", MB_OK | MB_ICONERROR);
-            return;
-        }
+        // A second load replaces the first, and the drawing from before
+        // both is what comes back if it fails
+        if (m_loading) CancelLoad();
 
+        // Parse on the loader's thread and draw the shapes as they arrive
+        // instead of after the whole file
+        m_loadPrevious = std::move(m_scene);
         ClearCanvas();
+        m_loading = true;
+        m_loadPosted = false;
+        m_loadDrawn = 0;
+        m_loadFirstPixelMs = -1;
+        m_loadStart = LoadClock::now();
+        m_loader.Start(szFile, [this]() { PostLoadMessage(); });
+        InvalidateStatusText();
+    }
+}
 
-        int shapeCnt = 0;
-        inFile.read(reinterpret_cast<char*>(&shapeCnt), sizeof(shapeCnt));
-        for (int i = 0; i < shapeCnt; ++i) {
-            Shape shape;
+// Queue a WM_SCENE_LOAD unless one is already waiting; called from the
+// loader's thread as well as the window's
+void GraphicsWindow::PostLoadMessage() {
+    if (!m_loadPosted.exchange(true)) PostMessage(m_hwnd, WM_SCENE_LOAD, 0, 0);
+}
 
-            inFile.read(reinterpret_cast<char*>(&shape.mode), sizeof(shape.mode));
-            inFile.read(reinterpret_cast<char*>(&shape.color), sizeof(shape.color));
-            inFile.read(reinterpret_cast<char*>(&shape.fillMode), sizeof(shape.fillMode));
-            inFile.read(reinterpret_cast<char*>(&shape.thickness), sizeof(shape.thickness));
+// Take the shapes parsed since the last call and draw them, for up to one
+// frame; what doesn't fit is drawn by the next message
+void GraphicsWindow::ContinueLoad() {
+    // Cleared before taking, so shapes that land after the take post again
+    m_loadPosted = false;
+    if (!m_loading) return;
+
+    // The state before the take: once it is final every batch is pending
+    const SceneLoader::State state = m_loader.GetState();
+    m_loader.TakeShapes(m_scene);
+    while (m_shapeIndex.Count() < m_scene.Size()) {
+        m_shapeIndex.Add(m_scene);
+    }
 
-            int pointCnt = 0;
-            inFile.read(reinterpret_cast<char*>(&pointCnt), sizeof(pointCnt));
+    if (!m_framebuffer.IsValid()) {
+        // Minimized; the rebuild on restore draws everything
+        m_loadDrawn = m_scene.Size();
+    } else if (m_loadDrawn < m_scene.Size()) {
+        // In file order, over what is already there: the same pixels as a
+        // rebuild of the shapes so far
+        LoadClock::time_point frameStart = LoadClock::now();
+        BgraSink sink(m_framebuffer);
+        while (m_loadDrawn < m_scene.Size()) {
+            RenderShape(sink, m_scene.View(m_loadDrawn++));
+            if ((m_loadDrawn & 255) == 0 && MillisecondsSince(frameStart) > LOAD_FRAME_MS) break;
+        }
+        m_framebuffer.MarkModified();
+        PresentDirtyTiles();
 
-            shape.points.resize(pointCnt);
-            if (pointCnt > 0) {
-                inFile.read(reinterpret_cast<char*>(shape.points.data()), pointCnt * sizeof(Point));
-            }
-            m_shapes.push_back(shape);
+        if (m_loadFirstPixelMs < 0) {
+            UpdateWindow(m_hwnd);
+            m_loadFirstPixelMs = MillisecondsSince(m_loadStart);
         }
-        inFile.close();
-        InvalidateRect(m_hwnd, nullptr, TRUE);
-        RedrawAll();
-        RebuildOffscreenBuffer();
-        InvalidateRect(m_hwnd, NULL, TRUE);
     }
+    InvalidateStatusText();
+
+    if (m_loadDrawn < m_scene.Size()) {
+        PostLoadMessage();
+        return;
+    }
+
+    if (state == SceneLoader::State::DONE) {
+        FinishLoad();
+    } else if (state == SceneLoader::State::FAILED) {
+        RestorePreviousScene();
+        MessageBox(m_hwnd, "Failed to read file.", "Error", MB_OK | MB_ICONERROR);
+    }
+}
+
+void GraphicsWindow::FinishLoad() {
+    m_loading = false;
+    m_loadPrevious.Clear();
+    InvalidateStatusText();
+
+#ifdef GFX_PAINT_STATS
+    // Time to first pixel is what the wait feels like; the rest is the
+    // drawing filling in
+    char message[192];
+    snprintf(message, sizeof(message), "Load: %zu shapes, first pixel %.1f ms, total %.1f ms "
+             "(parse: first batch %.1f ms, all %.1f ms)\n",
+             m_scene.Size(), m_loadFirstPixelMs, MillisecondsSince(m_loadStart),
+             m_loader.FirstBatchMs(), m_loader.TotalMs());
+    OutputDebugStringA(message);
+#endif
+}
+
+// Esc while loading: stop the loader and put back the previous drawing
+void GraphicsWindow::CancelLoad() {
+    if (!m_loading) return;
+    m_loader.Cancel();
+    RestorePreviousScene();
+
+#ifdef GFX_PAINT_STATS
+    char message[96];
+    snprintf(message, sizeof(message), "Load cancelled after %.1f ms\n", MillisecondsSince(m_loadStart));
+    OutputDebugStringA(message);
+#endif
+}
+
+void GraphicsWindow::RestorePreviousScene() {
+    m_loading = false;
+    m_scene = std::move(m_loadPrevious);
+    m_loadPrevious.Clear();
+    m_displayLists.Clear();
+    RebuildOffscreenBuffer();
+    PresentDirtyTiles();
+    InvalidateStatusText();
 }
@@ -73,6 +73,10 @@ void GraphicsWindow::InitializeMenus() {
     AppendMenu(hFill, MF_STRING, MENU_FILL_POLYGON_NONCONVEX, "Polygon - Non-Convex");
     AppendMenu(hFill, MF_STRING, MENU_FILL_FLOOD_RECURSIVE, "Flood Fill - Recursive");
     AppendMenu(hFill, MF_STRING, MENU_FILL_FLOOD_NONRECURSIVE, "Flood Fill - Non-Recursive");
+    AppendMenu(hFill, MF_STRING, MENU_FILL_FLOOD_PARALLEL, "Flood Fill - Parallel");
+    AppendMenu(hFill, MF_SEPARATOR, 0, NULL);
+    AppendMenu(hFill, MF_STRING, MENU_FILL_ANTIALIASED_EVEN_ODD, "Anti-aliased - Even-Odd");
+    AppendMenu(hFill, MF_STRING, MENU_FILL_ANTIALIASED_NON_ZERO, "Anti-aliased - Non-Zero");
     AppendMenu(m_hMenuBar, MF_POPUP, (UINT_PTR)hFill, "Fill");
 
     // Tools menu
@@ -141,6 +145,9 @@ void GraphicsWindow::HandleMenuCommand(WPARAM wParam) {
         case MENU_FILL_POLYGON_NONCONVEX:   SetFillMode(FillMode::POLYGON_NONCONVEX_FILL); break;
         case MENU_FILL_FLOOD_RECURSIVE:     SetFillMode(FillMode::FLOOD_FILL_RECURSIVE_POLYGON); break;
         case MENU_FILL_FLOOD_NONRECURSIVE:  SetFillMode(FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON); break;
+        case MENU_FILL_FLOOD_PARALLEL:      SetFillMode(FillMode::FLOOD_FILL_PARALLEL_POLYGON); break;
+        case MENU_FILL_ANTIALIASED_EVEN_ODD: SetFillMode(FillMode::ANTIALIASED_EVEN_ODD); break;
+        case MENU_FILL_ANTIALIASED_NON_ZERO: SetFillMode(FillMode::ANTIALIASED_NON_ZERO); break;
         case MENU_FILL_SQUARE_HERMITE:      SetFillMode(FillMode::SQUARE_FILL_HERMITE_VERTICAL); break;
         case MENU_FILL_RECTANGLE_BEZIER:    SetFillMode(FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL); break;
 
@@ -50,6 +50,14 @@ LRESULT GraphicsWindow::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM l
         }
             break;
 
+        case WM_KEYDOWN:
+            if (wParam == VK_ESCAPE) CancelLoad();
+            break;
+
+        case WM_SCENE_LOAD:
+            ContinueLoad();
+            break;
+
         case WM_SETCURSOR:
             if (LOWORD(lParam) == HTCLIENT) {
                 ::SetCursor(m_currentCursor);
@@ -57,15 +65,23 @@ LRESULT GraphicsWindow::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM l
             }
             return DefWindowProc(hwnd, message, wParam, lParam);
 
+        case WM_ERASEBKGND:
+            // WM_PAINT copies the canvas over the whole client area
+            return 1;
+
         case WM_PAINT:
         {
+            // The update region itself, not just its bounding box in
+            // ps.rcPaint, so separate dirty areas are copied separately
+            HRGN update = CreateRectRgn(0, 0, 0, 0);
+            GetUpdateRgn(hwnd, update, FALSE);
+
             PAINTSTRUCT ps;
             HDC hdc = BeginPaint(hwnd, &ps);
 
             // Copy from offscreen buffer for much better performance
-            if (m_offscreenDC) {
-                BitBlt(hdc, 0, 0, m_canvasWidth, m_canvasHeight, m_offscreenDC, 0, 0, SRCCOPY);
-            }
+            BlitUpdateRegion(hdc, update);
+            DeleteObject(update);
 
             // Draw instructions on top
             SetTextColor(hdc, RGB(100, 100, 100));
@@ -76,8 +92,11 @@ LRESULT GraphicsWindow::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM l
                     m_currentFillMode == FillMode::POLYGON_NONCONVEX_FILL) {
                     TextOut(hdc, 10, 10, "POLYGON FILL: Click near existing polygon to fill it", 53);
                 } else if (m_currentFillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON || 
-                           m_currentFillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
+                           m_currentFillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON ||
+                           m_currentFillMode == FillMode::FLOOD_FILL_PARALLEL_POLYGON) {
                     TextOut(hdc, 10, 10, "FLOOD FILL MODE: Click inside area to fill", 43);
+                } else if (IsAntialiasedFill(m_currentFillMode)) {
+                    TextOut(hdc, 10, 10, "ANTI-ALIASED FILL: Click a circle, ellipse, polygon or curve to fill it", 71);
                 } else if (m_currentFillMode == FillMode::SQUARE_FILL_HERMITE_VERTICAL) {
                     TextOut(hdc, 10, 10, "SQUARE HERMITE FILL: Click inside a square to fill it | Right click to cancel", 78);
                 } else if (m_currentFillMode == FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL) {
@@ -128,12 +147,37 @@ LRESULT GraphicsWindow::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM l
                 case FillMode::POLYGON_NONCONVEX_FILL: fillText += "Non-Convex Polygon"; break;
                 case FillMode::FLOOD_FILL_RECURSIVE_POLYGON: fillText += "Flood Fill Recursive"; break;
                 case FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON: fillText += "Flood Fill Non-Recursive"; break;
+                case FillMode::FLOOD_FILL_PARALLEL_POLYGON: fillText += "Flood Fill Parallel"; break;
+                case FillMode::ANTIALIASED_EVEN_ODD: fillText += "Anti-aliased Even-Odd"; break;
+                case FillMode::ANTIALIASED_NON_ZERO: fillText += "Anti-aliased Non-Zero"; break;
                 case FillMode::SQUARE_FILL_HERMITE_VERTICAL: fillText += "Square Hermite Curves"; break;
                 case FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL: fillText += "Rectangle Bezier Curves"; break;
                 default: fillText += "None"; break;
             }
             TextOut(hdc, 10, 50, fillText.c_str(), fillText.length());
 
+            // Which polygon filler the rebuilds picked; while loading, how
+            // far the load has got instead
+            PolygonFillStats polygonFills = GetPolygonFillStats();
+            if (m_loading) {
+                SceneLoadProgress progress = m_loader.Progress();
+                int percent = progress.totalShapes ? (int)(100.0 * m_loadDrawn / progress.totalShapes) : 0;
+                std::string loadText = "Loading: " + std::to_string(percent) + "% (" +
+                                       std::to_string(m_loadDrawn) + " of " +
+                                       std::to_string(progress.totalShapes) + " shapes) | Esc to cancel";
+                TextOut(hdc, 10, 70, loadText.c_str(), loadText.length());
+
+                RECT bar = { 10, 86, 10 + 3 * percent, 89 };
+                HBRUSH barBrush = CreateSolidBrush(RGB(100, 100, 100));
+                FillRect(hdc, &bar, barBrush);
+                DeleteObject(barBrush);
+            } else if (polygonFills.convex + polygonFills.monotone + polygonFills.general > 0) {
+                std::string pathText = "Polygon fills: convex " + std::to_string(polygonFills.convex) +
+                                       " | monotone " + std::to_string(polygonFills.monotone) +
+                                       " | general " + std::to_string(polygonFills.general);
+                TextOut(hdc, 10, 70, pathText.c_str(), pathText.length());
+            }
+
             EndPaint(hwnd, &ps);
         }
             break;
@@ -151,7 +195,7 @@ LRESULT GraphicsWindow::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM l
                 RebuildOffscreenBuffer();
             }
             
-            InvalidateRect(hwnd, NULL, TRUE);
+            PresentDirtyTiles();
         }
             break;
 
@@ -171,6 +215,9 @@ LRESULT GraphicsWindow::WndProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM l
 
 // Handle mouse click
 void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
+    // Shapes and fills go on the drawing once it has loaded
+    if (m_loading) return;
+
     if (!isLeftButton) {
         // Right click - finish current drawing or cancel
         if (m_isDrawing && m_currentDrawingMode == DrawingMode::POLYGON && m_currentPoints.size() >= 3) {
@@ -181,7 +228,7 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
             shape.fillMode = FillMode::NONE;  // Always create polygons empty
             shape.points = m_currentPoints;
             shape.thickness = m_lineThickness;
-            m_shapes.push_back(shape);
+            AddShape(shape);
 
             // Draw directly to offscreen buffer for performance
             DrawShapeToBuffer(shape);
@@ -194,7 +241,7 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
             shape.fillMode = FillMode::NONE;  // Always create shapes empty
             shape.points = m_currentPoints;
             shape.thickness = m_lineThickness;
-            m_shapes.push_back(shape);
+            AddShape(shape);
 
             // Draw directly to offscreen buffer for performance
             DrawShapeToBuffer(shape);
@@ -207,7 +254,7 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
             shape.fillMode = FillMode::NONE;  // Always create shapes empty
             shape.points = m_currentPoints;
             shape.thickness = m_lineThickness;
-            m_shapes.push_back(shape);
+            AddShape(shape);
 
             // Draw directly to offscreen buffer for performance
             DrawShapeToBuffer(shape);
@@ -220,7 +267,7 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
             shape.fillMode = FillMode::NONE;  // Always create shapes empty
             shape.points = m_currentPoints;
             shape.thickness = m_lineThickness;
-            m_shapes.push_back(shape);
+            AddShape(shape);
 
             // Draw directly to offscreen buffer for performance
             DrawShapeToBuffer(shape);
@@ -229,145 +276,103 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
         // Reset drawing state
         m_isDrawing = false;
         m_currentPoints.clear();
-        InvalidateRect(m_hwnd, NULL, TRUE);
+        PresentDirtyTiles();
         return;
     }
 
     // Left click - check if we're in fill mode first
     Point newPoint(x, y);
     
-    // If we're in fill mode, try to fill an existing circle
+    // If we're in fill mode, try to fill an existing shape
     if (m_fillMode) {
+        auto isCircle = [](const ShapeView& shape) {
+            return shape.mode == DrawingMode::CIRCLE_DIRECT ||
+                   shape.mode == DrawingMode::CIRCLE_POLAR ||
+                   shape.mode == DrawingMode::CIRCLE_ITERATIVE_POLAR ||
+                   shape.mode == DrawingMode::CIRCLE_MIDPOINT ||
+                   shape.mode == DrawingMode::CIRCLE_MODIFIED_MIDPOINT;
+        };
+
+        // Fill the first shape (in drawing order) under the click that
+        // 'accept' takes; the index only tests shapes near the click
+        auto fillShapeAt = [&](const std::function<bool(const ShapeView&)>& accept) {
+            std::ptrdiff_t hit = m_shapeIndex.HitTest(m_scene, x, y, accept);
+            if (hit < 0) return;
+            // Use current color for fill
+            m_scene.SetFill((std::size_t)hit, m_currentFillMode, m_currentColor);
+
+            // Redraw just the area under the shape
+            RedrawChangedShape((std::size_t)hit);
+            PresentDirtyTiles();
+        };
+
         if (m_currentFillMode == FillMode::POLYGON_CONVEX_FILL || 
             m_currentFillMode == FillMode::POLYGON_NONCONVEX_FILL) {
-            
-            // Fill existing polygons by clicking on them
-            for (auto& shape : m_shapes) {
-                if (shape.mode == DrawingMode::POLYGON && shape.points.size() >= 3) {
-                    // Simple point-in-polygon test - check if click is near any vertex
-                    bool inside = false;
-                    for (size_t i = 0; i < shape.points.size(); i++) {
-                        if (abs(shape.points[i].x - x) <= 50 && abs(shape.points[i].y - y) <= 50) {
-                            inside = true;
-                            break;
-                        }
-                    }
-                    
-                    if (inside) {
-                        shape.fillMode = m_currentFillMode;
-                        shape.color = m_currentColor;  // Use current color for fill
-                        RebuildOffscreenBuffer();
-                        InvalidateRect(m_hwnd, NULL, TRUE);
-                        return;
-                    }
-                }
-            }
+            // Fill existing polygons by clicking inside them
+            fillShapeAt([](const ShapeView& shape) {
+                return shape.mode == DrawingMode::POLYGON && shape.points.size() >= 3;
+            });
             return;
         }
         
         if (m_currentFillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON || 
-            m_currentFillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON) {
-            COLORREF originalColor = GetPixel(m_offscreenDC, x, y);
-            if (originalColor != m_currentColor) {
-                if (m_currentFillMode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON) {
-                    FloodFillRecursive(m_offscreenDC, x, y, m_currentColor, originalColor);
-                } else {
-                    FloodFillNonRecursive(m_offscreenDC, x, y, m_currentColor, originalColor);
+            m_currentFillMode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON ||
+            m_currentFillMode == FillMode::FLOOD_FILL_PARALLEL_POLYGON) {
+            // Fill once and record the filled runs as a scene shape, so
+            // rebuilds, resizes and saves replay them instead of refilling
+            Shape fill;
+            fill.mode = DrawingMode::FLOOD_FILL;
+            fill.color = m_currentColor;
+            fill.fillMode = m_currentFillMode;
+            fill.thickness = 1;
+            fill.points.push_back(Point(x, y));
+
+            std::size_t filled = 0;
+            if (m_currentFillMode == FillMode::FLOOD_FILL_PARALLEL_POLYGON) {
+                // Labels are reused until something else draws into the buffer
+                filled = m_floodLabels.Fill(m_framebuffer, x, y, m_currentColor, &fill.spans);
+            } else {
+                // Same region either way; the span fill never overflows the stack
+                BgraSink sink(m_framebuffer);
+                COLORREF originalColor = sink.Read(x, y);
+                if (originalColor != m_currentColor) {
+                    filled = FloodFillScanline(sink, x, y, m_currentColor, originalColor, &fill.spans);
+                    m_framebuffer.MarkModified();
                 }
-                InvalidateRect(m_hwnd, NULL, TRUE);
+            }
+
+            if (filled > 0) {
+                NormalizeSpans(fill.spans);
+                AddShape(fill);
+                PresentDirtyTiles();
             }
             return;
         }
 
-        for (auto& shape : m_shapes) {
-            // Check if it's a circle shape and if click is inside it
-            if ((shape.mode == DrawingMode::CIRCLE_DIRECT ||
-                 shape.mode == DrawingMode::CIRCLE_POLAR ||
-                 shape.mode == DrawingMode::CIRCLE_ITERATIVE_POLAR ||
-                 shape.mode == DrawingMode::CIRCLE_MIDPOINT ||
-                 shape.mode == DrawingMode::CIRCLE_MODIFIED_MIDPOINT) &&
-                shape.points.size() >= 2) {
-                
-                // Calculate circle radius
-                int radius = (int)sqrt(
-                    pow(shape.points[1].x - shape.points[0].x, 2) +
-                    pow(shape.points[1].y - shape.points[0].y, 2)
-                );
-                
-                // Check if click point is inside this circle
-                if (IsPointInCircle(x, y, shape.points[0].x, shape.points[0].y, radius)) {
-                    // Update the shape's fill mode and color
-                    shape.fillMode = m_currentFillMode;
-                    shape.color = m_currentColor;  // Use current color for fill
-                    
-                    // Rebuild buffer to ensure proper rendering with fills
-                    RebuildOffscreenBuffer();
-                    
-                    InvalidateRect(m_hwnd, NULL, TRUE);
-                    return; // Fill the first circle found and exit
-                }
-            }
-            // Check if it's a square shape and if click is inside it
-            if (shape.mode == DrawingMode::SQUARE && 
-                shape.points.size() >= 2 &&
-                m_currentFillMode == FillMode::SQUARE_FILL_HERMITE_VERTICAL) {
-                
-                // Calculate square boundaries
-                int centerX = shape.points[0].x;
-                int centerY = shape.points[0].y;
-                int halfSize = (int)sqrt(
-                    pow(shape.points[1].x - centerX, 2) +
-                    pow(shape.points[1].y - centerY, 2)
-                );
-                
-                // Check if click point is inside this square
-                if (x >= centerX - halfSize && x <= centerX + halfSize &&
-                    y >= centerY - halfSize && y <= centerY + halfSize) {
-                    // Update the shape's fill mode and color
-                    shape.fillMode = m_currentFillMode;
-                    shape.color = m_currentColor;  // Use current color for fill
-                    
-                    // Rebuild buffer to ensure proper rendering with fills
-                    RebuildOffscreenBuffer();
-                    
-                    InvalidateRect(m_hwnd, NULL, TRUE);
-                    return; // Fill the first square found and exit
-                }
-            }
-            // Check if it's a rectangle shape and if click is inside it
-            if (shape.mode == DrawingMode::RECTANGLE && 
-                shape.points.size() >= 2 &&
-                m_currentFillMode == FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL) {
-                
-                // Calculate rectangle boundaries using center/vertex coordinate system
-                int centerX = shape.points[0].x;
-                int centerY = shape.points[0].y;
-                int vertexX = shape.points[1].x;
-                int vertexY = shape.points[1].y;
-                
-                int halfWidth = abs(vertexX - centerX);
-                int halfHeight = abs(vertexY - centerY);
-                
-                int left = centerX - halfWidth;
-                int right = centerX + halfWidth;
-                int top = centerY - halfHeight;
-                int bottom = centerY + halfHeight;
-                
-                // Check if click point is inside this rectangle
-                if (x >= left && x <= right && y >= top && y <= bottom) {
-                    // Update the shape's fill mode and color
-                    shape.fillMode = m_currentFillMode;
-                    shape.color = m_currentColor;  // Use current color for fill
-                    
-                    // Rebuild buffer to ensure proper rendering with fills
-                    RebuildOffscreenBuffer();
-                    
-                    InvalidateRect(m_hwnd, NULL, TRUE);
-                    return; // Fill the first rectangle found and exit
-                }
-            }
+        if (IsAntialiasedFill(m_currentFillMode)) {
+            fillShapeAt([&](const ShapeView& shape) {
+                return isCircle(shape) ||
+                       shape.mode == DrawingMode::ELLIPSE_DIRECT ||
+                       shape.mode == DrawingMode::ELLIPSE_POLAR ||
+                       shape.mode == DrawingMode::ELLIPSE_MIDPOINT ||
+                       shape.mode == DrawingMode::POLYGON ||
+                       shape.mode == DrawingMode::CURVE_BEZIER ||
+                       shape.mode == DrawingMode::CURVE_CARDINAL ||
+                       shape.mode == DrawingMode::CURVE_HERMITE;
+            });
+            return;
         }
-        return; // In fill mode but didn't click inside any shape
+
+        // Circles take any of the remaining fills; squares and rectangles
+        // only their own
+        fillShapeAt([&](const ShapeView& shape) {
+            return isCircle(shape) ||
+                   (shape.mode == DrawingMode::SQUARE &&
+                    m_currentFillMode == FillMode::SQUARE_FILL_HERMITE_VERTICAL) ||
+                   (shape.mode == DrawingMode::RECTANGLE &&
+                    m_currentFillMode == FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL);
+        });
+        return;
     }
 
     // Normal drawing mode - add point or complete shape
@@ -391,14 +396,14 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 shape.fillMode = FillMode::NONE;  // Always create shapes empty
                 shape.points = m_currentPoints;
                 shape.thickness = m_lineThickness;
-                m_shapes.push_back(shape);
+                AddShape(shape);
 
                 // Draw directly to offscreen buffer for performance
                 DrawShapeToBuffer(shape);
 
                 m_isDrawing = false;
                 m_currentPoints.clear();
-                InvalidateRect(m_hwnd, NULL, TRUE);
+                PresentDirtyTiles();
             }
         }
             break;
@@ -424,14 +429,14 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 shape.fillMode = FillMode::NONE;  // Always create shapes empty
                 shape.points = m_currentPoints;
                 shape.thickness = m_lineThickness;
-                m_shapes.push_back(shape);
+                AddShape(shape);
 
                 // Draw directly to offscreen buffer for performance
                 DrawShapeToBuffer(shape);
 
                 m_isDrawing = false;
                 m_currentPoints.clear();
-                InvalidateRect(m_hwnd, NULL, TRUE);
+                PresentDirtyTiles();
             }
         }
             break;
@@ -455,14 +460,14 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 shape.fillMode = FillMode::NONE;  // Always create shapes empty
                 shape.points = m_currentPoints;
                 shape.thickness = m_lineThickness;
-                m_shapes.push_back(shape);
+                AddShape(shape);
 
                 // Draw directly to offscreen buffer for performance
                 DrawShapeToBuffer(shape);
 
                 m_isDrawing = false;
                 m_currentPoints.clear();
-                InvalidateRect(m_hwnd, NULL, TRUE);
+                PresentDirtyTiles();
             }
         }
             break;
@@ -484,14 +489,14 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 shape.fillMode = FillMode::NONE;  // Always create squares empty
                 shape.points = m_currentPoints;
                 shape.thickness = m_lineThickness;
-                m_shapes.push_back(shape);
+                AddShape(shape);
 
                 // Draw directly to offscreen buffer for performance
                 DrawShapeToBuffer(shape);
 
                 m_isDrawing = false;
                 m_currentPoints.clear();
-                InvalidateRect(m_hwnd, NULL, TRUE);
+                PresentDirtyTiles();
             }
         }
             break;
@@ -513,14 +518,14 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 shape.fillMode = FillMode::NONE;  // Always create rectangles empty
                 shape.points = m_currentPoints;
                 shape.thickness = m_lineThickness;
-                m_shapes.push_back(shape);
+                AddShape(shape);
 
                 // Draw directly to offscreen buffer for performance
                 DrawShapeToBuffer(shape);
 
                 m_isDrawing = false;
                 m_currentPoints.clear();
-                InvalidateRect(m_hwnd, NULL, TRUE);
+                PresentDirtyTiles();
             }
         }
             break;
@@ -532,7 +537,7 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 m_isDrawing = true;
             }
             m_currentPoints.push_back(newPoint);
-            InvalidateRect(m_hwnd, NULL, TRUE);
+            PresentDirtyTiles();
         }
             break;
 
@@ -543,7 +548,7 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 m_isDrawing = true;
             }
             m_currentPoints.push_back(newPoint);
-            InvalidateRect(m_hwnd, NULL, TRUE);
+            PresentDirtyTiles();
         }
             break;
 
@@ -554,7 +559,7 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 m_isDrawing = true;
             }
             m_currentPoints.push_back(newPoint);
-            InvalidateRect(m_hwnd, NULL, TRUE);
+            PresentDirtyTiles();
         }
             break;
 
@@ -565,7 +570,7 @@ void GraphicsWindow::HandleMouseClick(int x, int y, bool isLeftButton) {
                 m_isDrawing = true;
             }
             m_currentPoints.push_back(newPoint);
-            InvalidateRect(m_hwnd, NULL, TRUE);
+            PresentDirtyTiles();
         }
             break;
     }
@@ -590,7 +595,7 @@ void GraphicsWindow::HandleMouseMove(int x, int y) {
                 int maxY = std::max(m_currentPoints[0].y, m_lastMousePos.y) + 5;
                 
                 SetRect(&invalidRect, minX, minY, maxX, maxY);
-                InvalidateRect(m_hwnd, &invalidRect, TRUE);
+                InvalidateRect(m_hwnd, &invalidRect, FALSE);
             }
         }
     }
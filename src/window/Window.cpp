@@ -9,16 +9,21 @@ GraphicsWindow::GraphicsWindow()
         , m_hInstance(nullptr)
         , m_hdc(nullptr)
         , m_offscreenDC(nullptr)
-        , m_offscreenBitmap(nullptr)
         , m_oldBitmap(nullptr)
         , m_canvasWidth(0)
         , m_canvasHeight(0)
+        , m_lastPaintRects(0)
+        , m_lastPaintBytes(0)
         , m_currentDrawingMode(DrawingMode::LINE_DDA)
         , m_currentFillMode(FillMode::NONE)
         , m_currentColor(RGB(0, 0, 0))  // Black
         , m_backgroundColor(RGB(255, 255, 255))  // White
         , m_lineThickness(1)
         , m_isDrawing(false)
+        , m_loadPosted(false)
+        , m_loading(false)
+        , m_loadDrawn(0)
+        , m_loadFirstPixelMs(-1)
         , m_currentPen(nullptr)
         , m_currentBrush(nullptr)
         , m_backgroundBrush(nullptr)
@@ -127,14 +132,14 @@ void GraphicsWindow::SetDrawingMode(DrawingMode mode) {
     // Reset fill mode when switching to drawing mode
     m_fillMode = false;
     
-    InvalidateRect(m_hwnd, NULL, TRUE);
+    InvalidateStatusText();
 }
 
 // Set drawing color
 void GraphicsWindow::SetDrawingColor(COLORREF color) {
     m_currentColor = color;
     UpdateCurrentPen();
-    InvalidateRect(m_hwnd, NULL, TRUE);
+    InvalidateStatusText();
 }
 
 // Set background color
@@ -142,7 +147,7 @@ void GraphicsWindow::SetBackgroundColor(COLORREF color) {
     m_backgroundColor = color;
     if (m_backgroundBrush) DeleteObject(m_backgroundBrush);
     m_backgroundBrush = CreateSolidBrush(m_backgroundColor);
-    InvalidateRect(m_hwnd, NULL, TRUE);
+    InvalidateRect(m_hwnd, NULL, FALSE);
 }
 
 // Set title
@@ -172,6 +177,9 @@ void GraphicsWindow::SetFillMode(FillMode mode) {
                   mode == FillMode::POLYGON_NONCONVEX_FILL ||
                   mode == FillMode::FLOOD_FILL_RECURSIVE_POLYGON ||
                   mode == FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON ||
+                  mode == FillMode::FLOOD_FILL_PARALLEL_POLYGON ||
+                  mode == FillMode::ANTIALIASED_EVEN_ODD ||
+                  mode == FillMode::ANTIALIASED_NON_ZERO ||
                   mode == FillMode::SQUARE_FILL_HERMITE_VERTICAL ||
                   mode == FillMode::RECTANGLE_FILL_BEZIER_HORIZONTAL);
     
@@ -183,7 +191,7 @@ void GraphicsWindow::SetFillMode(FillMode mode) {
         m_polygonPoints.clear();
     }
     
-    InvalidateRect(m_hwnd, NULL, TRUE);
+    InvalidateStatusText();
 }
 
 // Set line thickness
@@ -194,14 +202,22 @@ void GraphicsWindow::SetLineThickness(int thickness) {
 
 // Clear canvas
 void GraphicsWindow::ClearCanvas() {
-    m_shapes.clear();
+    // Abandons a load in progress along with the drawing it replaced
+    if (m_loading) {
+        m_loader.Cancel();
+        m_loading = false;
+        m_loadPrevious.Clear();
+    }
+    m_scene.Clear();
+    m_shapeIndex.Clear();
+    m_displayLists.Clear();
     m_isDrawing = false;
     m_currentPoints.clear();
     
     // Clear offscreen buffer
     ClearOffscreenBuffer();
     
-    InvalidateRect(m_hwnd, NULL, TRUE);
+    PresentDirtyTiles();
 }
 
 // ========================================
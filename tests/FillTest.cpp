@@ -0,0 +1,226 @@
+// Fill equivalences.
+// Fills that are meant to be interchangeable must write the same pixels:
+//   - FillPolygon (any path it picks) and ConvexFill on convex polygons
+//     against NonConvexFill, on convex, star-shaped and self-intersecting
+//     polygons
+//   - a filled polygon shape drawn by RenderShape against its outline and
+//     FillPolygon
+//   - the scanline, pixel-stack and parallel labeling flood fills against
+//     each other, on an open canvas, a maze of walls with gaps and a
+//     closed box, including the pixels each reports filled, and clipped
+//     to rectangles
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../include/FloodFill.h"
+#include "../include/Framebuffer.h"
+#include "../include/ParallelFloodFill.h"
+#include "../include/PolygonAlgorithms.h"
+#include "../include/PolygonFillAlgorithms.h"
+#include "../include/ShapeRenderer.h"
+#include "TestCheck.h"
+
+static const int WIDTH = 400;
+static const int HEIGHT = 300;
+static const COLORREF BACKGROUND = RGB(255, 255, 255);
+static const COLORREF WALL = RGB(0, 0, 0);
+static const COLORREF FILL = RGB(200, 30, 30);
+
+using Pixels = std::vector<std::uint32_t>;
+
+static Pixels Snapshot(const Framebuffer& framebuffer) {
+    return Pixels(framebuffer.Pixels(), framebuffer.Pixels() + (std::size_t)framebuffer.Width() * framebuffer.Height());
+}
+
+// ========================================
+// POLYGON FILLS
+// ========================================
+
+static std::vector<PolygonPoint> RegularPolygon(int vertices, double cx, double cy, double radius) {
+    const double pi = 3.14159265358979323846;
+    std::vector<PolygonPoint> points;
+    for (int i = 0; i < vertices; i++) {
+        double angle = 2 * pi * i / vertices;
+        points.push_back(PolygonPoint(std::round(cx + radius * std::cos(angle)), std::round(cy + radius * std::sin(angle))));
+    }
+    return points;
+}
+
+// Star-shaped: random radius per vertex, so concave but simple
+static std::vector<PolygonPoint> Star(int vertices, std::mt19937& rng) {
+    std::uniform_real_distribution<double> jitter(0.3, 1.0);
+    std::vector<PolygonPoint> points = RegularPolygon(vertices, WIDTH / 2.0, HEIGHT / 2.0, HEIGHT / 2.0 - 5);
+    for (PolygonPoint& p : points) {
+        double r = jitter(rng);
+        p.x = std::round(WIDTH / 2.0 + (p.x - WIDTH / 2.0) * r);
+        p.y = std::round(HEIGHT / 2.0 + (p.y - HEIGHT / 2.0) * r);
+    }
+    return points;
+}
+
+// Random vertices anywhere, mostly self-intersecting, partly off the canvas
+static std::vector<PolygonPoint> Scribble(int vertices, std::mt19937& rng) {
+    std::uniform_int_distribution<int> px(-40, WIDTH + 40);
+    std::uniform_int_distribution<int> py(-40, HEIGHT + 40);
+    std::vector<PolygonPoint> points;
+    for (int i = 0; i < vertices; i++) points.push_back(PolygonPoint(px(rng), py(rng)));
+    return points;
+}
+
+template <typename Fill>
+static Pixels FillWith(Framebuffer& framebuffer, std::vector<PolygonPoint> points, Fill fill) {
+    framebuffer.Clear(BACKGROUND);
+    BgraSink sink(framebuffer, DirtyTracking::OFF);
+    fill(sink, points.data(), (int)points.size());
+    return Snapshot(framebuffer);
+}
+
+static void CheckPolygonFills() {
+    Framebuffer framebuffer;
+    framebuffer.Create(WIDTH, HEIGHT);
+    std::mt19937 rng(777);
+
+    auto nonConvex = [](BgraSink& sink, PolygonPoint* p, int n) { NonConvexFill(sink, p, n, FILL); };
+    auto convex = [](BgraSink& sink, PolygonPoint* p, int n) { ConvexFill(sink, p, n, FILL); };
+    auto automatic = [](BgraSink& sink, PolygonPoint* p, int n) { FillPolygon(sink, p, n, FILL); };
+
+    for (int vertices : { 3, 4, 5, 8, 33, 200 }) {
+        std::vector<PolygonPoint> regular = RegularPolygon(vertices, WIDTH / 2.0, HEIGHT / 2.0, HEIGHT / 3.0);
+        Pixels expected = FillWith(framebuffer, regular, nonConvex);
+        CHECK(FillWith(framebuffer, regular, convex) == expected);
+        CHECK(FillWith(framebuffer, regular, automatic) == expected);
+    }
+    for (int round = 0; round < 50; round++) {
+        std::vector<PolygonPoint> star = Star(5 + round * 3, rng);
+        CHECK(FillWith(framebuffer, star, automatic) == FillWith(framebuffer, star, nonConvex));
+
+        std::vector<PolygonPoint> scribble = Scribble(3 + round % 12, rng);
+        CHECK(FillWith(framebuffer, scribble, automatic) == FillWith(framebuffer, scribble, nonConvex));
+    }
+}
+
+static void CheckPolygonShapes() {
+    Framebuffer framebuffer;
+    framebuffer.Create(WIDTH, HEIGHT);
+    std::mt19937 rng(31);
+
+    for (int round = 0; round < 20; round++) {
+        std::vector<PolygonPoint> star = Star(5 + round * 7, rng);
+        Shape shape;
+        shape.mode = DrawingMode::POLYGON;
+        shape.fillMode = (round % 2) ? FillMode::POLYGON_CONVEX_FILL : FillMode::POLYGON_NONCONVEX_FILL;
+        shape.color = FILL;
+        shape.thickness = 1;
+        for (const PolygonPoint& p : star) shape.points.push_back(Point((int)p.x, (int)p.y));
+
+        const Pixels expected = FillWith(framebuffer, star, [&](BgraSink& sink, PolygonPoint* p, int n) {
+            DrawPolygon(sink, shape.points.data(), n, FILL);
+            FillPolygon(sink, p, n, FILL);
+        });
+        auto render = [&](BgraSink& sink, PolygonPoint*, int) { RenderShape(sink, ShapeView(shape)); };
+        CHECK(FillWith(framebuffer, star, render) == expected);
+    }
+}
+
+// ========================================
+// FLOOD FILLS
+// ========================================
+
+static void DrawWall(Framebuffer& framebuffer, int x1, int y1, int x2, int y2) {
+    const std::uint32_t wall = Framebuffer::ToPixel(WALL);
+    for (int y = y1; y <= y2; y++) {
+        for (int x = x1; x <= x2; x++) framebuffer.Row(y)[x] = wall;
+    }
+}
+
+// Vertical walls with random gaps, and a closed box around (60, 60)
+static void DrawMaze(Framebuffer& framebuffer) {
+    framebuffer.Clear(BACKGROUND);
+    std::mt19937 rng(4242);
+    std::uniform_int_distribution<int> gap(0, HEIGHT - 12);
+    for (int x = 150; x < WIDTH; x += 12) {
+        int y = gap(rng);
+        DrawWall(framebuffer, x, 0, x, y - 1);
+        DrawWall(framebuffer, x, y + 3, x, HEIGHT - 1);
+    }
+    DrawWall(framebuffer, 20, 20, 100, 20);
+    DrawWall(framebuffer, 20, 100, 100, 100);
+    DrawWall(framebuffer, 20, 20, 20, 100);
+    DrawWall(framebuffer, 100, 20, 100, 100);
+    framebuffer.MarkModified();
+}
+
+static void CheckFloodFills() {
+    Framebuffer framebuffer;
+    framebuffer.Create(WIDTH, HEIGHT);
+    FloodFillLabels labels(4);
+
+    struct Seed {
+        int x, y;
+    } seeds[] = { { 300, 10 }, { 60, 60 }, { 5, 290 }, { 150, 5 } };
+    for (const Seed& seed : seeds) {
+        DrawMaze(framebuffer);
+        const COLORREF original = Framebuffer::FromPixel(framebuffer.Row(seed.y)[seed.x]);
+        {
+            BgraSink sink(framebuffer, DirtyTracking::OFF);
+            FloodFillNonRecursive(sink, seed.x, seed.y, FILL, original);
+        }
+        const Pixels expected = Snapshot(framebuffer);
+        std::size_t expectedFilled = 0;
+        for (std::size_t i = 0; i < expected.size(); i++) {
+            expectedFilled += expected[i] == Framebuffer::ToPixel(FILL);
+        }
+
+        DrawMaze(framebuffer);
+        std::vector<FillSpan> spans;
+        std::size_t filled = FloodFillScanline(framebuffer, seed.x, seed.y, FILL, original, &spans);
+        CHECK(Snapshot(framebuffer) == expected);
+        CHECK(filled == expectedFilled);
+
+        // The recorded spans redraw the same region
+        std::size_t spanPixels = 0;
+        for (const FillSpan& span : spans) spanPixels += span.x2 - span.x1 + 1;
+        CHECK(spanPixels == filled);
+
+        DrawMaze(framebuffer);
+        CHECK(labels.Fill(framebuffer, seed.x, seed.y, FILL) == expectedFilled);
+        CHECK(Snapshot(framebuffer) == expected);
+    }
+
+    // Fills clipped to a rectangle, small and large in turn so each starts
+    // from what the last one left in the visited bits
+    const PixelRect clips[] = {
+        { 0, 0, WIDTH - 1, HEIGHT - 1 }, { 40, 30, 90, 70 }, { 140, 0, WIDTH - 1, 150 },
+        { 30, 30, 31, 31 }, { 0, 0, WIDTH - 1, HEIGHT - 1 }, { 155, 100, 250, 299 },
+    };
+    for (const PixelRect& clip : clips) {
+        const int x = (clip.left + clip.right) / 2, y = (clip.top + clip.bottom) / 2;
+        DrawMaze(framebuffer);
+        const COLORREF original = Framebuffer::FromPixel(framebuffer.Row(y)[x]);
+        {
+            BgraSink sink(framebuffer, clip, DirtyTracking::OFF);
+            FloodFillNonRecursive(sink, x, y, FILL, original);
+        }
+        const Pixels expected = Snapshot(framebuffer);
+
+        DrawMaze(framebuffer);
+        BgraSink sink(framebuffer, clip, DirtyTracking::OFF);
+        FloodFillScanline(sink, x, y, FILL, original);
+        CHECK(Snapshot(framebuffer) == expected);
+    }
+
+    // A fill with the color already there changes nothing
+    DrawMaze(framebuffer);
+    const Pixels before = Snapshot(framebuffer);
+    FloodFillScanline(framebuffer, 60, 60, BACKGROUND, BACKGROUND);
+    CHECK(Snapshot(framebuffer) == before);
+}
+
+int main() {
+    CheckPolygonFills();
+    CheckPolygonShapes();
+    CheckFloodFills();
+    return TestResult("fill_test");
+}
@@ -0,0 +1,224 @@
+// Scene file round trips.
+// Saves a scene of every kind of shape (with a recorded flood fill) as a
+// version 1 file and as version 2 files in each encoding, and checks that:
+//   - every version 2 encoding loads back to the same scene, byte for byte
+//     when written out again, from a stream, a mapped file and in batches
+//   - the version 1 file loads back to the same scene, bounds and geometry
+//     recomputed, and draws the same pixels
+//   - cut files of either version are rejected and leave the scene alone,
+//     as are version 2 files whose stored bounds don't match their shapes
+//     and version 1 files with modes out of range or start tables that
+//     run past their arrays partway through
+//   - an empty scene round-trips
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/Scene.h"
+#include "../include/SceneFile.h"
+#include "../include/ShapeRenderer.h"
+#include "../bench/BenchScene.h"
+#include "TestCheck.h"
+
+static const int WIDTH = 320;
+static const int HEIGHT = 240;
+
+static Scene MakeTestScene() {
+    Scene scene = MakeScene(2000, WIDTH, HEIGHT, 40);
+
+    Shape fill;
+    fill.mode = DrawingMode::FLOOD_FILL;
+    fill.fillMode = FillMode::FLOOD_FILL_NONRECURSIVE_POLYGON;
+    fill.color = RGB(10, 200, 30);
+    fill.thickness = 1;
+    fill.points.push_back(Point(50, 50));
+    for (int y = 40; y < 60; y++) fill.spans.push_back(FillSpan{ y, 40 + y % 7, 70 - y % 5 });
+    scene.Add(fill);
+
+    Shape triangle;
+    triangle.mode = DrawingMode::POLYGON;
+    triangle.fillMode = FillMode::POLYGON_CONVEX_FILL;
+    triangle.color = RGB(200, 0, 200);
+    triangle.thickness = 2;
+    triangle.points = { Point(100, 20), Point(180, 60), Point(120, 110) };
+    scene.Add(triangle);
+    return scene;
+}
+
+static std::string Bytes(const Scene& scene, const SceneFileOptions& options = SceneFileOptions()) {
+    std::ostringstream out;
+    WriteScene(out, scene, options);
+    return out.str();
+}
+
+static std::string LegacyBytes(const Scene& scene) {
+    std::ostringstream out;
+    WriteLegacyScene(out, scene);
+    return out.str();
+}
+
+static std::vector<std::uint32_t> Render(const Scene& scene) {
+    Framebuffer framebuffer;
+    framebuffer.Create(WIDTH, HEIGHT);
+    framebuffer.Clear(RGB(255, 255, 255));
+    BgraSink sink(framebuffer, DirtyTracking::OFF);
+    for (std::size_t i = 0; i < scene.Size(); i++) RenderShape(sink, scene.View(i));
+    return std::vector<std::uint32_t>(framebuffer.Pixels(), framebuffer.Pixels() + WIDTH * HEIGHT);
+}
+
+static bool Read(const std::string& bytes, Scene& scene) {
+    std::istringstream in(bytes);
+    return ReadScene(in, scene);
+}
+
+static void WriteFile(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(bytes.data(), (std::streamsize)bytes.size());
+}
+
+// Cuts at the ends and in the middle of the file must all be rejected,
+// without touching the scene they were read into
+static void CheckCutsRejected(const std::string& bytes) {
+    for (std::size_t cut : { (std::size_t)0, (std::size_t)7, bytes.size() / 3, bytes.size() / 2, bytes.size() - 1 }) {
+        Scene scene = MakeScene(3, WIDTH, HEIGHT);
+        const std::string before = Bytes(scene);
+        CHECK(!Read(bytes.substr(0, cut), scene));
+        CHECK(Bytes(scene) == before);
+    }
+}
+
+// Offset of a chunk's data in a version 2 file, from its directory
+static std::size_t ChunkOffset(const std::string& bytes, const char* id) {
+    std::uint32_t chunkCount;
+    std::memcpy(&chunkCount, bytes.data() + 16, 4);
+    for (std::uint32_t c = 0; c < chunkCount; c++) {
+        const char* entry = bytes.data() + 64 + c * 24;
+        if (std::memcmp(entry, id, 4) == 0) {
+            std::uint64_t offset;
+            std::memcpy(&offset, entry + 8, 8);
+            return (std::size_t)offset;
+        }
+    }
+    return 0;
+}
+
+static void CheckRejected(const std::string& bytes) {
+    Scene scene = MakeScene(3, WIDTH, HEIGHT);
+    const std::string before = Bytes(scene);
+    CHECK(!Read(bytes, scene));
+    CHECK(Bytes(scene) == before);
+}
+
+// Bounds a redraw trusts: one a pixel short, and a flag claiming a shape
+// that may draw outside them is bounded
+static void CheckBadBoundsRejected(const std::string& bytes, std::size_t shape) {
+    std::string copy = bytes;
+    std::int32_t right;
+    const std::size_t at = ChunkOffset(bytes, "BNDS") + shape * sizeof(PixelRect) + offsetof(PixelRect, right);
+    std::memcpy(&right, &copy[at], 4);
+    right--;
+    std::memcpy(&copy[at], &right, 4);
+    CheckRejected(copy);
+
+    copy = bytes;
+    copy[ChunkOffset(bytes, "BNDF") + shape] ^= 1;
+    CheckRejected(copy);
+}
+
+// A start table entry past the end of its array, with the last entry
+// still equal to the total
+static void CheckBadStartRejected(const std::string& bytes, const char* id) {
+    std::string copy = bytes;
+    const std::uint32_t past = 0x40000000;
+    std::memcpy(&copy[ChunkOffset(bytes, id) + 4], &past, 4);
+    CheckRejected(copy);
+}
+
+// Deliver a file in batches and join them back into one scene
+static bool LoadInBatches(const std::string& path, Scene& scene) {
+    std::size_t delivered = 0;
+    bool ordered = true;
+    bool ok = LoadSceneInBatches(path, 100, [&](const Scene& batch, const SceneLoadProgress& progress) {
+        scene.Append(batch, 0, batch.Size());
+        delivered += batch.Size();
+        ordered = ordered && progress.shapes == delivered && progress.shapes <= progress.totalShapes;
+        return true;
+    });
+    return ok && ordered;
+}
+
+int main() {
+    const Scene scene = MakeTestScene();
+    const std::string plain = Bytes(scene);
+    const std::vector<std::uint32_t> pixels = Render(scene);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "scene_file_test.bin";
+
+    // Version 2, every encoding
+    const SceneFileOptions encodings[] = { { false, false }, { true, false }, { false, true }, { true, true } };
+    for (const SceneFileOptions& options : encodings) {
+        const std::string bytes = Bytes(scene, options);
+
+        Scene streamed;
+        CHECK(Read(bytes, streamed));
+        CHECK(Bytes(streamed) == plain);
+        CHECK(Render(streamed) == pixels);
+
+        WriteFile(path.string(), bytes);
+        Scene mapped;
+        CHECK(LoadSceneFromFile(path.string(), mapped));
+        CHECK(Bytes(mapped) == plain);
+
+        Scene batched;
+        CHECK(LoadInBatches(path.string(), batched));
+        CHECK(Bytes(batched) == plain);
+
+        CheckCutsRejected(bytes);
+        if (!options.deltaPoints && !options.compressTable) {
+            // Only plain files store bounds; compact ones have them recomputed
+            CheckBadBoundsRejected(bytes, 0);
+            CheckBadBoundsRejected(bytes, scene.Size() - 1);
+            for (const char* id : { "PSTR", "SSTR" }) CheckBadStartRejected(bytes, id);
+        }
+    }
+
+    // Version 1 stores no bounds or geometry; loading works them out again
+    const std::string legacy = LegacyBytes(scene);
+    Scene legacyLoaded;
+    CHECK(Read(legacy, legacyLoaded));
+    CHECK(legacyLoaded.Size() == scene.Size());
+    CHECK(LegacyBytes(legacyLoaded) == legacy);
+    CHECK(Bytes(legacyLoaded) == Bytes(scene));
+    CHECK(Render(legacyLoaded) == pixels);
+    WriteFile(path.string(), legacy);
+    Scene legacyBatched;
+    CHECK(LoadInBatches(path.string(), legacyBatched));
+    CHECK(LegacyBytes(legacyBatched) == legacy);
+    CheckCutsRejected(legacy);
+
+    // The first shape's mode (offset 4) and fill mode (offset 12)
+    for (std::size_t at : { (std::size_t)4, (std::size_t)12 }) {
+        for (std::int32_t value : { -1, 200 }) {
+            std::string copy = legacy;
+            std::memcpy(&copy[at], &value, 4);
+            CheckRejected(copy);
+            WriteFile(path.string(), copy);
+            Scene batched;
+            CHECK(!LoadInBatches(path.string(), batched) && batched.Empty());
+        }
+    }
+
+    // Empty scenes
+    Scene empty, emptyLoaded;
+    CHECK(Read(Bytes(empty), emptyLoaded) && emptyLoaded.Empty());
+    CHECK(Read(LegacyBytes(empty), emptyLoaded) && emptyLoaded.Empty());
+
+    std::filesystem::remove(path);
+    return TestResult("scene_file_test");
+}
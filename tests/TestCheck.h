@@ -0,0 +1,31 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+// Minimal checks shared by the test executables. A failed CHECK prints
+// where it was and the test carries on; main returns TestResult().
+
+#include <cstdio>
+
+inline int& TestFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                      \
+    do {                                                                                      \
+        if (!(condition)) {                                                                   \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            TestFailures()++;                                                                 \
+        }                                                                                     \
+    } while (0)
+
+inline int TestResult(const char* name) {
+    if (TestFailures() == 0) {
+        std::printf("%s: all checks passed\n", name);
+        return 0;
+    }
+    std::fprintf(stderr, "%s: %d checks failed\n", name, TestFailures());
+    return 1;
+}
+
+#endif // TEST_CHECK_H
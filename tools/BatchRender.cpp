@@ -0,0 +1,200 @@
+// Headless batch renderer.
+// Loads .bin drawings saved by the GUI, replays every shape through the same
+// RenderShape() path the window uses for its offscreen buffer, and writes
+// each result as PNG or PPM. Files are rendered concurrently, one per worker
+// thread, and per-file plus aggregate timings are reported so the tool can
+// double as a throughput benchmark.
+//
+// Usage: batch_render [options] file.bin...
+//   -o DIR        output directory (default: next to each input)
+//   -f png|ppm    output format (default: png)
+//   -j N          worker threads (default: hardware concurrency)
+//   -w W, -h H    canvas size (default: 1024x768, the window's default)
+//   -n            render only, don't write images
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/Framebuffer.h"
+#include "../include/GraphicsTypes.h"
+#include "../include/ImageWriter.h"
+#include "../include/PixelSink.h"
+#include "../include/SceneFile.h"
+#include "../include/ShapeRenderer.h"
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string outputDir;
+    bool png = true;
+    bool writeImages = true;
+    int threads = 0;
+    int width = DEFAULT_WINDOW_WIDTH;
+    int height = DEFAULT_WINDOW_HEIGHT;
+    std::vector<std::string> inputs;
+};
+
+struct FileResult {
+    bool ok = false;
+    const char* error = "";
+    std::string output;
+    std::size_t shapes = 0;
+    double loadMs = 0;
+    double renderMs = 0;
+    double writeMs = 0;
+};
+
+static double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: batch_render [-o DIR] [-f png|ppm] [-j N] [-w W] [-h H] [-n] file.bin...\n");
+}
+
+static bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "-o") == 0 && hasValue) {
+            options.outputDir = argv[++i];
+        } else if (std::strcmp(arg, "-f") == 0 && hasValue) {
+            std::string format = argv[++i];
+            if (format != "png" && format != "ppm") return false;
+            options.png = format == "png";
+        } else if (std::strcmp(arg, "-j") == 0 && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "-w") == 0 && hasValue) {
+            options.width = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "-h") == 0 && hasValue) {
+            options.height = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "-n") == 0) {
+            options.writeImages = false;
+        } else if (arg[0] == '-') {
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    return !options.inputs.empty() && options.width > 0 && options.height > 0;
+}
+
+static std::string OutputPath(const Options& options, const std::string& input) {
+    fs::path path(input);
+    path.replace_extension(options.png ? ".png" : ".ppm");
+    if (!options.outputDir.empty()) {
+        path = fs::path(options.outputDir) / path.filename();
+    }
+    return path.string();
+}
+
+// Same steps as GraphicsWindow::RebuildOffscreenBuffer()
+static void RenderFile(const Options& options, const std::string& input,
+                       Framebuffer& framebuffer, FileResult& result) {
+    Clock::time_point start = Clock::now();
+    Scene scene;
+    if (!LoadSceneFromFile(input, scene)) {
+        result.error = "cannot read scene";
+        return;
+    }
+    result.shapes = scene.Size();
+    result.loadMs = MsSince(start);
+
+    start = Clock::now();
+    framebuffer.Clear(RGB(255, 255, 255));
+    BgraSink sink(framebuffer);
+    for (std::size_t i = 0; i < scene.Size(); i++) {
+        RenderShape(sink, scene.View(i));
+    }
+    result.renderMs = MsSince(start);
+
+    if (options.writeImages) {
+        start = Clock::now();
+        result.output = OutputPath(options, input);
+        bool written = options.png ? WritePNG(result.output, framebuffer)
+                                   : WritePPM(result.output, framebuffer);
+        result.writeMs = MsSince(start);
+        if (!written) {
+            result.error = "cannot write image";
+            return;
+        }
+    }
+    result.ok = true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    if (!options.outputDir.empty()) {
+        std::error_code ec;
+        fs::create_directories(options.outputDir, ec);
+    }
+
+    int threadCount = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+    threadCount = std::max(1, std::min(threadCount, (int)options.inputs.size()));
+
+    std::vector<FileResult> results(options.inputs.size());
+    std::atomic<std::size_t> nextFile(0);
+
+    // Each worker owns one framebuffer and pulls files until none are left
+    auto worker = [&]() {
+        Framebuffer framebuffer;
+        if (!framebuffer.Create(options.width, options.height)) return;
+        for (std::size_t i = nextFile++; i < options.inputs.size(); i = nextFile++) {
+            RenderFile(options, options.inputs[i], framebuffer, results[i]);
+        }
+    };
+
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    double wallMs = MsSince(start);
+
+    // Per-file report, in input order
+    std::printf("%-40s %8s %10s %10s %10s\n", "file", "shapes", "load ms", "render ms", "write ms");
+    std::size_t failed = 0, totalShapes = 0;
+    double totalLoad = 0, totalRender = 0, totalWrite = 0;
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const FileResult& r = results[i];
+        if (!r.ok) {
+            std::printf("%-40s error: %s\n", options.inputs[i].c_str(), r.error[0] ? r.error : "not rendered");
+            failed++;
+            continue;
+        }
+        std::printf("%-40s %8zu %10.3f %10.3f %10.3f\n",
+                    options.inputs[i].c_str(), r.shapes, r.loadMs, r.renderMs, r.writeMs);
+        totalShapes += r.shapes;
+        totalLoad += r.loadMs;
+        totalRender += r.renderMs;
+        totalWrite += r.writeMs;
+    }
+
+    std::size_t rendered = results.size() - failed;
+    double seconds = wallMs / 1000.0;
+    std::printf("\n%zu files (%zu failed), %zu shapes, %d threads, %dx%d\n",
+                rendered, failed, totalShapes, threadCount, options.width, options.height);
+    std::printf("cpu time:  load %.1f ms, render %.1f ms, write %.1f ms\n", totalLoad, totalRender, totalWrite);
+    std::printf("wall time: %.1f ms, %.1f files/s, %.0f shapes/s\n",
+                wallMs, seconds > 0 ? rendered / seconds : 0.0, seconds > 0 ? totalShapes / seconds : 0.0);
+
+    return failed == 0 ? 0 : 1;
+}